@@ -0,0 +1,79 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_AssignPool.c
+ *
+ * Description:
+ *  Assign a file or an index to a buffer pool.
+ *
+ * Exports:
+ *  Four EduBfM_AssignPool(PageID *, Four)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_AssignPool()
+ *================================*/
+/*
+ * Function: Four EduBfM_AssignPool(PageID *, Four)
+ *
+ * Description:
+ *  Assign the file or index identified by 'physicalId', its
+ *  PhysicalFileID or PhysicalIndexID, to the buffer pool 'pool', or drop
+ *  its assignment if 'pool' is NIL. The object manager and the B+ tree
+ *  manager look the buffer pool up by EduBfM_PoolOf() and pass it as the
+ *  buffer type. A train of the file or index still in the buffer pool it
+ *  was fixed in before is written if dirty and moved out of it when it is
+ *  missed in the assigned buffer pool (see edubfm_EvictFromOtherPools()).
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_EDUBFM - NULL physicalId
+ *    eBADBUFFERTYPE_BFM - bad buffer type
+ *    some errors caused by function calls
+ */
+Four EduBfM_AssignPool(
+    PageID		*physicalId,		/* IN PhysicalFileID or PhysicalIndexID */
+    Four		pool)			/* IN buffer type, or NIL */
+{
+    Four		e;			/* error code */
+
+
+    /*@ Is the paramter valid? */
+    if (physicalId == NULL) ERR(eBADPARAMETER_EDUBFM);
+
+    if (pool != NIL && IS_BAD_BUFFERTYPE(pool)) ERR(eBADBUFFERTYPE_BFM);
+
+    e = edubfm_PoolMapSet(physicalId, pool);
+    if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* EduBfM_AssignPool() */
@@ -0,0 +1,132 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_CreatePool.c
+ *
+ * Description:
+ *  Create a named buffer pool.
+ *
+ * Exports:
+ *  Four EduBfM_CreatePool(char *, Four, Four, Four)
+ */
+
+
+#include <string.h>
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_CreatePool()
+ *================================*/
+/*
+ * Function: Four EduBfM_CreatePool(char *, Four, Four, Four)
+ *
+ * Description:
+ *  Create a buffer pool named 'name' of 'nBufs' buffers of 'bufSize' pages,
+ *  replaced by the policy 'policy' (BFM_POLICY_XXX), and return its buffer
+ *  type, which is passed to the other EduBfM functions like PAGE_BUF.
+ *  Trains are read in the sizes of the buffers of PAGE_BUF and
+ *  LOT_LEAF_BUF, so 'bufSize' must be one of these. A file or an index
+ *  is kept in the new buffer pool once assigned to it by
+ *  EduBfM_AssignPool(). A buffer pool lives until the process ends.
+ *
+ * Returns:
+ *  buffer type of the new buffer pool, or error code
+ *    eBADPARAMETER_EDUBFM - bad name, bufSize or nBufs
+ *    eBADPOLICY_EDUBFM - bad replacement policy
+ *    eDUPLICATEPOOL_EDUBFM - a buffer pool of the name exists
+ *    eTOOMANYPOOLS_EDUBFM - BFM_MAXPOOLS buffer pools exist
+ *    some errors caused by function calls
+ */
+Four EduBfM_CreatePool(
+    char		*name,			/* IN name of the buffer pool */
+    Four		bufSize,		/* IN size of a buffer in pages */
+    Four		nBufs,			/* IN # of buffers */
+    Four		policy)			/* IN replacement policy (BFM_POLICY_XXX) */
+{
+    Four		e;			/* error code */
+    Four		type;			/* buffer type of the new buffer pool */
+
+
+    /*@ Is the paramter valid? */
+    if (name == NULL || name[0] == '\0' || strlen(name) >= BFM_MAXPOOLNAME) ERR(eBADPARAMETER_EDUBFM);
+
+    if (nBufs < 1 || nBufs > BFM_MAXNBUFS) ERR(eBADPARAMETER_EDUBFM);
+
+    if (policy < 0 || policy >= NUM_BFM_POLICIES) ERR(eBADPOLICY_EDUBFM);
+
+    e = edubfm_Init();
+    if (e < 0) ERR(e);
+
+    if (bufSize != BI_BUFSIZE(PAGE_BUF) && bufSize != BI_BUFSIZE(LOT_LEAF_BUF)) ERR(eBADPARAMETER_EDUBFM);
+
+    pthread_mutex_lock(&edubfm_poolLatch);
+
+    for (type = 0; type < edubfm_nPools; type++)
+    {
+        if (strcmp(bufPoolName[type], name) == 0)
+        {
+            pthread_mutex_unlock(&edubfm_poolLatch);
+            ERR(eDUPLICATEPOOL_EDUBFM);
+        }
+    }
+
+    if (edubfm_nPools == BFM_MAXPOOLS)
+    {
+        pthread_mutex_unlock(&edubfm_poolLatch);
+        ERR(eTOOMANYPOOLS_EDUBFM);
+    }
+
+    type = edubfm_nPools;
+
+    e = edubfm_AllocPool(type, bufSize, nBufs);
+    if (e < 0)
+    {
+        pthread_mutex_unlock(&edubfm_poolLatch);
+        ERR(e);
+    }
+
+    BI_POLICY(type) = edubfm_policies[policy];
+
+    e = edubfm_SetUpPool(type);
+    if (e < 0)
+    {
+        edubfm_FreePool(type);
+        pthread_mutex_unlock(&edubfm_poolLatch);
+        ERR(e);
+    }
+
+    strcpy(bufPoolName[type], name);
+
+    /* the buffer type becomes valid only once the buffer pool is set up */
+    __atomic_store_n(&edubfm_nPools, type + 1, __ATOMIC_RELEASE);
+
+    pthread_mutex_unlock(&edubfm_poolLatch);
+
+    return(type);
+
+} /* EduBfM_CreatePool() */
@@ -56,21 +56,54 @@
 Four EduBfM_DiscardAll(void)
 {
     Four 	e;			/* error */
-    Two 	i;			/* index */
+    Four 	i;			/* index */
     Four 	type;			/* buffer type */
+    Four	nPools;			/* # of buffer pools */
 
-    for (type = 0; type < 2; type++)
+    e = edubfm_Init();
+    if (e < 0) ERR(e);
+
+    /* no buffer pool is created meanwhile */
+    pthread_mutex_lock(&edubfm_poolLatch);
+    nPools = BFM_NPOOLS();
+
+    /* the trains being loaded would be read into discarded buffers */
+    for (type = 0; type < nPools; type++)
+        edubfm_StopWarmLoad(type, TRUE);
+
+    for (type = 0; type < nPools; type++)
+        edubfm_LatchAllStripes(type);
+
+    for (type = 0; type < nPools; type++)
     {
         for (i = 0; i < BI_NBUFS(type); i++)
         {
             BI_KEY(type, i).pageNo = NIL;
-            BI_BITS(type, i) = ALL_0;
+            __atomic_store_n(&BI_BITS(type, i), ALL_0, __ATOMIC_RELEASE);
         }
+
+        edubfm_DirtyClear(type);
     }
 
     e = edubfm_DeleteAll();
+
+    for (type = nPools - 1; type >= 0; type--)
+        edubfm_UnlatchAllStripes(type);
+
+    pthread_mutex_unlock(&edubfm_poolLatch);
+
     if (e < 0) ERR (e);
 
+    /* The replacement policies and the compressed tiers start over with
+     * empty buffer pools. */
+    for (type = 0; type < nPools; type++)
+    {
+        edubfm_TierClear(type);
+
+        e = edubfm_ResetPolicy(type);
+        if (e < 0) ERR(e);
+    }
+
     return(eNOERROR);
 
 }  /* EduBfM_DiscardAll() */
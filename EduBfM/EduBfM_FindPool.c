@@ -0,0 +1,74 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_FindPool.c
+ *
+ * Description:
+ *  Find a buffer pool by its name.
+ *
+ * Exports:
+ *  Four EduBfM_FindPool(char *)
+ */
+
+
+#include <string.h>
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_FindPool()
+ *================================*/
+/*
+ * Function: Four EduBfM_FindPool(char *)
+ *
+ * Description:
+ *  Return the buffer type of the buffer pool named 'name'. The built-in
+ *  buffer pools are named "PAGE_BUF" and "LOT_LEAF_BUF".
+ *
+ * Returns:
+ *  buffer type, or error code
+ *    eBADPARAMETER_EDUBFM - NULL name
+ *    eNOTFOUND_BFM - no buffer pool of the name
+ */
+Four EduBfM_FindPool(
+    char		*name)			/* IN name of the buffer pool */
+{
+    Four		type;			/* buffer type */
+    Four		nPools;			/* # of buffer pools */
+
+
+    /*@ Is the paramter valid? */
+    if (name == NULL) ERR(eBADPARAMETER_EDUBFM);
+
+    /* a name is set before its buffer type becomes valid */
+    nPools = BFM_NPOOLS();
+    for (type = 0; type < nPools; type++)
+        if (strcmp(bufPoolName[type], name) == 0) return(type);
+
+    ERR(eNOTFOUND_BFM);
+
+} /* EduBfM_FindPool() */
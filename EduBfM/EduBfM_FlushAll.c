@@ -50,6 +50,9 @@
  *
  *  Flush dirty buffers holding trains.
  *  A dirty buffer is one with the dirty bit set.
+ *  The dirty trains of each buffer pool are written in the order of their
+ *  disk addresses, and trains adjacent on the disk are written together
+ *  (see edubfm_FlushTrains()).
  *
  * Returns:
  *  error code
@@ -57,22 +60,21 @@
 Four EduBfM_FlushAll(void)
 {
     Four        e;                      /* error */
-    Two         i;                      /* index */
     Four        type;                   /* buffer type */
 
-    for (type = 0; type < 2; type++)
+
+    e = edubfm_Init();
+    if (e < 0) ERR(e);
+
+    for (type = 0; type < BFM_NPOOLS(); type++)
     {
-        for (i = 0; i < BI_NBUFS(type); i++)
-        {
-            if (BI_BITS(type, i) & DIRTY)
-            {
-                e = edubfm_FlushTrain((TrainID *)&BI_KEY(type, i), type);
-                if (e < 0) ERR (e);
-            }
-        }
+        /* nothing is read into the buffer pool after it is flushed for the last time */
+        edubfm_StopWarmLoad(type, FALSE);
+
+        e = edubfm_FlushTrains(type);
+        if (e < 0) ERR (e);
     }
 
     return( eNOERROR );
     
 }  /* EduBfM_FlushAll() */
-
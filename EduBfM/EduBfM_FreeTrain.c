@@ -66,23 +66,33 @@ Four EduBfM_FreeTrain(
     /*@ check if the parameter is valid. */
     if (IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);	
 
+    CHECKKEY((BfMHashKey *)trainId);
+
+    e = edubfm_Init();
+    if (e < 0) ERR(e);
+
+    edubfm_LatchKey((BfMHashKey *)trainId, type);
+
     index = edubfm_LookUp((BfMHashKey *)trainId, type);
     if (index != NOTFOUND_IN_HTABLE)
     {
-        BI_FIXED(type, index) -= 1; 
-        if (BI_FIXED(type, index) < 0) 
+        if (BI_FIXED_DEC(type, index) < 0) 
         {   
             printf("fixed counter is less than 0!!!\n");
             printf("trainId = {%d, %d}\n", trainId->volNo, trainId->pageNo);
-
-            BI_FIXED(type, index) = 0;
+            BI_FIXED_INC(type, index);
         }
     }
     else 
     {
+        edubfm_UnlatchKey((BfMHashKey *)trainId, type);
         ERR (eNOTFOUND_BFM);
     }
-    
+
+    edubfm_UnlatchKey((BfMHashKey *)trainId, type);
+
+    BFM_TRACE(BFM_TRACE_FREE, (BfMHashKey *)trainId, type);
+
     return( eNOERROR );
     
 } /* EduBfM_FreeTrain() */
@@ -0,0 +1,78 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_FreeTrainBySwip.c
+ *
+ * Description :
+ *  Free(or unfix) a buffer fixed through a swip.
+ *
+ * Exports:
+ *  Four EduBfM_FreeTrainBySwip(BfMSwip *, Four)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_FreeTrainBySwip()
+ *================================*/
+/*
+ * Function: Four EduBfM_FreeTrainBySwip(BfMSwip*, Four)
+ *
+ * Description :
+ *  Free(or unfix) the buffer fixed by EduBfM_GetTrainBySwip() with the
+ *  swip 'swip', without looking the train up in the hash table.
+ *
+ * Returns :
+ *  error code
+ *    eBADBUFFERTYPE_BFM - bad buffer type
+ *    eBADPARAMETER_EDUBFM - invalid swip
+ */
+Four EduBfM_FreeTrainBySwip(
+    BfMSwip             *swip,          /* IN reference to the buffer to be freed */
+    Four                type)           /* IN buffer type */
+{
+    Four                index;          /* index on buffer holding the train */
+
+
+    /*@ check if the parameter is valid. */
+    if (IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
+
+    if (swip == NULL || swip->index < 0 || swip->index >= BI_NBUFS_LOAD(type)) ERR(eBADPARAMETER_EDUBFM);
+
+    index = swip->index;
+    if (BI_FIXED_DEC(type, index) < 0)
+    {
+        printf("fixed counter is less than 0!!!\n");
+        printf("buffer = %ld\n", (long)index);
+        BI_FIXED_INC(type, index);
+    }
+
+    return(eNOERROR);
+
+} /* EduBfM_FreeTrainBySwip() */
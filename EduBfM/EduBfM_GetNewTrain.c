@@ -0,0 +1,173 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_GetNewTrain.c
+ *
+ * Description :
+ *  Return a zero-filled buffer for a train which has just been allocated
+ *  on the disk, without reading it.
+ *
+ * Exports:
+ *  Four EduBfM_GetNewTrain(TrainID *, char **, Four)
+ */
+
+
+#include <string.h> /* for memset */
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_GetNewTrain()
+ *================================*/
+/*
+ * Function: Four EduBfM_GetNewTrain(TrainID*, char**, Four)
+ *
+ * Description :
+ *  Fix the train `trainId' as EduBfM_GetTrain() does, but fill its buffer
+ *  with zeros instead of reading it, since the caller has just allocated
+ *  the page and is about to initialize it. A buffer still holding the
+ *  train from before is zero-filled in place. A stale copy in the
+ *  compressed tier is dropped. The caller sets the dirty bit after the
+ *  initialization, as after any modification.
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFER_BFM - Invalid Buffer
+ *    eBADBUFFERTYPE_BFM - Invalid Buffer type
+ *    eFIXEDBUFFER_EDUBFM - the train is fixed in another buffer pool
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) parameter retBuf
+ *     pointer to the zero-filled buffer of the train `trainId'
+ */
+Four EduBfM_GetNewTrain(
+    TrainID             *trainId,               /* IN train allocated */
+    char                **retBuf,               /* OUT pointer to the returned buffer */
+    Four                type)                   /* IN buffer type */
+{
+    Four                e;                      /* for error */
+    Four                index;                  /* index of the buffer pool */
+    Four                found;                  /* index of the buffer loaded by another thread */
+    Boolean             loaded;                 /* has this thread zero-filled a new buffer? */
+    BfMHashKey          *key = (BfMHashKey *)trainId;
+
+
+    /*@ Check the validity of given parameters */
+    if(retBuf == NULL) ERR(eBADBUFFER_BFM);
+
+    /* Is the buffer type valid? */
+    if(IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
+
+    CHECKKEY(key);
+
+    e = edubfm_Init();
+    if (e < 0) ERR(e);
+
+    while (1)
+    {
+        loaded = FALSE;
+
+        edubfm_LatchKey(key, type);
+        index = edubfm_LookUp(key, type);
+        if (index != NOTFOUND_IN_HTABLE)
+        {
+            BI_FIXED_INC(type, index);
+            edubfm_UnlatchKey(key, type);
+        }
+        else
+        {
+            edubfm_UnlatchKey(key, type);
+
+            /* no stale copy may be left in the buffer pool used before an assignment */
+            e = edubfm_EvictFromOtherPools(key, type, TRUE);
+            if (e < 0) ERR(e);
+
+            /* The victim is returned claimed (fixed count 1) and out of the hash table. */
+            index = edubfm_AllocTrain(key, type, BFM_INTENT_NORMAL);
+            if (index < 0) ERR(index);
+
+            edubfm_LatchKey(key, type);
+            found = edubfm_LookUp(key, type);
+            if (found != NOTFOUND_IN_HTABLE)
+            {
+                /* Another thread has fixed the train in the meantime. */
+                BI_FIXED_INC(type, found);
+                edubfm_UnlatchKey(key, type);
+                edubfm_ReleaseBuffer(type, index);
+                index = found;
+            }
+            else
+            {
+                BI_KEY(type, index) = *key;
+                e = edubfm_Insert(&BI_KEY(type, index), index, type);
+                if (e < 0)
+                {
+                    edubfm_UnlatchKey(key, type);
+                    edubfm_ReleaseBuffer(type, index);
+                    ERR(e);
+                }
+
+                /* Fixers of the train wait until the buffer is zero-filled. */
+                edubfm_BeginFrameIO(type, index);
+                edubfm_TierRemove(type, key);
+                edubfm_UnlatchKey(key, type);
+
+                memset(BI_BUFFER(type, index), 0, PAGESIZE * BI_BUFSIZE(type));
+
+                edubfm_PolicyLoad(type, index, key);
+                edubfm_EndFrameIO(type, index);
+                loaded = TRUE;
+            }
+        }
+
+        /* Wait for a read by another thread, and retry if it has failed. */
+        edubfm_WaitFrameIO(type, index);
+        if (EQUALKEY(key, &BI_KEY(type, index))) break;
+
+        BI_FIXED_DEC(type, index);
+    }
+
+    /* A buffer which held the train already is zero-filled in place; this
+     * is a modification for the optimistic readers. */
+    if (!loaded)
+    {
+        memset(BI_BUFFER(type, index), 0, PAGESIZE * BI_BUFSIZE(type));
+        BI_VERSION_ADD(type, index, 2);
+        edubfm_PolicyHit(type, index);
+    }
+
+    BFM_STAT_INC(type, newTrains);
+    BI_SET_BITS(type, index, REFER);
+
+    *retBuf = BI_BUFFER(type, index);
+
+    BFM_TRACE(BFM_TRACE_NEW, key, type);
+
+    return(eNOERROR);
+
+}  /* EduBfM_GetNewTrain() */
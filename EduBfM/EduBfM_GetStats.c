@@ -0,0 +1,92 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_GetStats.c
+ *
+ * Description:
+ *  Return the statistics of a buffer pool.
+ *
+ * Exports:
+ *  Four EduBfM_GetStats(Four, BfMStats *)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+/*@
+ * global variables
+ */
+/* statistics of the buffer pools */
+BfMStats bufStats[BFM_MAXPOOLS];
+
+
+
+/*@================================
+ * EduBfM_GetStats()
+ *================================*/
+/*
+ * Function: Four EduBfM_GetStats(Four, BfMStats *)
+ *
+ * Description:
+ *  Copy the statistics of a buffer pool, i.e. the number of hits, misses
+ *  by caller, clean and dirty evictions, writes of dirty victims and trains
+ *  read ahead, and the histograms of the clock sweep distance and of the
+ *  disk latencies, since the start or the last EduBfM_ResetStats().
+ *  The counters are read one by one while other threads may update them.
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFERTYPE_BFM - bad buffer type
+ *    eBADBUFFER_BFM - NULL stats
+ *
+ * Side effects:
+ *  1) parameter stats
+ *     statistics of the buffer pool
+ */
+Four EduBfM_GetStats(
+    Four		type,			/* IN buffer type */
+    BfMStats		*stats)			/* OUT statistics */
+{
+    UEight		*src;			/* counters of the buffer pool */
+    UEight		*dst;			/* counters copied */
+    Four		i;
+
+
+    /*@ Is the paramter valid? */
+    if (IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
+
+    if (stats == NULL) ERR(eBADBUFFER_BFM);
+
+    /* BfMStats consists of UEight counters only */
+    src = (UEight *)&bufStats[type];
+    dst = (UEight *)stats;
+    for (i = 0; i < sizeof(BfMStats) / sizeof(UEight); i++)
+        dst[i] = __atomic_load_n(&src[i], __ATOMIC_RELAXED);
+
+    return(eNOERROR);
+
+} /* EduBfM_GetStats() */
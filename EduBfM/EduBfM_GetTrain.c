@@ -56,6 +56,13 @@
  *  pool, allocate a buffer (a buffer selected as victim may be forced out
  *  by the buffer replacement algorithm), read a disk train into the 
  *  selected buffer train, and return it.
+ *  Several threads may call this function at the same time; the hash chain
+ *  is latched while it is searched or modified, and fixers of a train being
+ *  read in by another thread wait until the read completes.
+ *  If read-ahead is enabled by EduBfM_SetReadAhead(), a train read from
+ *  the disk may make the following trains read in advance.
+ *  The train is fixed with the normal access intent; see
+ *  EduBfM_GetTrainWithIntent() for scans and hot trains.
  *
  * Returns:
  *  error code
@@ -72,37 +79,6 @@ Four EduBfM_GetTrain(
     char                **retBuf,               /* OUT pointer to the returned buffer */
     Four                type )                  /* IN buffer type */
 {
-    Four                e;                      /* for error */
-    Four                index;                  /* index of the buffer pool */
-
-
-    /*@ Check the validity of given parameters */
-    /* Some restrictions may be added         */
-    if(retBuf == NULL) ERR(eBADBUFFER_BFM);
-
-    /* Is the buffer type valid? */
-    if(IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);	
-
-    // printf("Get Train: %d %d\n", trainId->volNo, trainId->pageNo);
-
-    index = edubfm_LookUp((BfMHashKey *)trainId, type);
-    if (index == NOTFOUND_IN_HTABLE)
-    {
-        index = edubfm_AllocTrain(type);
-        if (index < 0) ERR(index);
-
-        BI_KEY(type, index) = *((BfMHashKey*)trainId);
-        e = edubfm_Insert(&BI_KEY(type, index), index, type);
-        if (e < 0) ERR(e);
-
-        e = edubfm_ReadTrain(trainId, BI_BUFFER(type, index), type);
-        if (e < 0) ERR(e);
-    }
-
-    BI_FIXED(type, index) += 1;
-    BI_BITS(type, index) = (BI_BITS(type, index) | REFER);
-    *retBuf = BI_BUFFER(type, index);
-
-    return(eNOERROR);   /* No error */
+    return(EduBfM_GetTrainWithIntent(trainId, retBuf, type, BFM_INTENT_NORMAL));
 
 }  /* EduBfM_GetTrain() */
@@ -0,0 +1,124 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_GetTrainBySwip.c
+ *
+ * Description : 
+ *  Fix a train through a direct reference to its buffer.
+ *
+ * Exports:
+ *  Four EduBfM_GetTrainBySwip(TrainID *, BfMSwip *, char **, Four)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_GetTrainBySwip()
+ *================================*/
+/*
+ * Function: EduBfM_GetTrainBySwip(TrainID*, BfMSwip*, char**, Four)
+ *
+ * Description : 
+ *  Return a buffer which has the disk content indicated by `trainId', as
+ *  EduBfM_GetTrain() does, using the swip 'swip' kept by the caller, e.g.
+ *  next to a child link in the in-memory image of an index node.
+ *  While the swip refers to the buffer holding the train, the train is
+ *  fixed without hashing and without any latch: the fixed count is
+ *  incremented first and the version of the buffer checked afterwards,
+ *  which fails if the buffer is being given to another train (see
+ *  edubfm_FenceBuffer()). A swip to a replaced train is not undone by the
+ *  replacement but found stale here; the train is then fixed through the
+ *  hash table and the swip set to its buffer again.
+ *  The train is unfixed by EduBfM_FreeTrainBySwip() or EduBfM_FreeTrain().
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFER_BFM - Invalid Buffer
+ *    eBADBUFFERTYPE_BFM - Invalid Buffer type
+ *    eBADPARAMETER_EDUBFM - Invalid swip
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) parameter swip
+ *     the buffer holding the train
+ *  2) parameter retBuf
+ *     pointer to buffer holding the disk train indicated by `trainId'
+ */
+Four EduBfM_GetTrainBySwip(
+    TrainID             *trainId,               /* IN train to be used */
+    BfMSwip             *swip,                  /* INOUT reference to the buffer of the train */
+    char                **retBuf,               /* OUT pointer to the returned buffer */
+    Four                type)                   /* IN buffer type */
+{
+    Four                e;                      /* for error */
+    Four                index;                  /* index of the buffer pool */
+    BfMHashKey          *key = (BfMHashKey *)trainId;
+
+
+    /*@ Check the validity of given parameters */
+    if(retBuf == NULL) ERR(eBADBUFFER_BFM);
+
+    if(IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
+
+    if(swip == NULL) ERR(eBADPARAMETER_EDUBFM);
+
+    CHECKKEY(key);
+
+    e = edubfm_Init();
+    if (e < 0) ERR(e);
+
+    index = swip->index;
+    if (index >= 0 && index < BI_NBUFS_LOAD(type))
+    {
+        BI_FIXED_INC(type, index);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+        if (!(BI_VERSION_LOAD(type, index) & 1) && EQUALKEY(key, &BI_KEY(type, index)))
+        {
+            BFM_STAT_INC(type, hits);
+            edubfm_PolicyHit(type, index);
+            if (!(BI_BITS_LOAD(type, index) & REFER)) BI_SET_BITS(type, index, REFER);
+
+            *retBuf = BI_BUFFER(type, index);
+
+            return(eNOERROR);
+        }
+
+        BI_FIXED_DEC(type, index);
+    }
+
+    /* The buffer pool is not moved while the train is fixed. */
+    e = EduBfM_GetTrain(trainId, retBuf, type);
+    if (e < 0) ERR(e);
+
+    swip->index = (*retBuf - BI_BUFFERPOOL(type)) / (PAGESIZE * BI_BUFSIZE(type));
+
+    return(eNOERROR);   /* No error */
+
+}  /* EduBfM_GetTrainBySwip() */
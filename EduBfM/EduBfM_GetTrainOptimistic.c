@@ -0,0 +1,130 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_GetTrainOptimistic.c
+ *
+ * Description : 
+ *  Return a buffer which has the disk content indicated by `trainId',
+ *  to be read without fixing the train.
+ *
+ * Exports:
+ *  Four EduBfM_GetTrainOptimistic(TrainID *, char **, Four, BfMOptimisticRead *)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_GetTrainOptimistic()
+ *================================*/
+/*
+ * Function: EduBfM_GetTrainOptimistic(TrainID*, char**, Four, BfMOptimisticRead*)
+ *
+ * Description : 
+ *  Return a buffer which has the disk content indicated by `trainId' for
+ *  an optimistic read. The train is not fixed: the caller reads the buffer
+ *  and then calls EduBfM_ValidateTrain(); if the validation fails, the
+ *  train has been modified or replaced meanwhile and what was read must be
+ *  discarded. The caller does not call EduBfM_FreeTrain().
+ *  'read->index' is a hint of the buffer holding the train, either NIL or
+ *  the index left by a previous read of the same train. If the hint is
+ *  right, nothing shared is written except the reference bit when the
+ *  clock has cleared it; otherwise the train is fixed and unfixed once, as
+ *  by EduBfM_GetTrain() and EduBfM_FreeTrain(), to find the buffer.
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFER_BFM - Invalid Buffer
+ *    eBADBUFFERTYPE_BFM - Invalid Buffer type
+ *    eBADPARAMETER_EDUBFM - Invalid read
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) parameter retBuf
+ *     pointer to buffer holding the disk train indicated by `trainId'
+ *  2) parameter read
+ *     the buffer and its version at the start of the read
+ */
+Four EduBfM_GetTrainOptimistic(
+    TrainID             *trainId,               /* IN train to be read */
+    char                **retBuf,               /* OUT pointer to the returned buffer */
+    Four                type,                   /* IN buffer type */
+    BfMOptimisticRead   *read)                  /* INOUT read to be validated */
+{
+    Four                e;                      /* for error */
+    Four                index;                  /* index of the buffer pool */
+    UFour               version;                /* version of the buffer */
+    BfMHashKey          *key = (BfMHashKey *)trainId;
+
+
+    /*@ Check the validity of given parameters */
+    if(retBuf == NULL) ERR(eBADBUFFER_BFM);
+
+    if(IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
+
+    if(read == NULL) ERR(eBADPARAMETER_EDUBFM);
+
+    CHECKKEY(key);
+
+    e = edubfm_Init();
+    if (e < 0) ERR(e);
+
+    /* from now on the buffer pool is not freed when it is moved */
+    if (!__atomic_load_n(&bufResize[type].optimistic, __ATOMIC_SEQ_CST))
+        __atomic_store_n(&bufResize[type].optimistic, TRUE, __ATOMIC_SEQ_CST);
+
+    index = read->index;
+    if (index >= 0 && index < BI_NBUFS_LOAD(type))
+    {
+        version = BI_VERSION_LOAD(type, index);
+        if (!(version & 1) && EQUALKEY(key, &BI_KEY(type, index)))
+        {
+            if (!(BI_BITS_LOAD(type, index) & REFER)) BI_SET_BITS(type, index, REFER);
+
+            read->version = version;
+            *retBuf = BI_BUFFER(type, index);
+
+            return(eNOERROR);
+        }
+    }
+
+    /* The buffer pool is not moved and the train not replaced while it is
+     * fixed, so the version taken then is valid until it is modified. */
+    e = EduBfM_GetTrain(trainId, retBuf, type);
+    if (e < 0) ERR(e);
+
+    read->index = (*retBuf - BI_BUFFERPOOL(type)) / (PAGESIZE * BI_BUFSIZE(type));
+    read->version = BI_VERSION_LOAD(type, read->index);
+    BFM_STAT_INC(type, optimisticFixes);
+
+    e = EduBfM_FreeTrain(trainId, type);
+    if (e < 0) ERR(e);
+
+    return(eNOERROR);   /* No error */
+
+}  /* EduBfM_GetTrainOptimistic() */
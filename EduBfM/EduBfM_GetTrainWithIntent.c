@@ -0,0 +1,198 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_GetTrainWithIntent.c
+ *
+ * Description : 
+ *  Return a buffer which has the disk content indicated by `trainId',
+ *  telling the buffer manager how the train will be used.
+ *
+ * Exports:
+ *  Four EduBfM_GetTrainWithIntent(TrainID *, char **, Four, Four)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_GetTrainWithIntent()
+ *================================*/
+/*
+ * Function: EduBfM_GetTrainWithIntent(TrainID*, char**, Four, Four)
+ *
+ * Description : 
+ *  Return a buffer which has the disk content indicated by `trainId', as
+ *  EduBfM_GetTrain() does. The access intent changes how the train is
+ *  treated by the buffer replacement:
+ *  - BFM_INTENT_NORMAL: the train is referenced, as by EduBfM_GetTrain().
+ *  - BFM_INTENT_ONCE: the train is read once by a scan. It is not
+ *    referenced, and a train read from the disk is put into a buffer of
+ *    the small ring of the calling thread (see edubfm_Ring.c), so that a
+ *    large scan recycles its own buffers instead of the others'.
+ *  - BFM_INTENT_KEEPHOT: the train, e.g. an index node near the root, is
+ *    referenced and marked hot; the clock passes over it one more time.
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFER_BFM - Invalid Buffer
+ *    eBADBUFFERTYPE_BFM - Invalid Buffer type
+ *    eBADPARAMETER_EDUBFM - Invalid access intent
+ *    eFIXEDBUFFER_EDUBFM - the train is fixed in another buffer pool
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) parameter retBuf
+ *     pointer to buffer holding the disk train indicated by `trainId'
+ */
+Four EduBfM_GetTrainWithIntent(
+    TrainID             *trainId,               /* IN train to be used */
+    char                **retBuf,               /* OUT pointer to the returned buffer */
+    Four                type,                   /* IN buffer type */
+    Four                intent)                 /* IN access intent (BFM_INTENT_XXX) */
+{
+    Four                e;                      /* for error */
+    Four                index;                  /* index of the buffer pool */
+    Four                found;                  /* index of the buffer loaded by another thread */
+    Boolean             loaded;                 /* has this thread read the train? */
+    BfMHashKey          *key = (BfMHashKey *)trainId;
+
+
+    /*@ Check the validity of given parameters */
+    /* Some restrictions may be added         */
+    if(retBuf == NULL) ERR(eBADBUFFER_BFM);
+
+    /* Is the buffer type valid? */
+    if(IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);	
+
+    if(intent < 0 || intent >= NUM_BFM_INTENTS) ERR(eBADPARAMETER_EDUBFM);
+
+    CHECKKEY(key);
+
+    e = edubfm_Init();
+    if (e < 0) ERR(e);
+
+    while (1)
+    {
+        loaded = FALSE;
+
+        edubfm_LatchKey(key, type);
+        index = edubfm_LookUp(key, type);
+        if (index != NOTFOUND_IN_HTABLE)
+        {
+            BI_FIXED_INC(type, index);
+            edubfm_UnlatchKey(key, type);
+            BFM_STAT_INC(type, hits);
+        }
+        else
+        {
+            edubfm_UnlatchKey(key, type);
+            BFM_STAT_INC(type, misses);
+            BFM_STAT_INC(type, missesByCaller[edubfm_caller]);
+
+            /* a copy in the buffer pool used before an assignment is written first */
+            e = edubfm_EvictFromOtherPools(key, type, TRUE);
+            if (e < 0) ERR(e);
+
+            /* The victim is returned claimed (fixed count 1) and out of the hash table. */
+            index = edubfm_AllocTrain(key, type, intent);
+            if (index < 0) ERR(index);
+
+            edubfm_LatchKey(key, type);
+            found = edubfm_LookUp(key, type);
+            if (found != NOTFOUND_IN_HTABLE)
+            {
+                /* Another thread has loaded the train in the meantime. */
+                BI_FIXED_INC(type, found);
+                edubfm_UnlatchKey(key, type);
+                edubfm_ReleaseBuffer(type, index);
+                index = found;
+            }
+            else
+            {
+                BI_KEY(type, index) = *key;
+                e = edubfm_Insert(&BI_KEY(type, index), index, type);
+                if (e < 0)
+                {
+                    edubfm_UnlatchKey(key, type);
+                    edubfm_ReleaseBuffer(type, index);
+                    ERR(e);
+                }
+
+                /* Fixers of the train wait until the read completes. */
+                edubfm_BeginFrameIO(type, index);
+                edubfm_UnlatchKey(key, type);
+
+                /* a train kept in the compressed tier is not read from the disk */
+                if (edubfm_TierGet(type, key, BI_BUFFER(type, index)))
+                    e = eNOERROR;
+                else
+                    e = edubfm_ReadTrain(trainId, BI_BUFFER(type, index), type);
+                if (e < 0)
+                {
+                    edubfm_LatchKey(key, type);
+                    edubfm_Delete(key, type);
+                    edubfm_UnlatchKey(key, type);
+                    BI_KEY(type, index).pageNo = NIL;
+                    edubfm_EndFrameIO(type, index);
+                    edubfm_ReleaseBuffer(type, index);
+                    ERR(e);
+                }
+
+                edubfm_PolicyLoad(type, index, key);
+                edubfm_EndFrameIO(type, index);
+                loaded = TRUE;
+            }
+        }
+
+        /* Wait for the read by another thread, and retry if it has failed. */
+        edubfm_WaitFrameIO(type, index);
+        if (EQUALKEY(key, &BI_KEY(type, index))) break;
+
+        BI_FIXED_DEC(type, index);
+    }
+
+    /* A train fixed once is not referenced, so that a scan does not push
+     * the other trains out; a train kept hot is promoted even when loaded. */
+    if (intent == BFM_INTENT_KEEPHOT || (intent == BFM_INTENT_NORMAL && !loaded))
+        edubfm_PolicyHit(type, index);
+
+    if (intent == BFM_INTENT_KEEPHOT)
+        BI_SET_BITS(type, index, REFER | HOT);
+    else if (intent == BFM_INTENT_NORMAL)
+        BI_SET_BITS(type, index, REFER);
+
+    *retBuf = BI_BUFFER(type, index);
+
+    /* The train is fixed, so it is not replaced by the trains read ahead. */
+    if (loaded) edubfm_ReadAhead(key, type);
+
+    BFM_TRACE(BFM_TRACE_GET, key, type);
+
+    return(eNOERROR);   /* No error */
+
+}  /* EduBfM_GetTrainWithIntent() */
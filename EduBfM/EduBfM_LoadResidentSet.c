@@ -0,0 +1,131 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_LoadResidentSet.c
+ *
+ * Description:
+ *  Read a resident set saved by EduBfM_SaveResidentSet() back into a
+ *  buffer pool in the background.
+ *
+ * Exports:
+ *  Four EduBfM_LoadResidentSet(Four, char *)
+ */
+
+
+#include <stdio.h> /* for fopen, fread & fclose */
+#include <stdlib.h> /* for malloc & free */
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_LoadResidentSet()
+ *================================*/
+/*
+ * Function: Four EduBfM_LoadResidentSet(Four, char *)
+ *
+ * Description:
+ *  Read the file 'fileName' written by EduBfM_SaveResidentSet() and start
+ *  a loader thread which reads its trains into the buffer pool, the
+ *  hottest first, by multi-train reads in the order of disk addresses
+ *  (see edubfm_WarmLoad.c). The function returns once the file has been
+ *  read; the trains arrive while the caller goes on, and a train fixed
+ *  before its read completes is waited for as a train read ahead.
+ *  A load still running is finished first. If no thread can be created,
+ *  the trains are read before returning. The loader thread is joined by
+ *  EduBfM_FlushAll() and cancelled by EduBfM_DiscardAll(), so one of them
+ *  must be called before the volume is dismounted.
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFERTYPE_BFM - bad buffer type
+ *    eBADPARAMETER_EDUBFM - fileName is NULL
+ *    eMEMORYALLOCERR_EDUBFM - memory allocation failed
+ *    eFILEIOERR_EDUBFM - the file cannot be read
+ *    eBADFILEFORMAT_EDUBFM - the file is not a resident set of the buffer pool
+ *    some errors caused by function calls
+ */
+Four EduBfM_LoadResidentSet(
+    Four		type,			/* IN buffer type */
+    char		*fileName)		/* IN file to be read */
+{
+    Four		e;			/* error code */
+    BfMResidentSetHeader header;
+    BfMWarmLoadJob	*job;
+    FILE		*fp;
+
+
+    /*@ Is the paramter valid? */
+    if (IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
+
+    if (fileName == NULL) ERR(eBADPARAMETER_EDUBFM);
+
+    e = edubfm_Init();
+    if (e < 0) ERR(e);
+
+    fp = fopen(fileName, "rb");
+    if (fp == NULL) ERR(eFILEIOERR_EDUBFM);
+
+    if (fread(&header, sizeof(header), 1, fp) != 1)
+    {
+        fclose(fp);
+        ERR(eBADFILEFORMAT_EDUBFM);
+    }
+
+    if (header.magic != BFM_RESIDENTSET_MAGIC || header.type != type ||
+        header.bufSize != BI_BUFSIZE(type) ||
+        header.nEntries < 0 || header.nEntries > BFM_MAXNBUFS)
+    {
+        fclose(fp);
+        ERR(eBADFILEFORMAT_EDUBFM);
+    }
+
+    /* the job and its entries in one block */
+    job = (BfMWarmLoadJob *)malloc(sizeof(BfMWarmLoadJob) + sizeof(BfMResidentEntry) * header.nEntries);
+    if (job == NULL)
+    {
+        fclose(fp);
+        ERR(eMEMORYALLOCERR_EDUBFM);
+    }
+
+    job->type = type;
+    job->nEntries = header.nEntries;
+    job->entry = (BfMResidentEntry *)(job + 1);
+
+    if (fread(job->entry, sizeof(BfMResidentEntry), header.nEntries, fp) != (size_t)header.nEntries)
+    {
+        fclose(fp);
+        free(job);
+        ERR(eBADFILEFORMAT_EDUBFM);
+    }
+
+    fclose(fp);
+
+    edubfm_StartWarmLoad(job);
+
+    return(eNOERROR);
+
+} /* EduBfM_LoadResidentSet() */
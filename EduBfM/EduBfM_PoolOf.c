@@ -0,0 +1,73 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_PoolOf.c
+ *
+ * Description:
+ *  Return the buffer pool of a file or an index.
+ *
+ * Exports:
+ *  Four EduBfM_PoolOf(PageID *, Four)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_PoolOf()
+ *================================*/
+/*
+ * Function: Four EduBfM_PoolOf(PageID *, Four)
+ *
+ * Description:
+ *  Return the buffer pool the file or index identified by 'physicalId' is
+ *  assigned to by EduBfM_AssignPool(), or 'defaultType', the buffer type
+ *  the caller would use otherwise (PAGE_BUF or LOT_LEAF_BUF).
+ *
+ * Returns:
+ *  buffer type, or error code
+ *    eBADPARAMETER_EDUBFM - NULL physicalId
+ *    eBADBUFFERTYPE_BFM - bad default buffer type
+ */
+Four EduBfM_PoolOf(
+    PageID		*physicalId,		/* IN PhysicalFileID or PhysicalIndexID */
+    Four		defaultType)		/* IN buffer type if not assigned */
+{
+    Four		pool;			/* assigned buffer type */
+
+
+    /*@ Is the paramter valid? */
+    if (physicalId == NULL) ERR(eBADPARAMETER_EDUBFM);
+
+    if (IS_BAD_BUFFERTYPE(defaultType)) ERR(eBADBUFFERTYPE_BFM);
+
+    pool = edubfm_PoolMapGet(physicalId);
+
+    return((pool == NIL) ? defaultType : pool);
+
+} /* EduBfM_PoolOf() */
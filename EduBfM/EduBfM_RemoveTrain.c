@@ -0,0 +1,127 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_RemoveTrain.c
+ *
+ * Description :
+ *  Drop a train of a deallocated page from the buffer pool without
+ *  writing it.
+ *
+ * Exports:
+ *  Four EduBfM_RemoveTrain(TrainID *, Four)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_RemoveTrain()
+ *================================*/
+/*
+ * Function: Four EduBfM_RemoveTrain(TrainID*, Four)
+ *
+ * Description :
+ *  Remove the train `trainId', whose page the caller has deallocated, from
+ *  the buffer pool. The train is discarded even if it is dirty, so that
+ *  the pages of a dropped index are never written. The buffer becomes
+ *  empty; the optimistic readers and the swips of the train fail from now
+ *  on. A train which is not in the buffer pool is only dropped from the
+ *  compressed tier. The caller must have freed the train; a buffer held
+ *  for a moment by the buffer manager itself, e.g. by a read-ahead or the
+ *  background writer, is waited for on its latch.
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFERTYPE_BFM - Invalid Buffer type
+ *    eFIXEDBUFFER_EDUBFM - the train is fixed by a caller
+ *    some errors caused by function calls
+ */
+Four EduBfM_RemoveTrain(
+    TrainID             *trainId,               /* IN train to be removed */
+    Four                type)                   /* IN buffer type */
+{
+    Four                e;                      /* for error */
+    Four                index;                  /* index of the buffer pool */
+    Boolean             dirty;                  /* was the train dirty? */
+    BfMHashKey          *key = (BfMHashKey *)trainId;
+
+
+    /* Is the buffer type valid? */
+    if(IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
+
+    CHECKKEY(key);
+
+    e = edubfm_Init();
+    if (e < 0) ERR(e);
+
+    while (1)
+    {
+        edubfm_LatchKey(key, type);
+        index = edubfm_LookUp(key, type);
+        if (index == NOTFOUND_IN_HTABLE)
+        {
+            edubfm_TierRemove(type, key);
+            edubfm_UnlatchKey(key, type);
+            return(eNOERROR);
+        }
+
+        /* The claim keeps the background writer and the victim selection
+         * away; the fence fails the fixers through swips. */
+        if (edubfm_ClaimBuffer(type, index))
+        {
+            if (edubfm_FenceBuffer(type, index)) break;
+            edubfm_UnclaimBuffer(type, index);
+        }
+
+        /* only a fix by a caller makes the removal fail */
+        if (!edubfm_WaitHeldBuffer(type, index, key)) ERR(eFIXEDBUFFER_EDUBFM);
+    }
+
+    e = edubfm_Delete(key, type);
+    if (e < 0)
+    {
+        edubfm_UnfenceBuffer(type, index);
+        edubfm_UnclaimBuffer(type, index);
+        edubfm_UnlatchKey(key, type);
+        ERR(e);
+    }
+    BI_KEY(type, index).pageNo = NIL;
+    dirty = (BI_BITS_LOAD(type, index) & DIRTY) ? TRUE : FALSE;
+    BI_CLEAR_BITS(type, index, DIRTY);
+    edubfm_UnlatchKey(key, type);
+
+    edubfm_DirtyUnlink(type, index);
+    if (dirty) BFM_STAT_INC(type, droppedWrites);
+
+    /* the version becomes even again */
+    edubfm_ReleaseBuffer(type, index);
+    edubfm_UnholdBuffer(type, index);
+
+    return(eNOERROR);
+
+}  /* EduBfM_RemoveTrain() */
@@ -0,0 +1,71 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_ResetStats.c
+ *
+ * Description:
+ *  Reset the statistics of a buffer pool.
+ *
+ * Exports:
+ *  Four EduBfM_ResetStats(Four)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_ResetStats()
+ *================================*/
+/*
+ * Function: Four EduBfM_ResetStats(Four)
+ *
+ * Description:
+ *  Set the statistics counters of a buffer pool to zero.
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFERTYPE_BFM - bad buffer type
+ */
+Four EduBfM_ResetStats(
+    Four		type)			/* IN buffer type */
+{
+    UEight		*counter;		/* counters of the buffer pool */
+    Four		i;
+
+
+    /*@ Is the paramter valid? */
+    if (IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
+
+    /* BfMStats consists of UEight counters only */
+    counter = (UEight *)&bufStats[type];
+    for (i = 0; i < sizeof(BfMStats) / sizeof(UEight); i++)
+        __atomic_store_n(&counter[i], 0, __ATOMIC_RELAXED);
+
+    return(eNOERROR);
+
+} /* EduBfM_ResetStats() */
@@ -0,0 +1,88 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_ResizeBuffers.c
+ *
+ * Description:
+ *  Change the size of a buffer pool at run time.
+ *
+ * Exports:
+ *  Four EduBfM_ResizeBuffers(Four, Four)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_ResizeBuffers()
+ *================================*/
+/*
+ * Function: Four EduBfM_ResizeBuffers(Four, Four)
+ *
+ * Description:
+ *  Set the # of buffers of a buffer pool to 'nBufs', up to BFM_MAXNBUFS,
+ *  e.g. to move memory from one buffer pool to the other. Other threads
+ *  may fix and unfix trains during the resize.
+ *  Shrinking forces the trains above the new size out of the buffer pool,
+ *  writing the dirty ones; it waits for them to be unfixed for a while
+ *  and gives up if they are not. Growing adds empty buffers.
+ *  The replacement policy is set up again for the new size, so LRU-K
+ *  forgets the history of the trains and 2Q, ARC and CLOCK-Pro their
+ *  ghost lists. If that fails, the buffer pool keeps its old size.
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFERTYPE_BFM - bad buffer type
+ *    eBADPARAMETER_EDUBFM - bad # of buffers
+ *    eFIXEDBUFFER_EDUBFM - a train above the new size stays fixed
+ *    some errors caused by function calls
+ */
+Four EduBfM_ResizeBuffers(
+    Four		type,			/* IN buffer type */
+    Four		nBufs)			/* IN new # of buffers */
+{
+    Four		e;			/* error code */
+
+
+    /*@ Is the paramter valid? */
+    if (IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
+
+    if (nBufs < 1 || nBufs > BFM_MAXNBUFS) ERR(eBADPARAMETER_EDUBFM);
+
+    e = edubfm_Init();
+    if (e < 0) ERR(e);
+
+    /* the buffers being loaded into cannot be moved nor drained */
+    edubfm_StopWarmLoad(type, FALSE);
+
+    e = edubfm_ResizeBufferPool(type, nBufs);
+    if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* EduBfM_ResizeBuffers() */
@@ -0,0 +1,133 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_SaveResidentSet.c
+ *
+ * Description:
+ *  Save the set of trains in a buffer pool, so that it can be read back
+ *  by EduBfM_LoadResidentSet() after a restart.
+ *
+ * Exports:
+ *  Four EduBfM_SaveResidentSet(Four, char *)
+ */
+
+
+#include <stdio.h> /* for fopen, fwrite & fclose */
+#include <stdlib.h> /* for malloc & free */
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_SaveResidentSet()
+ *================================*/
+/*
+ * Function: Four EduBfM_SaveResidentSet(Four, char *)
+ *
+ * Description:
+ *  Write the keys of the trains in the buffer pool, each with how hot it
+ *  is (see BFM_HEAT()), into the file 'fileName'. The trains themselves
+ *  are not written; the file only tells which trains to read back. It may
+ *  be called at shutdown or at any time while the buffer pool is in use,
+ *  in which case the trains replaced meanwhile may or may not be saved.
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFERTYPE_BFM - bad buffer type
+ *    eBADPARAMETER_EDUBFM - fileName is NULL
+ *    eMEMORYALLOCERR_EDUBFM - memory allocation failed
+ *    eFILEIOERR_EDUBFM - the file cannot be written
+ *    some errors caused by function calls
+ */
+Four EduBfM_SaveResidentSet(
+    Four		type,			/* IN buffer type */
+    char		*fileName)		/* IN file to be written */
+{
+    Four		e;			/* error code */
+    Four		i;
+    Four		n;			/* # of buffers */
+    BfMResidentSetHeader header;
+    BfMResidentEntry	*entry;
+    BfMHashKey		key;
+    FILE		*fp;
+
+
+    /*@ Is the paramter valid? */
+    if (IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
+
+    if (fileName == NULL) ERR(eBADPARAMETER_EDUBFM);
+
+    e = edubfm_Init();
+    if (e < 0) ERR(e);
+
+    /* the buffer pool may be resized meanwhile */
+    n = BI_NBUFS_LOAD(type);
+
+    entry = (BfMResidentEntry *)malloc(sizeof(BfMResidentEntry) * n);
+    if (entry == NULL) ERR(eMEMORYALLOCERR_EDUBFM);
+
+    header.magic = BFM_RESIDENTSET_MAGIC;
+    header.type = type;
+    header.bufSize = BI_BUFSIZE(type);
+    header.nEntries = 0;
+
+    for (i = 0; i < n; i++)
+    {
+        key = BI_KEY(type, i);
+        if (key.pageNo == NIL) continue;
+
+        edubfm_LatchKey(&key, type);
+        if (EQUALKEY(&key, &BI_KEY(type, i)))
+        {
+            entry[header.nEntries].key = key;
+            entry[header.nEntries].heat = BFM_HEAT(BI_BITS_LOAD(type, i));
+            header.nEntries++;
+        }
+        edubfm_UnlatchKey(&key, type);
+    }
+
+    fp = fopen(fileName, "wb");
+    if (fp == NULL)
+    {
+        free(entry);
+        ERR(eFILEIOERR_EDUBFM);
+    }
+
+    if (fwrite(&header, sizeof(header), 1, fp) != 1 ||
+        fwrite(entry, sizeof(BfMResidentEntry), header.nEntries, fp) != (size_t)header.nEntries)
+    {
+        fclose(fp);
+        free(entry);
+        ERR(eFILEIOERR_EDUBFM);
+    }
+
+    free(entry);
+
+    if (fclose(fp) != 0) ERR(eFILEIOERR_EDUBFM);
+
+    return(eNOERROR);
+
+} /* EduBfM_SaveResidentSet() */
@@ -0,0 +1,68 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_SetCaller.c
+ *
+ * Description:
+ *  Tell the buffer manager which module the calling thread is working for.
+ *
+ * Exports:
+ *  Four EduBfM_SetCaller(Four)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_SetCaller()
+ *================================*/
+/*
+ * Function: Four EduBfM_SetCaller(Four)
+ *
+ * Description:
+ *  Set the caller (BFM_CALLER_XXX) to which the misses of the calling
+ *  thread are attributed in BfMStats.missesByCaller, until it is set again.
+ *  A module sets itself on entry and restores the returned value on exit.
+ *
+ * Returns:
+ *  the previous caller, or error code
+ *    eBADPARAMETER_EDUBFM - bad caller
+ */
+Four EduBfM_SetCaller(
+    Four		caller)			/* IN BFM_CALLER_XXX */
+{
+    Four		prev = edubfm_caller;
+
+
+    if (caller < 0 || caller >= NUM_BFM_CALLERS) ERR(eBADPARAMETER_EDUBFM);
+
+    edubfm_caller = caller;
+
+    return(prev);
+
+} /* EduBfM_SetCaller() */
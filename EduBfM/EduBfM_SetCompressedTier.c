@@ -0,0 +1,70 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_SetCompressedTier.c
+ *
+ * Description:
+ *  Enable or disable the compressed tier of a buffer pool.
+ *
+ * Exports:
+ *  Four EduBfM_SetCompressedTier(Four, Four)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_SetCompressedTier()
+ *================================*/
+/*
+ * Function: Four EduBfM_SetCompressedTier(Four, Four)
+ *
+ * Description:
+ *  Set the memory, in bytes, for the trains of the buffer pool kept
+ *  compressed after their replacement (see edubfm_Tier.c); 0 disables
+ *  the compressed tier, which is the default, and frees its memory.
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFERTYPE_BFM - bad buffer type
+ *    eBADPARAMETER_EDUBFM - negative maxBytes
+ */
+Four EduBfM_SetCompressedTier(
+    Four		type,			/* IN buffer type */
+    Four		maxBytes)		/* IN memory of the tier in bytes */
+{
+    /*@ Is the paramter valid? */
+    if (IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
+
+    if (maxBytes < 0) ERR(eBADPARAMETER_EDUBFM);
+
+    edubfm_TierResize(type, maxBytes);
+
+    return(eNOERROR);
+
+} /* EduBfM_SetCompressedTier() */
@@ -54,6 +54,9 @@
  *  Set the dirty bit of an entry in the buffer table.
  *  Look up the entry in the using given parameters and set the dirty
  *  bit of the entry.
+ *  The version of the buffer is advanced, so that the optimistic reads of
+ *  the train in progress fail their validation; a modifier calls it
+ *  before unfixing the train.
  * 
  * Returns:
  *  error code
@@ -64,22 +67,37 @@ Four EduBfM_SetDirty(
     TrainID             *trainId,               /* IN which train has been modified in the buffer?  */
     Four                type )                  /* IN buffer type */
 {
+    Four                e;                      /* error code */
     Four                index;                  /* an index of the buffer table & pool */
 
 
     /*@ Is the paramter valid? */
     if (IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
 
+    CHECKKEY((BfMHashKey *)trainId);
+
+    e = edubfm_Init();
+    if (e < 0) ERR(e);
+
+    edubfm_LatchKey((BfMHashKey *)trainId, type);
+
     index = edubfm_LookUp((BfMHashKey *)trainId, type);
     if (index != NOTFOUND_IN_HTABLE)
     {
-        BI_BITS(type, index) = (BI_BITS(type, index) | DIRTY);
+        /* the thread which turns the dirty bit on links the buffer */
+        if (!(BI_FETCH_SET_BITS(type, index, DIRTY) & DIRTY))
+            edubfm_DirtyLink(type, index);
+        BI_VERSION_ADD(type, index, 2);
     }
     else 
     {
+        edubfm_UnlatchKey((BfMHashKey *)trainId, type);
         ERR (eNOTFOUND_BFM);
     }
 
+    edubfm_UnlatchKey((BfMHashKey *)trainId, type);
+
+    BFM_TRACE(BFM_TRACE_SETDIRTY, (BfMHashKey *)trainId, type);
 
     return( eNOERROR );
 
@@ -0,0 +1,89 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_SetPoolPlacement.c
+ *
+ * Description:
+ *  Change the memory placement of a buffer pool.
+ *
+ * Exports:
+ *  Four EduBfM_SetPoolPlacement(Four, Four)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_SetPoolPlacement()
+ *================================*/
+/*
+ * Function: Four EduBfM_SetPoolPlacement(Four, Four)
+ *
+ * Description:
+ *  Move the buffer pool into memory placed as 'flags' says, a combination
+ *  of BFM_POOL_HUGEPAGE and one of BFM_POOL_NUMA_INTERLEAVE and
+ *  BFM_POOL_NUMA_PARTITION. The buffer pools are moved into huge pages by
+ *  the first EduBfM call; this function changes the placement afterwards,
+ *  e.g. to spread a large buffer pool over the NUMA nodes.
+ *  No train of the buffer pool may be fixed.
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFERTYPE_BFM - bad buffer type
+ *    eBADPARAMETER_EDUBFM - bad flags
+ *    eFIXEDBUFFER_EDUBFM - a train is fixed
+ *    some errors caused by function calls
+ */
+Four EduBfM_SetPoolPlacement(
+    Four		type,			/* IN buffer type */
+    Four		flags)			/* IN BFM_POOL_XXX */
+{
+    Four		e;			/* error code */
+
+
+    /*@ Is the paramter valid? */
+    if (IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
+
+    if ((flags & ~(BFM_POOL_HUGEPAGE | BFM_POOL_NUMA_INTERLEAVE | BFM_POOL_NUMA_PARTITION)) ||
+        ((flags & BFM_POOL_NUMA_INTERLEAVE) && (flags & BFM_POOL_NUMA_PARTITION)))
+        ERR(eBADPARAMETER_EDUBFM);
+
+    e = edubfm_Init();
+    if (e < 0) ERR(e);
+
+    /* the buffers being loaded into cannot be moved */
+    edubfm_StopWarmLoad(type, FALSE);
+
+    pthread_mutex_lock(&bufResize[type].mutex);
+    e = edubfm_RemapBufferPool(type, flags, bufResize[type].poolCapacity);
+    pthread_mutex_unlock(&bufResize[type].mutex);
+    if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* EduBfM_SetPoolPlacement() */
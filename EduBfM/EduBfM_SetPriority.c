@@ -0,0 +1,99 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_SetPriority.c
+ *
+ * Description:
+ *  Set the priority class of a train in the buffer pool for the
+ *  replacement.
+ *
+ * Exports:
+ *  Four EduBfM_SetPriority(TrainID *, Four, Four)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_SetPriority()
+ *================================*/
+/*
+ * Function: Four EduBfM_SetPriority(TrainID *, Four, Four)
+ *
+ * Description:
+ *  Attach the priority class (BFM_PRIORITY_XXX) to the train, which the
+ *  caller has fixed, until the train leaves the buffer pool. A train of a
+ *  higher class escapes being chosen as a victim a few more times after
+ *  each fix (see edubfm_PolicyVictim()), under every replacement policy,
+ *  so that e.g. the root and internal pages of the B+ trees stay in the
+ *  buffer pool when the leaves and the data pages compete for it.
+ *  A B+ tree manager sets the class from the type of the page header
+ *  (ROOT, INTERNAL, LEAF) after fixing the page.
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFERTYPE_BFM - bad buffer type
+ *    eBADPARAMETER_EDUBFM - bad priority class
+ *    eNOTFOUND_BFM - the train is not in the buffer pool
+ *    some errors caused by function calls
+ */
+Four EduBfM_SetPriority(
+    TrainID		*trainId,		/* IN train fixed by the caller */
+    Four		type,			/* IN buffer type */
+    Four		priority)		/* IN BFM_PRIORITY_XXX */
+{
+    Four		e;			/* error code */
+    Four		index;			/* an index of the buffer table & pool */
+
+
+    /*@ Is the paramter valid? */
+    if (IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
+
+    if (priority < 0 || priority >= NUM_BFM_PRIORITIES) ERR(eBADPARAMETER_EDUBFM);
+
+    CHECKKEY((BfMHashKey *)trainId);
+
+    e = edubfm_Init();
+    if (e < 0) ERR(e);
+
+    edubfm_LatchKey((BfMHashKey *)trainId, type);
+
+    index = edubfm_LookUp((BfMHashKey *)trainId, type);
+    if (index == NOTFOUND_IN_HTABLE)
+    {
+        edubfm_UnlatchKey((BfMHashKey *)trainId, type);
+        ERR(eNOTFOUND_BFM);
+    }
+
+    edubfm_PolicySetPriority(type, index, priority);
+
+    edubfm_UnlatchKey((BfMHashKey *)trainId, type);
+
+    return(eNOERROR);
+
+} /* EduBfM_SetPriority() */
@@ -0,0 +1,84 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_SetReadAhead.c
+ *
+ * Description:
+ *  Enable or disable the read-ahead of a buffer pool.
+ *
+ * Exports:
+ *  Four EduBfM_SetReadAhead(Four, Four)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_SetReadAhead()
+ *================================*/
+/*
+ * Function: Four EduBfM_SetReadAhead(Four, Four)
+ *
+ * Description:
+ *  Set the maximum number of trains read ahead when sequential reads are
+ *  detected; 0 disables the read-ahead, which is the default. The value is
+ *  limited to BFM_MAXREADAHEAD and to a quarter of the buffer pool, so that
+ *  trains read ahead do not take over the buffer pool.
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFERTYPE_BFM - bad buffer type
+ *    eBADPARAMETER_EDUBFM - negative maxWindow
+ */
+Four EduBfM_SetReadAhead(
+    Four		type,			/* IN buffer type */
+    Four		maxWindow)		/* IN max # of trains read ahead */
+{
+    BufferReadAheadInfo	*ra;
+
+
+    /*@ Is the paramter valid? */
+    if (IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
+
+    if (maxWindow < 0) ERR(eBADPARAMETER_EDUBFM);
+
+    ra = &bufReadAhead[type];
+
+    pthread_mutex_lock(&ra->mutex);
+
+    ra->maxWindow = MIN(MIN(maxWindow, BFM_MAXREADAHEAD), BI_NBUFS_LOAD(type) / 4);
+    ra->window = 0;
+    ra->run = 0;
+    ra->lastMiss.pageNo = NIL;
+    ra->nextAhead.pageNo = NIL;
+
+    pthread_mutex_unlock(&ra->mutex);
+
+    return(eNOERROR);
+
+} /* EduBfM_SetReadAhead() */
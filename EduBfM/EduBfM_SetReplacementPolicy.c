@@ -0,0 +1,95 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_SetReplacementPolicy.c
+ *
+ * Description:
+ *  Choose the buffer replacement policy of a buffer pool.
+ *
+ * Exports:
+ *  Four EduBfM_SetReplacementPolicy(Four, Four)
+ *
+ * Notes:
+ *  The policy must be changed while no other thread uses the buffer pool.
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+/*@================================
+ * EduBfM_SetReplacementPolicy()
+ *================================*/
+/*
+ * Function: Four EduBfM_SetReplacementPolicy(Four, Four)
+ *
+ * Description:
+ *  Replace the buffer replacement policy of a buffer pool.
+ *  The state of the old policy is discarded, and the new policy starts
+ *  from the trains currently in the buffer pool. The trains in the buffer
+ *  pool are neither forced out nor discarded.
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFERTYPE_BFM - bad buffer type
+ *    eBADPOLICY_EDUBFM - bad replacement policy
+ *    some errors caused by function calls
+ */
+Four EduBfM_SetReplacementPolicy(
+    Four		type,			/* IN buffer type */
+    Four		policy)			/* IN replacement policy (BFM_POLICY_XXX) */
+{
+    Four		e;			/* error code */
+
+
+    /*@ Is the paramter valid? */
+    if (IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
+
+    if (policy < 0 || policy >= NUM_BFM_POLICIES) ERR(eBADPOLICY_EDUBFM);
+
+    e = edubfm_Init();
+    if (e < 0) ERR(e);
+
+    if (BI_POLICY(type) == edubfm_policies[policy]) return(eNOERROR);
+
+    pthread_mutex_lock(&bufPolicy[type].latch);
+
+    BI_POLICY(type)->final(type);
+    BI_POLICY(type) = edubfm_policies[policy];
+    e = BI_POLICY(type)->init(type);
+    if (e < 0)
+    {
+        /* fall back to the clock, which needs no state */
+        BI_POLICY(type) = &edubfm_clockPolicy;
+        pthread_mutex_unlock(&bufPolicy[type].latch);
+        ERR(e);
+    }
+
+    pthread_mutex_unlock(&bufPolicy[type].latch);
+
+    return(eNOERROR);
+
+} /* EduBfM_SetReplacementPolicy() */
@@ -0,0 +1,102 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_StartBgWriter.c
+ *
+ * Description:
+ *  Start the background writer of a buffer pool.
+ *
+ * Exports:
+ *  Four EduBfM_StartBgWriter(Four, Four, Four)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_StartBgWriter()
+ *================================*/
+/*
+ * Function: Four EduBfM_StartBgWriter(Four, Four, Four)
+ *
+ * Description:
+ *  Start a thread which forces out dirty trains ahead of the clock hand so
+ *  that 'cleanTarget' clean unfixed buffers are ready for replacement,
+ *  sweeping every 'interval' milliseconds. While the writer is running,
+ *  the clock passes over dirty victims and leaves them to the writer as
+ *  long as there are other candidates.
+ *  If the writer is already running, only its parameters are changed.
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFERTYPE_BFM - bad buffer type
+ *    eBADPARAMETER_EDUBFM - bad cleanTarget or interval
+ *    eTHREADCREATEFAILED_EDUBFM - the thread could not be created
+ *    some errors caused by function calls
+ */
+Four EduBfM_StartBgWriter(
+    Four		type,			/* IN buffer type */
+    Four		cleanTarget,		/* IN # of clean buffers to keep ready */
+    Four		interval)		/* IN sleep time between sweeps in msec */
+{
+    Four		e;			/* error code */
+    BufferWriterInfo	*w;
+
+
+    /*@ Is the paramter valid? */
+    if (IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
+
+    if (cleanTarget < 1 || interval < 1) ERR(eBADPARAMETER_EDUBFM);
+
+    e = edubfm_Init();
+    if (e < 0) ERR(e);
+
+    w = &bufWriter[type];
+
+    pthread_mutex_lock(&w->mutex);
+
+    w->cleanTarget = cleanTarget;
+    w->interval = interval;
+
+    if (!w->running)
+    {
+        w->stop = FALSE;
+        w->wakeup = FALSE;
+        if (pthread_create(&w->thread, NULL, edubfm_BgWriterMain, (void *)(long)type) != 0)
+        {
+            pthread_mutex_unlock(&w->mutex);
+            ERR(eTHREADCREATEFAILED_EDUBFM);
+        }
+        __atomic_store_n(&w->running, TRUE, __ATOMIC_RELEASE);
+    }
+
+    pthread_mutex_unlock(&w->mutex);
+
+    return(eNOERROR);
+
+} /* EduBfM_StartBgWriter() */
@@ -0,0 +1,95 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_StartTrace.c
+ *
+ * Description:
+ *  Start recording a trace of the buffer manager.
+ *
+ * Exports:
+ *  Four EduBfM_StartTrace(char *)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_StartTrace()
+ *================================*/
+/*
+ * Function: Four EduBfM_StartTrace(char *)
+ *
+ * Description:
+ *  Record every fix (EduBfM_GetTrain(), EduBfM_GetTrainWithIntent() and
+ *  EduBfM_GetNewTrain()), unfix (EduBfM_FreeTrain()) and modification
+ *  (EduBfM_SetDirty()) of the trains of all buffer pools into the file
+ *  'fileName', until EduBfM_StopTrace() is called. The file consists of a
+ *  BfMTraceHeader followed by BfMTraceRecords. A trace already being
+ *  recorded is finished first. The fixes through swips are not recorded.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_EDUBFM - fileName is NULL
+ *    eFILEIOERR_EDUBFM - the file cannot be written
+ */
+Four EduBfM_StartTrace(
+    char		*fileName)		/* IN trace file to be written */
+{
+    FILE		*fp;
+    BfMTraceHeader	header;
+
+
+    /*@ Is the paramter valid? */
+    if (fileName == NULL) ERR(eBADPARAMETER_EDUBFM);
+
+    (void) EduBfM_StopTrace();
+
+    fp = fopen(fileName, "wb");
+    if (fp == NULL) ERR(eFILEIOERR_EDUBFM);
+
+    header.magic = BFM_TRACE_MAGIC;
+    header.recordSize = sizeof(BfMTraceRecord);
+    if (fwrite(&header, sizeof(header), 1, fp) != 1)
+    {
+        fclose(fp);
+        ERR(eFILEIOERR_EDUBFM);
+    }
+
+    pthread_mutex_lock(&bufTrace.mutex);
+
+    bufTrace.fp = fp;
+    bufTrace.failed = FALSE;
+    bufTrace.nRecords = 0;
+    bufTrace.start = edubfm_Now();
+    __atomic_store_n(&bufTrace.active, TRUE, __ATOMIC_RELAXED);
+
+    pthread_mutex_unlock(&bufTrace.mutex);
+
+    return(eNOERROR);
+
+} /* EduBfM_StartTrace() */
@@ -0,0 +1,83 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_StopBgWriter.c
+ *
+ * Description:
+ *  Stop the background writer of a buffer pool.
+ *
+ * Exports:
+ *  Four EduBfM_StopBgWriter(Four)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_StopBgWriter()
+ *================================*/
+/*
+ * Function: Four EduBfM_StopBgWriter(Four)
+ *
+ * Description:
+ *  Stop the background writer of the buffer pool and wait until it exits.
+ *  Dirty trains are left in the buffer pool; nothing happens if the writer
+ *  is not running or is being stopped by another thread.
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFERTYPE_BFM - bad buffer type
+ */
+Four EduBfM_StopBgWriter(
+    Four		type)			/* IN buffer type */
+{
+    BufferWriterInfo	*w;
+
+
+    /*@ Is the paramter valid? */
+    if (IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
+
+    w = &bufWriter[type];
+
+    pthread_mutex_lock(&w->mutex);
+    if (!w->running || w->stop)
+    {
+        pthread_mutex_unlock(&w->mutex);
+        return(eNOERROR);
+    }
+    w->stop = TRUE;
+    pthread_cond_signal(&w->cond);
+    pthread_mutex_unlock(&w->mutex);
+
+    pthread_join(w->thread, NULL);
+
+    __atomic_store_n(&w->running, FALSE, __ATOMIC_RELEASE);
+
+    return(eNOERROR);
+
+} /* EduBfM_StopBgWriter() */
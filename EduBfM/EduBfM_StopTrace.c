@@ -0,0 +1,81 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_StopTrace.c
+ *
+ * Description:
+ *  Stop recording a trace of the buffer manager.
+ *
+ * Exports:
+ *  Four EduBfM_StopTrace(void)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_StopTrace()
+ *================================*/
+/*
+ * Function: Four EduBfM_StopTrace(void)
+ *
+ * Description:
+ *  Stop recording the trace started by EduBfM_StartTrace(), write the
+ *  records left in memory and close the trace file. It is not an error to
+ *  call this function when no trace is being recorded.
+ *
+ * Returns:
+ *  error code
+ *    eFILEIOERR_EDUBFM - a part of the trace could not be written
+ */
+Four EduBfM_StopTrace(void)
+{
+    Four		e;			/* error code */
+
+
+    pthread_mutex_lock(&bufTrace.mutex);
+
+    if (!bufTrace.active)
+    {
+        pthread_mutex_unlock(&bufTrace.mutex);
+        return(eNOERROR);
+    }
+
+    __atomic_store_n(&bufTrace.active, FALSE, __ATOMIC_RELAXED);
+
+    e = edubfm_TraceFlush();
+    if (fclose(bufTrace.fp) != 0) e = eFILEIOERR_EDUBFM;
+    bufTrace.fp = NULL;
+
+    pthread_mutex_unlock(&bufTrace.mutex);
+
+    if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* EduBfM_StopTrace() */
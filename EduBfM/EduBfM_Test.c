@@ -42,6 +42,7 @@
 
 void edubfm_dump_buffertable(Four);
 void edubfm_dump_hashtable(Four);
+void edubfm_dump_stats(Four);
 void press_enter_for_continue(Boolean);
 
 
@@ -346,6 +347,13 @@ Four EduBfM_Test(Four volId, Boolean getcharFlag)
 	printf("\n\n");
 	printf("****************************** TEST#3, EduBfM_FlushAll and EduBfM_DiscardAll. ******************************\n");
 	/* #3 End test */
+
+	/* The statistics vary from run to run, so they are shown only interactively. */
+	if (getcharFlag)
+	{
+		edubfm_dump_stats(PAGE_BUF);
+		printf("\t(Statistics of the page buffer pool)\n");
+	}
 	
 	return ( eNOERROR );
 }
@@ -416,6 +424,78 @@ void edubfm_dump_hashtable(
 	
 } /* edubfm_dump_hashtable() */
 
+/*@================================
+ * edubfm_dump_histogram()
+ *================================*/
+/*
+ * Function: static void edubfm_dump_histogram(char *, BfMHistogram *)
+ *
+ * Description:
+ *  Dump a histogram of the buffer pool statistics.
+ *
+ * Returns:
+ *  None
+ */
+static void edubfm_dump_histogram(
+		char            *name,          /* IN name of the histogram */
+		BfMHistogram    *h)             /* IN histogram */
+{
+	Four                 b;
+	
+	
+	printf("\t| %-14s count %-8llu avg %-8llu max %-8llu\n", name, (unsigned long long)h->count,
+			(unsigned long long)(h->count ? h->sum / h->count : 0), (unsigned long long)h->max);
+	for( b = 0; b < BFM_HIST_BUCKETS; b++ ) {
+		if(h->bucket[b] == 0) continue;
+		if(b == 0)
+			printf("\t|%20s%10s : %llu\n", "", "0", (unsigned long long)h->bucket[b]);
+		else
+			printf("\t|%20s%10llu+: %llu\n", "", 1ULL << (b - 1), (unsigned long long)h->bucket[b]);
+	}
+	
+} /* edubfm_dump_histogram() */
+
+
+/*@================================
+ * edubfm_dump_stats()
+ *================================*/
+/*
+ * Function: void edubfm_dump_stats(Four)
+ *
+ * Description:
+ *  Dump the statistics of a buffer pool.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_dump_stats(
+		Four        type)           /* IN buffer type */
+{
+	BfMStats             stats;
+	
+	
+	if(EduBfM_GetStats(type, &stats) < eNOERROR) return;
+	
+	printf("\n\t|===============================================|\n");
+	printf("\t|               Buffer Statistics               |\n");
+	printf("\t|===============================================|\n");
+	printf("\t| hits %llu, misses %llu (OM %llu, BtM %llu, catalog %llu, other %llu)\n",
+			(unsigned long long)stats.hits, (unsigned long long)stats.misses,
+			(unsigned long long)stats.missesByCaller[BFM_CALLER_OM],
+			(unsigned long long)stats.missesByCaller[BFM_CALLER_BTM],
+			(unsigned long long)stats.missesByCaller[BFM_CALLER_CATALOG],
+			(unsigned long long)stats.missesByCaller[BFM_CALLER_OTHER]);
+	printf("\t| evictions %llu (clean %llu, dirty %llu), background writes %llu, prefetches %llu\n",
+			(unsigned long long)stats.evictions, (unsigned long long)stats.cleanEvictions,
+			(unsigned long long)stats.dirtyEvictions, (unsigned long long)stats.bgFlushes,
+			(unsigned long long)stats.prefetches);
+	edubfm_dump_histogram("sweep", &stats.sweep);
+	edubfm_dump_histogram("read (us)", &stats.readLatency);
+	edubfm_dump_histogram("write (us)", &stats.writeLatency);
+	printf("\t|===============================================|\n");
+	
+} /* edubfm_dump_stats() */
+
 /*@================================
  * press_enter_for_continue(Boolean)
  *================================*/
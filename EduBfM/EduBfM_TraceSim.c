@@ -0,0 +1,492 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_TraceSim.c
+ *
+ * Description :
+ *  Main routine of the EduBfM trace simulator. It replays a trace recorded
+ *  by EduBfM_StartTrace() against buffer pools of several sizes under each
+ *  replacement policy, and prints the hit ratio of each, i.e. the hit ratio
+ *  curve of each policy. The trains are replaced by the replacement
+ *  policies of EduBfM themselves, on a buffer pool of the simulator which
+ *  holds no data, so no volume is needed and nothing is read or written.
+ *
+ *  Usage: EduBfM_TraceSim traceFile [-t type] [-p policy,...] [-s nBufs,...]
+ *   -t : buffer type whose records are replayed (default: 0, PAGE_BUF)
+ *   -p : replacement policies, BFM_POLICY_XXX (default: all)
+ *   -s : sizes of the buffer pool (default: powers of 2 up to the # of
+ *        distinct trains)
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+/*@
+ * constant definitions
+ */
+#define MAXSIZES	32		/* max # of sizes of a hit ratio curve */
+#define MINDEFAULTSIZE	8		/* smallest default size */
+
+
+/* names of the replacement policies indexed by BFM_POLICY_XXX */
+static char *edubfm_sim_policyName[NUM_BFM_POLICIES] = {
+    "CLOCK", "LRU-2", "2Q", "ARC", "CLOCK-Pro"
+};
+
+/* result of the replay of a trace */
+typedef struct {
+    UEight	hits;			/* # of fixes of resident trains */
+    UEight	misses;			/* # of fixes which would read the disk */
+    UEight	writes;			/* # of dirty trains replaced */
+} SimResult;
+
+static Boolean *edubfm_sim_dirty;	/* is the train of a buffer modified? */
+
+
+
+/*@================================
+ * edubfm_sim_compare()
+ *================================*/
+/*
+ * Function: static int edubfm_sim_compare(const void *, const void *)
+ *
+ * Description:
+ *  Order the trains by their disk address, for qsort().
+ *
+ * Returns:
+ *  negative, 0 or positive
+ */
+static int edubfm_sim_compare(
+    const void		*a,
+    const void		*b)
+{
+    const BfMHashKey	*k1 = (const BfMHashKey *)a;
+    const BfMHashKey	*k2 = (const BfMHashKey *)b;
+
+
+    if (k1->volNo != k2->volNo) return((k1->volNo < k2->volNo) ? -1 : 1);
+    if (k1->pageNo != k2->pageNo) return((k1->pageNo < k2->pageNo) ? -1 : 1);
+
+    return(0);
+
+} /* edubfm_sim_compare() */
+
+
+
+/*@================================
+ * edubfm_sim_load()
+ *================================*/
+/*
+ * Function: static Four edubfm_sim_load(char *, Four, BfMTraceRecord **, Four *, Four *)
+ *
+ * Description:
+ *  Read the records of the buffer type 'type' from the trace file, and
+ *  count the distinct trains fixed by them.
+ *
+ * Returns:
+ *  error code
+ *    eFILEIOERR_EDUBFM - the file cannot be read
+ *    eBADFILEFORMAT_EDUBFM - the file is not a trace
+ *    eMEMORYALLOCERR_EDUBFM - memory allocation failed
+ */
+static Four edubfm_sim_load(
+    char		*fileName,		/* IN trace file */
+    Four		type,			/* IN buffer type to be replayed */
+    BfMTraceRecord	**records,		/* OUT records of the buffer type */
+    Four		*nRecords,		/* OUT # of records */
+    Four		*nTrains)		/* OUT # of distinct trains */
+{
+    FILE		*fp;
+    BfMTraceHeader	header;
+    BfMTraceRecord	r;
+    Four		capacity = 1024;
+    Four		n = 0;
+    Four		i, j;
+    BfMHashKey		*keys;
+
+
+    fp = fopen(fileName, "rb");
+    if (fp == NULL) ERR(eFILEIOERR_EDUBFM);
+
+    if (fread(&header, sizeof(header), 1, fp) != 1 ||
+        header.magic != BFM_TRACE_MAGIC || header.recordSize != sizeof(BfMTraceRecord))
+    {
+        fclose(fp);
+        ERR(eBADFILEFORMAT_EDUBFM);
+    }
+
+    *records = (BfMTraceRecord *)malloc(sizeof(BfMTraceRecord) * capacity);
+    if (*records == NULL)
+    {
+        fclose(fp);
+        ERR(eMEMORYALLOCERR_EDUBFM);
+    }
+
+    while (fread(&r, sizeof(r), 1, fp) == 1)
+    {
+        if (r.type != type || r.op < 0 || r.op >= NUM_BFM_TRACEOPS) continue;
+
+        if (n == capacity)
+        {
+            capacity *= 2;
+            *records = (BfMTraceRecord *)realloc(*records, sizeof(BfMTraceRecord) * capacity);
+            if (*records == NULL)
+            {
+                fclose(fp);
+                ERR(eMEMORYALLOCERR_EDUBFM);
+            }
+        }
+        (*records)[n++] = r;
+    }
+
+    fclose(fp);
+    *nRecords = n;
+
+    /* count the distinct trains */
+    keys = (BfMHashKey *)malloc(sizeof(BfMHashKey) * MAX(n, 1));
+    if (keys == NULL) ERR(eMEMORYALLOCERR_EDUBFM);
+
+    for (i = 0; i < n; i++)
+    {
+        keys[i].volNo = (*records)[i].volNo;
+        keys[i].pageNo = (*records)[i].pageNo;
+    }
+    qsort(keys, n, sizeof(BfMHashKey), edubfm_sim_compare);
+
+    for (i = 0, j = 0; i < n; i++)
+        if (i == 0 || !EQUALKEY(&keys[i], &keys[i - 1])) j++;
+    *nTrains = j;
+
+    free(keys);
+
+    return(eNOERROR);
+
+} /* edubfm_sim_load() */
+
+
+
+/*@================================
+ * edubfm_sim_setup()
+ *================================*/
+/*
+ * Function: static Four edubfm_sim_setup(Four, Four)
+ *
+ * Description:
+ *  Empty the buffer pool of the simulator, change its size to 'nBufs' and
+ *  start the replacement policy 'policy' over. The buffer pool is used by
+ *  the simulator alone.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+static Four edubfm_sim_setup(
+    Four		type,			/* IN buffer type of the simulator */
+    Four		nBufs,			/* IN # of buffers */
+    Four		policy)			/* IN BFM_POLICY_XXX */
+{
+    Four		e;			/* error */
+    Four		i;
+
+
+    edubfm_LatchAllStripes(type);
+    for (i = 0; i < BI_NBUFS(type); i++)
+    {
+        BI_KEY(type, i).pageNo = NIL;
+        BI_FIXED(type, i) = 0;
+        BI_BITS(type, i) = ALL_0;
+        edubfm_sim_dirty[i] = FALSE;
+    }
+    for (i = 0; i < HASHTABLESIZE(type); i++)
+        BI_HASHTABLEENTRY(type, i) = NIL;
+    edubfm_UnlatchAllStripes(type);
+
+    e = edubfm_ResizeBufferPool(type, nBufs);
+    if (e < 0) ERR(e);
+
+    BI_POLICY(type)->final(type);
+    BI_POLICY(type) = edubfm_policies[policy];
+    e = BI_POLICY(type)->init(type);
+    if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* edubfm_sim_setup() */
+
+
+
+/*@================================
+ * edubfm_sim_replay()
+ *================================*/
+/*
+ * Function: static Four edubfm_sim_replay(Four, BfMTraceRecord *, Four, SimResult *)
+ *
+ * Description:
+ *  Replay the records on the buffer pool of the simulator as
+ *  EduBfM_GetTrain(), EduBfM_GetNewTrain(), EduBfM_FreeTrain() and
+ *  EduBfM_SetDirty() treat the buffer pool, without the disk I/O.
+ *  A record of a train not fixed in the buffer pool is ignored, since a
+ *  trace may be started while trains are fixed.
+ *
+ * Returns:
+ *  error code
+ *    eNOUNFIXEDBUF_BFM - the buffer pool is too small for the fixed trains
+ *    some errors caused by function calls
+ */
+static Four edubfm_sim_replay(
+    Four		type,			/* IN buffer type of the simulator */
+    BfMTraceRecord	*records,		/* IN records to be replayed */
+    Four		nRecords,		/* IN # of records */
+    SimResult		*result)		/* OUT hits, misses and writes */
+{
+    Four		e;			/* error */
+    Four		i;
+    Four		index;			/* buffer holding the train */
+    BfMHashKey		key;
+
+
+    memset(result, 0, sizeof(SimResult));
+
+    for (i = 0; i < nRecords; i++)
+    {
+        key.volNo = records[i].volNo;
+        key.pageNo = records[i].pageNo;
+
+        edubfm_LatchKey(&key, type);
+        index = edubfm_LookUp(&key, type);
+
+        switch (records[i].op)
+        {
+          case BFM_TRACE_GET:
+          case BFM_TRACE_NEW:
+            if (index != NOTFOUND_IN_HTABLE)
+            {
+                BI_FIXED_INC(type, index);
+                edubfm_UnlatchKey(&key, type);
+                if (records[i].op == BFM_TRACE_GET) result->hits++;
+                edubfm_PolicyHit(type, index);
+            }
+            else
+            {
+                edubfm_UnlatchKey(&key, type);
+                if (records[i].op == BFM_TRACE_GET) result->misses++;
+
+                index = edubfm_AllocTrain(&key, type, BFM_INTENT_NORMAL);
+                if (index < 0) ERR(index);
+
+                if (edubfm_sim_dirty[index]) result->writes++;
+                edubfm_sim_dirty[index] = FALSE;
+
+                BI_KEY(type, index) = key;
+                edubfm_LatchKey(&key, type);
+                e = edubfm_Insert(&BI_KEY(type, index), index, type);
+                edubfm_UnlatchKey(&key, type);
+                if (e < 0) ERR(e);
+
+                edubfm_BeginFrameIO(type, index);
+                edubfm_PolicyLoad(type, index, &key);
+                edubfm_EndFrameIO(type, index);
+            }
+            BI_SET_BITS(type, index, REFER);
+            break;
+
+          case BFM_TRACE_FREE:
+            if (index != NOTFOUND_IN_HTABLE && BI_FIXED(type, index) > 0)
+                BI_FIXED_DEC(type, index);
+            edubfm_UnlatchKey(&key, type);
+            break;
+
+          case BFM_TRACE_SETDIRTY:
+            if (index != NOTFOUND_IN_HTABLE) edubfm_sim_dirty[index] = TRUE;
+            edubfm_UnlatchKey(&key, type);
+            break;
+        }
+    }
+
+    return(eNOERROR);
+
+} /* edubfm_sim_replay() */
+
+
+
+/*@================================
+ * edubfm_sim_parse_list()
+ *================================*/
+/*
+ * Function: static Four edubfm_sim_parse_list(char *, Four *, Four)
+ *
+ * Description:
+ *  Parse a comma-separated list of numbers.
+ *
+ * Returns:
+ *  # of numbers
+ */
+static Four edubfm_sim_parse_list(
+    char		*s,			/* IN list */
+    Four		*values,		/* OUT numbers */
+    Four		max)			/* IN max # of numbers */
+{
+    Four		n = 0;
+    char		*token;
+
+
+    for (token = strtok(s, ","); token != NULL && n < max; token = strtok(NULL, ","))
+        values[n++] = atoi(token);
+
+    return(n);
+
+} /* edubfm_sim_parse_list() */
+
+
+
+Four main(Four argc, char *argv[])
+{
+    Four		e;			/* for errors */
+    Four		i, j;
+    Four		type = PAGE_BUF;	/* buffer type to be replayed */
+    Four		simType = NUM_BUF_TYPES;/* buffer type of the simulator */
+    Four		policies[NUM_BFM_POLICIES];
+    Four		nPolicies = 0;
+    Four		sizes[MAXSIZES];
+    Four		nSizes = 0;
+    Four		maxSize;
+    char		*fileName = NULL;
+    BfMTraceRecord	*records;
+    Four		nRecords;
+    Four		nTrains;
+    SimResult		result;
+
+
+    for (i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+            type = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+            nPolicies = edubfm_sim_parse_list(argv[++i], policies, NUM_BFM_POLICIES);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+            nSizes = edubfm_sim_parse_list(argv[++i], sizes, MAXSIZES);
+        else if (argv[i][0] != '-' && fileName == NULL)
+            fileName = argv[i];
+        else
+        {
+            fileName = NULL;
+            break;
+        }
+    }
+
+    if (fileName == NULL)
+    {
+        printf("Usage: %s traceFile [-t type] [-p policy,...] [-s nBufs,...]\n", argv[0]);
+        return(1);
+    }
+
+    e = edubfm_sim_load(fileName, type, &records, &nRecords, &nTrains);
+    if (e < 0)
+    {
+        printf("Cannot read the trace file %s\n", fileName);
+        return(1);
+    }
+
+    if (nPolicies == 0)
+        for (nPolicies = 0; nPolicies < NUM_BFM_POLICIES; nPolicies++) policies[nPolicies] = nPolicies;
+
+    if (nSizes == 0)
+    {
+        for (j = MINDEFAULTSIZE; j < MIN(nTrains, BFM_MAXNBUFS) && nSizes < MAXSIZES - 1; j *= 2)
+            sizes[nSizes++] = j;
+        sizes[nSizes++] = MAX(MIN(nTrains, BFM_MAXNBUFS), 1);
+    }
+
+    maxSize = 0;
+    for (i = 0; i < nSizes; i++)
+    {
+        if (sizes[i] < 1 || sizes[i] > BFM_MAXNBUFS)
+        {
+            printf("Bad size %ld: 1 ~ %ld buffers\n", (long)sizes[i], (long)BFM_MAXNBUFS);
+            return(1);
+        }
+        maxSize = MAX(maxSize, sizes[i]);
+    }
+    for (i = 0; i < nPolicies; i++)
+    {
+        if (policies[i] < 0 || policies[i] >= NUM_BFM_POLICIES)
+        {
+            printf("Bad policy %ld: 0 ~ %ld\n", (long)policies[i], (long)NUM_BFM_POLICIES - 1);
+            return(1);
+        }
+    }
+
+    /* The buffer pool of the simulator is created as EduBfM_CreatePool()
+     * does, without the buffer pools of the storage system. */
+    edubfm_sim_dirty = (Boolean *)calloc(maxSize, sizeof(Boolean));
+    if (edubfm_sim_dirty == NULL) return(1);
+
+    e = edubfm_AllocPool(simType, 1, sizes[0]);
+    if (e >= 0) e = edubfm_SetUpPool(simType);
+    if (e < 0)
+    {
+        printf("Cannot create the buffer pool of the simulator\n");
+        return(1);
+    }
+    edubfm_nPools = simType + 1;
+
+    printf("%s: %ld records of buffer type %ld, %ld distinct trains\n",
+           fileName, (long)nRecords, (long)type, (long)nTrains);
+    printf("hit ratio (%%) / dirty trains replaced\n");
+
+    printf("%8s", "nBufs");
+    for (j = 0; j < nPolicies; j++) printf("  %18s", edubfm_sim_policyName[policies[j]]);
+    printf("\n");
+
+    for (i = 0; i < nSizes; i++)
+    {
+        printf("%8ld", (long)sizes[i]);
+        for (j = 0; j < nPolicies; j++)
+        {
+            e = edubfm_sim_setup(simType, sizes[i], policies[j]);
+            if (e >= 0) e = edubfm_sim_replay(simType, records, nRecords, &result);
+
+            if (e == eNOUNFIXEDBUF_BFM)
+                printf("  %18s", "too small");
+            else if (e < 0)
+                printf("  %18s", "error");
+            else
+                printf("  %8.2f / %7llu",
+                       (result.hits + result.misses > 0) ? 100.0 * result.hits / (result.hits + result.misses) : 0.0,
+                       (unsigned long long)result.writes);
+        }
+        printf("\n");
+    }
+
+    free(records);
+    free(edubfm_sim_dirty);
+
+    return(0);
+
+} /* main() */
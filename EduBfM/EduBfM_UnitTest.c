@@ -0,0 +1,892 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_UnitTest.c
+ *
+ * Description :
+ *  Main routine of the EduBfM unit tests. Unlike EduBfM_Test, whose output
+ *  is compared with a solution, each test checks the buffer pools itself
+ *  and prints "ok" or the first mismatch found. The tests run on buffer
+ *  pools created by EduBfM_CreatePool() over the pages of a volume of
+ *  their own, so the built-in buffer pools are left alone.
+ *
+ *  Usage: EduBfM_UnitTest
+ *  The exit status is the # of failed tests.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+#include "EduBfM_TestModule.h"
+
+
+/*@
+ * constant definitions
+ */
+#define UT_NPAGES	32		/* # of pages allocated for the tests */
+#define UT_MAXTRACE	16		/* max # of accesses of a policy trace */
+
+/* outcome of an access to a train */
+#define UT_HIT		-1		/* the train was resident */
+#define UT_EMPTY	0		/* the train was read into an empty buffer */
+
+/* kinds of data (see edubfm_ut_fill()) */
+#define UT_ZEROS	0
+#define UT_KEYS		1
+#define UT_RANDOM	2
+
+
+/* access trace of a replacement policy and the victims it must choose */
+typedef struct {
+    Four	policy;			/* BFM_POLICY_XXX */
+    Four	nBufs;			/* # of buffers */
+    Four	nAccesses;		/* # of accesses */
+    Four	page[UT_MAXTRACE];	/* train fixed and freed, 1 ~ UT_NPAGES-1 */
+    Four	victim[UT_MAXTRACE];	/* train replaced, UT_HIT or UT_EMPTY */
+} UTPolicyTrace;
+
+/* trains of the tests; edubfm_ut_pages[0] is not used */
+static PageID edubfm_ut_pages[UT_NPAGES];
+
+/* names of the replacement policies indexed by BFM_POLICY_XXX */
+static char *edubfm_ut_policyName[NUM_BFM_POLICIES] = {
+    "CLOCK", "LRU-2", "2Q", "ARC", "CLOCK-Pro"
+};
+
+/*
+ * The traces start with an empty buffer pool of 4 buffers. Each was worked
+ * out by hand from the paper of the policy and its implementation here.
+ */
+static UTPolicyTrace edubfm_ut_policyTraces[] = {
+    /* The clock clears the reference bits of a full round before it takes
+     * train 1 in spite of its hit; train 2 then gets its second chance. */
+    { BFM_POLICY_CLOCK, 4, 8,
+      { 1, 2, 3, 4, 1, 5, 2, 6 },
+      { UT_EMPTY, UT_EMPTY, UT_EMPTY, UT_EMPTY, UT_HIT, 1, UT_HIT, 3 } },
+
+    /* Train 4 is the most recent, but it is referenced once, so its
+     * backward 2-distance is infinite; the scan of 5 and 6 does not push
+     * out the trains referenced twice. */
+    { BFM_POLICY_LRUK, 4, 9,
+      { 1, 2, 3, 1, 2, 3, 4, 5, 6 },
+      { UT_EMPTY, UT_EMPTY, UT_EMPTY, UT_HIT, UT_HIT, UT_HIT, UT_EMPTY, 4, 5 } },
+
+    /* Kin is 1 and Kout is 2. A hit in A1in does not promote train 1; it
+     * goes to Am when it is read again from A1out, and so does train 2.
+     * The scan of 6 ~ 8 then only replaces trains of A1in. */
+    { BFM_POLICY_2Q, 4, 11,
+      { 1, 2, 3, 4, 1, 5, 1, 6, 2, 7, 8 },
+      { UT_EMPTY, UT_EMPTY, UT_EMPTY, UT_EMPTY, UT_HIT, 1, 2, 3, 4, 5, 6 } },
+
+    /* Trains 1 and 2 move to T2 on their hits. Train 3 is read again from
+     * B1, which raises p to 1, so T1 of size 1 is kept and the least recent
+     * train of T2 is replaced; a second train in T1 exceeds p again. */
+    { BFM_POLICY_ARC, 4, 10,
+      { 1, 2, 3, 4, 1, 2, 5, 3, 6, 7 },
+      { UT_EMPTY, UT_EMPTY, UT_EMPTY, UT_EMPTY, UT_HIT, UT_HIT, 3, 4, 1, 5 } },
+
+    /* Train 1 is referenced in its test period and turns hot when the
+     * cold hand passes it. Train 2, replaced in its test period, turns hot
+     * when it is read again. The cold hand passes over both hot trains. */
+    { BFM_POLICY_CLOCKPRO, 4, 10,
+      { 1, 2, 3, 4, 1, 5, 2, 6, 7, 8 },
+      { UT_EMPTY, UT_EMPTY, UT_EMPTY, UT_EMPTY, UT_HIT, 2, 3, 4, 5, 6 } }
+};
+
+
+
+/*@================================
+ * edubfm_ut_index()
+ *================================*/
+/*
+ * Function: static Four edubfm_ut_index(Four, Four)
+ *
+ * Description:
+ *  Find the buffer holding the train 'page' of the tests.
+ *
+ * Returns:
+ *  index of the buffer, or NOTFOUND_IN_HTABLE
+ */
+static Four edubfm_ut_index(
+    Four		type,			/* IN buffer type */
+    Four		page)			/* IN train of the tests */
+{
+    BfMHashKey		key;
+    Four		index;
+
+
+    key.volNo = edubfm_ut_pages[page].volNo;
+    key.pageNo = edubfm_ut_pages[page].pageNo;
+
+    edubfm_LatchKey(&key, type);
+    index = edubfm_LookUp(&key, type);
+    edubfm_UnlatchKey(&key, type);
+
+    return(index);
+
+} /* edubfm_ut_index() */
+
+
+
+/*@================================
+ * edubfm_ut_resident()
+ *================================*/
+/*
+ * Function: static Boolean edubfm_ut_resident(Four, Four)
+ *
+ * Description:
+ *  Is the train 'page' of the tests in the buffer pool?
+ *
+ * Returns:
+ *  TRUE or FALSE
+ */
+static Boolean edubfm_ut_resident(
+    Four		type,			/* IN buffer type */
+    Four		page)			/* IN train of the tests */
+{
+    return(edubfm_ut_index(type, page) != NOTFOUND_IN_HTABLE);
+
+} /* edubfm_ut_resident() */
+
+
+
+/*@================================
+ * edubfm_ut_access()
+ *================================*/
+/*
+ * Function: static Four edubfm_ut_access(Four, Four, Four *)
+ *
+ * Description:
+ *  Fix and free the train 'page' of the tests, and find out which train
+ *  of the tests it replaced.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) parameter victim
+ *     train replaced, UT_HIT or UT_EMPTY
+ */
+static Four edubfm_ut_access(
+    Four		type,			/* IN buffer type */
+    Four		page,			/* IN train of the tests */
+    Four		*victim)		/* OUT train replaced */
+{
+    Four		e;			/* error */
+    Four		i;
+    Boolean		before[UT_NPAGES];	/* resident before the access? */
+    char		*buf;
+
+
+    for (i = 1; i < UT_NPAGES; i++)
+        before[i] = edubfm_ut_resident(type, i);
+
+    e = EduBfM_GetTrain((TrainID *)&edubfm_ut_pages[page], &buf, type);
+    if (e < 0) ERR(e);
+
+    e = EduBfM_FreeTrain((TrainID *)&edubfm_ut_pages[page], type);
+    if (e < 0) ERR(e);
+
+    if (before[page])
+    {
+        *victim = UT_HIT;
+        return(eNOERROR);
+    }
+
+    *victim = UT_EMPTY;
+    for (i = 1; i < UT_NPAGES; i++)
+        if (before[i] && !edubfm_ut_resident(type, i)) *victim = i;
+
+    return(eNOERROR);
+
+} /* edubfm_ut_access() */
+
+
+/*@================================
+ * edubfm_ut_fill()
+ *================================*/
+/*
+ * Function: static void edubfm_ut_fill(char *, Four, Four, UFour)
+ *
+ * Description:
+ *  Fill 'n' bytes with data of the kind 'kind': zeros, the records of an
+ *  index page, whose keys share long prefixes, or pseudo-random bytes,
+ *  which do not compress, generated from 'seed'.
+ *
+ * Returns:
+ *  None
+ */
+static void edubfm_ut_fill(
+    char		*p,			/* OUT data */
+    Four		n,			/* IN # of bytes */
+    Four		kind,			/* IN UT_XXX */
+    UFour		seed)			/* IN seed of the random bytes */
+{
+    Four		i;
+    char		record[64];
+
+
+    switch (kind)
+    {
+      case UT_ZEROS:
+        memset(p, 0, n);
+        break;
+
+      case UT_KEYS:
+        for (i = 0; i < n; i += 32)
+        {
+            snprintf(record, sizeof(record), "customer-%08lu/order-%06ld;",
+                     (unsigned long)(seed + i / 64), (long)i);
+            memcpy(p + i, record, MIN(n - i, 32));
+        }
+        break;
+
+      case UT_RANDOM:
+        for (i = 0; i < n; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            p[i] = (char)(seed >> 16);
+        }
+        break;
+    }
+
+} /* edubfm_ut_fill() */
+
+
+
+/*@================================
+ * edubfm_ut_policies()
+ *================================*/
+/*
+ * Function: static Four edubfm_ut_policies(void)
+ *
+ * Description:
+ *  Replay the trace of each replacement policy on an empty buffer pool
+ *  and check the train replaced by each access.
+ *
+ * Returns:
+ *  # of failed traces
+ */
+static Four edubfm_ut_policies(void)
+{
+    Four		e;			/* error */
+    Four		type;			/* buffer type of the test */
+    Four		t, i;
+    Four		victim;			/* train replaced */
+    Four		nFailed = 0;
+    UTPolicyTrace	*trace;
+
+
+    type = EduBfM_CreatePool("ut_policy", 1, 4, BFM_POLICY_CLOCK);
+    if (type < 0)
+    {
+        printf("policies: EduBfM_CreatePool() failed (%ld)\n", (long)type);
+        return(1);
+    }
+
+    for (t = 0; t < sizeof(edubfm_ut_policyTraces) / sizeof(UTPolicyTrace); t++)
+    {
+        trace = &edubfm_ut_policyTraces[t];
+
+        e = EduBfM_SetReplacementPolicy(type, trace->policy);
+        if (e >= 0) e = EduBfM_ResizeBuffers(type, trace->nBufs);
+        if (e >= 0) e = EduBfM_DiscardAll();
+        if (e < 0)
+        {
+            printf("policy %s: setup failed (%ld)\n", edubfm_ut_policyName[trace->policy], (long)e);
+            nFailed++;
+            continue;
+        }
+
+        /* the clock hand is not reset by a discard */
+        BI_NEXTVICTIM(type) = 0;
+
+        for (i = 0; i < trace->nAccesses; i++)
+        {
+            e = edubfm_ut_access(type, trace->page[i], &victim);
+            if (e < 0 || victim != trace->victim[i]) break;
+        }
+
+        if (i == trace->nAccesses)
+            printf("policy %s: ok\n", edubfm_ut_policyName[trace->policy]);
+        else
+        {
+            if (e < 0)
+                printf("policy %s: access %ld of train %ld failed (%ld)\n",
+                       edubfm_ut_policyName[trace->policy], (long)i + 1, (long)trace->page[i], (long)e);
+            else
+                printf("policy %s: access %ld of train %ld replaced %ld, expected %ld\n",
+                       edubfm_ut_policyName[trace->policy], (long)i + 1, (long)trace->page[i],
+                       (long)victim, (long)trace->victim[i]);
+            nFailed++;
+        }
+    }
+
+    return(nFailed);
+
+} /* edubfm_ut_policies() */
+
+
+/*@================================
+ * edubfm_ut_resize()
+ *================================*/
+/*
+ * Function: static Four edubfm_ut_resize(void)
+ *
+ * Description:
+ *  Shrink a buffer pool of 8 buffers to 4 while a train is fixed, first
+ *  in a buffer to be drained, which must fail and keep the size and the
+ *  fixed trains, then in a buffer which is kept. Grow the buffer pool again
+ *  and check that the fixed train and the modified trains forced out by
+ *  the shrink are intact.
+ *
+ * Returns:
+ *  # of failed tests (0 or 1)
+ */
+static Four edubfm_ut_resize(void)
+{
+    Four		e;			/* error */
+    Four		type;			/* buffer type of the test */
+    Four		i;
+    Four		high, low;		/* trains fixed above and below the new size */
+    char		*buf;
+    char		*lowBuf;		/* buffer of the train 'low' */
+
+
+    type = EduBfM_CreatePool("ut_resize", 1, 8, BFM_POLICY_LRUK);
+    if (type < 0)
+    {
+        printf("resize: EduBfM_CreatePool() failed (%ld)\n", (long)type);
+        return(1);
+    }
+
+    /* fill the buffer pool with modified trains, each marked by its number */
+    high = low = NIL;
+    for (i = 1; i <= 8; i++)
+    {
+        e = EduBfM_GetTrain((TrainID *)&edubfm_ut_pages[i], &buf, type);
+        if (e < 0)
+        {
+            printf("resize: EduBfM_GetTrain() failed (%ld)\n", (long)e);
+            return(1);
+        }
+        ((Page *)buf)->data[0] = (char)i;
+        EduBfM_SetDirty((TrainID *)&edubfm_ut_pages[i], type);
+
+        if (edubfm_ut_index(type, i) == 6) high = i;
+        else if (edubfm_ut_index(type, i) == 1) low = i;
+        else EduBfM_FreeTrain((TrainID *)&edubfm_ut_pages[i], type);
+    }
+
+    /* a fixed train above the new size makes the shrink fail */
+    e = EduBfM_ResizeBuffers(type, 4);
+    if (e != eFIXEDBUFFER_EDUBFM || BI_NBUFS(type) != 8)
+    {
+        printf("resize: shrink over a fixed train returned %ld with %ld buffers\n", (long)e, (long)BI_NBUFS(type));
+        return(1);
+    }
+    if (edubfm_ut_index(type, high) != 6 || edubfm_ut_index(type, low) != 1)
+    {
+        printf("resize: the failed shrink moved a fixed train\n");
+        return(1);
+    }
+
+    /* a fixed train below the new size stays where it is */
+    EduBfM_FreeTrain((TrainID *)&edubfm_ut_pages[high], type);
+    e = EduBfM_GetTrain((TrainID *)&edubfm_ut_pages[low], &lowBuf, type);
+    if (e >= 0) e = EduBfM_FreeTrain((TrainID *)&edubfm_ut_pages[low], type);
+    if (e >= 0) e = EduBfM_ResizeBuffers(type, 4);
+    if (e < 0 || BI_NBUFS(type) != 4 || edubfm_ut_index(type, low) != 1)
+    {
+        printf("resize: shrink returned %ld with %ld buffers\n", (long)e, (long)BI_NBUFS(type));
+        return(1);
+    }
+    for (i = 1; i <= 8; i++)
+    {
+        if (edubfm_ut_resident(type, i) && edubfm_ut_index(type, i) >= 4)
+        {
+            printf("resize: train %ld left above the new size\n", (long)i);
+            return(1);
+        }
+    }
+
+    e = EduBfM_ResizeBuffers(type, 8);
+    if (e < 0 || BI_NBUFS(type) != 8 || edubfm_ut_index(type, low) != 1 || ((Page *)lowBuf)->data[0] != (char)low)
+    {
+        printf("resize: grow returned %ld with %ld buffers\n", (long)e, (long)BI_NBUFS(type));
+        return(1);
+    }
+    e = EduBfM_FreeTrain((TrainID *)&edubfm_ut_pages[low], type);
+    if (e < 0)
+    {
+        printf("resize: EduBfM_FreeTrain() of the fixed train failed (%ld)\n", (long)e);
+        return(1);
+    }
+
+    /* the trains forced out were written, and all fit again */
+    for (i = 1; i <= 8; i++)
+    {
+        e = EduBfM_GetTrain((TrainID *)&edubfm_ut_pages[i], &buf, type);
+        if (e < 0 || ((Page *)buf)->data[0] != (char)i)
+        {
+            printf("resize: train %ld is not intact after the grow (%ld)\n", (long)i, (long)e);
+            return(1);
+        }
+    }
+    for (i = 1; i <= 8; i++)
+        EduBfM_FreeTrain((TrainID *)&edubfm_ut_pages[i], type);
+
+    printf("resize: ok\n");
+
+    return(0);
+
+} /* edubfm_ut_resize() */
+
+
+/*@================================
+ * edubfm_ut_compress()
+ *================================*/
+/*
+ * Function: static Four edubfm_ut_compress(void)
+ *
+ * Description:
+ *  Compress and decompress data of each kind and of sizes around the
+ *  boundaries of the format: shorter than a match, literal runs and
+ *  matches longer than 15 and 270 bytes, and a whole train. The data
+ *  must come back unchanged; random data must not fit in the 3/4 of its
+ *  size the compressed tier allows, and truncated data must be refused.
+ *
+ * Returns:
+ *  # of failed tests (0 or 1)
+ */
+static Four edubfm_ut_compress(void)
+{
+    static Four		sizes[] = { 1, 5, 9, 13, 20, 300, 1000, PAGESIZE };
+    Four		s, kind;
+    Four		n, size;
+    Four		cap;
+    char		src[PAGESIZE];
+    char		dst[PAGESIZE];
+    char		packed[PAGESIZE + PAGESIZE / 255 + 16];
+
+
+    for (kind = UT_ZEROS; kind <= UT_RANDOM; kind++)
+    {
+        for (s = 0; s < sizeof(sizes) / sizeof(Four); s++)
+        {
+            n = sizes[s];
+            edubfm_ut_fill(src, n, kind, (UFour)n);
+
+            /* room for the worst case: all literals */
+            size = edubfm_Compress(src, n, packed, n + n / 255 + 16);
+            if (size == 0 || edubfm_Decompress(packed, size, dst, n) < 0 || memcmp(src, dst, n) != 0)
+            {
+                printf("compress: round trip of %ld bytes of kind %ld failed\n", (long)n, (long)kind);
+                return(1);
+            }
+
+            if (size > 1 && edubfm_Decompress(packed, size - 1, dst, n) >= 0)
+            {
+                printf("compress: truncated data of %ld bytes of kind %ld accepted\n", (long)n, (long)kind);
+                return(1);
+            }
+
+            /* the tier keeps a train only if it shrinks by a quarter */
+            cap = n - n / 4;
+            if (n == PAGESIZE &&
+                (kind == UT_RANDOM) != (edubfm_Compress(src, n, packed, cap) == 0))
+            {
+                printf("compress: a train of kind %ld %s\n", (long)kind,
+                       kind == UT_RANDOM ? "fits in 3/4 of its size" : "does not shrink by a quarter");
+                return(1);
+            }
+        }
+    }
+
+    printf("compress: ok\n");
+
+    return(0);
+
+} /* edubfm_ut_compress() */
+
+
+
+/*@================================
+ * edubfm_ut_tier()
+ *================================*/
+/*
+ * Function: static Four edubfm_ut_tier(void)
+ *
+ * Description:
+ *  Replace a compressible and an incompressible train of a buffer pool of
+ *  2 buffers with a compressed tier. Only the compressible one must be
+ *  kept in the tier, and both must be read again unchanged, the first
+ *  from the tier and the second from the disk.
+ *
+ * Returns:
+ *  # of failed tests (0 or 1)
+ */
+static Four edubfm_ut_tier(void)
+{
+    Four		e;			/* error */
+    Four		type;			/* buffer type of the test */
+    Four		i;
+    char		*buf;
+    BfMStats		stats;
+    static char		expected[3][sizeof(((Page *)0)->data)];	/* data of trains 1 and 2 */
+
+
+    type = EduBfM_CreatePool("ut_tier", 1, 2, BFM_POLICY_CLOCK);
+    if (type >= 0) e = EduBfM_SetCompressedTier(type, 64 * PAGESIZE);
+    else e = type;
+    if (e < 0)
+    {
+        printf("tier: setup failed (%ld)\n", (long)e);
+        return(1);
+    }
+
+    edubfm_ut_fill(expected[1], sizeof(expected[1]), UT_KEYS, 1);
+    edubfm_ut_fill(expected[2], sizeof(expected[2]), UT_RANDOM, 2);
+
+    /* write trains 1 and 2 and make them clean */
+    for (i = 1; i <= 2; i++)
+    {
+        e = EduBfM_GetTrain((TrainID *)&edubfm_ut_pages[i], &buf, type);
+        if (e < 0) break;
+        memcpy(((Page *)buf)->data, expected[i], sizeof(expected[i]));
+        EduBfM_SetDirty((TrainID *)&edubfm_ut_pages[i], type);
+        EduBfM_FreeTrain((TrainID *)&edubfm_ut_pages[i], type);
+    }
+    if (e >= 0) e = EduBfM_FlushAll();
+    if (e >= 0) e = EduBfM_ResetStats(type);
+
+    /* replace them */
+    for (i = 3; i <= 4 && e >= 0; i++)
+    {
+        e = EduBfM_GetTrain((TrainID *)&edubfm_ut_pages[i], &buf, type);
+        if (e >= 0) e = EduBfM_FreeTrain((TrainID *)&edubfm_ut_pages[i], type);
+    }
+    if (e >= 0) e = EduBfM_GetStats(type, &stats);
+    if (e < 0 || edubfm_ut_resident(type, 1) || edubfm_ut_resident(type, 2) || stats.tierStores != 1)
+    {
+        printf("tier: %llu of the 2 replaced trains kept (%ld)\n", (unsigned long long)stats.tierStores, (long)e);
+        return(1);
+    }
+
+    for (i = 1; i <= 2; i++)
+    {
+        e = EduBfM_GetTrain((TrainID *)&edubfm_ut_pages[i], &buf, type);
+        if (e < 0 || memcmp(((Page *)buf)->data, expected[i], sizeof(expected[i])) != 0)
+        {
+            printf("tier: train %ld is not read again unchanged (%ld)\n", (long)i, (long)e);
+            return(1);
+        }
+        EduBfM_FreeTrain((TrainID *)&edubfm_ut_pages[i], type);
+    }
+
+    e = EduBfM_GetStats(type, &stats);
+    if (e < 0 || stats.tierHits != 1)
+    {
+        printf("tier: %llu trains read from the tier, expected 1\n", (unsigned long long)stats.tierHits);
+        return(1);
+    }
+
+    EduBfM_SetCompressedTier(type, 0);
+
+    printf("tier: ok\n");
+
+    return(0);
+
+} /* edubfm_ut_tier() */
+
+
+/*@================================
+ * edubfm_ut_residentSet()
+ *================================*/
+/*
+ * Function: static Four edubfm_ut_residentSet(void)
+ *
+ * Description:
+ *  Save the resident set of a buffer pool, discard the buffer pools and
+ *  load the set again. Exactly the saved trains must come back, with the
+ *  data written before the save. The file must be refused by another
+ *  buffer pool.
+ *
+ * Returns:
+ *  # of failed tests (0 or 1)
+ */
+static Four edubfm_ut_residentSet(void)
+{
+    Four		e;			/* error */
+    Four		type, other;		/* buffer types of the test */
+    Four		i;
+    char		*buf;
+    char		*fileName = "unittest.rs";
+
+
+    type = EduBfM_CreatePool("ut_warm", 1, 8, BFM_POLICY_CLOCK);
+    other = EduBfM_CreatePool("ut_warm2", 1, 8, BFM_POLICY_CLOCK);
+    if (type < 0 || other < 0)
+    {
+        printf("resident set: EduBfM_CreatePool() failed (%ld)\n", (long)MIN(type, other));
+        return(1);
+    }
+
+    /* trains 1 ~ 6 are resident, marked by their numbers on the disk */
+    e = eNOERROR;
+    for (i = 1; i <= 6 && e >= 0; i++)
+    {
+        e = EduBfM_GetTrain((TrainID *)&edubfm_ut_pages[i], &buf, type);
+        if (e < 0) break;
+        ((Page *)buf)->data[0] = (char)(0x40 + i);
+        EduBfM_SetDirty((TrainID *)&edubfm_ut_pages[i], type);
+        e = EduBfM_FreeTrain((TrainID *)&edubfm_ut_pages[i], type);
+    }
+    if (e >= 0) e = EduBfM_FlushAll();
+    if (e >= 0) e = EduBfM_SaveResidentSet(type, fileName);
+    if (e >= 0) e = EduBfM_DiscardAll();
+    if (e < 0)
+    {
+        printf("resident set: save failed (%ld)\n", (long)e);
+        return(1);
+    }
+
+    e = EduBfM_LoadResidentSet(other, fileName);
+    if (e != eBADFILEFORMAT_EDUBFM)
+    {
+        printf("resident set: another buffer pool loaded the set (%ld)\n", (long)e);
+        return(1);
+    }
+
+    /* EduBfM_FlushAll() waits for the loader thread */
+    e = EduBfM_LoadResidentSet(type, fileName);
+    if (e >= 0) e = EduBfM_FlushAll();
+    if (e < 0)
+    {
+        printf("resident set: load failed (%ld)\n", (long)e);
+        return(1);
+    }
+
+    for (i = 1; i < UT_NPAGES; i++)
+    {
+        if (edubfm_ut_resident(type, i) != (i <= 6))
+        {
+            printf("resident set: train %ld is %s after the load\n", (long)i,
+                   i <= 6 ? "not resident" : "resident");
+            return(1);
+        }
+    }
+
+    for (i = 1; i <= 6; i++)
+    {
+        e = EduBfM_GetTrain((TrainID *)&edubfm_ut_pages[i], &buf, type);
+        if (e < 0 || ((Page *)buf)->data[0] != (char)(0x40 + i))
+        {
+            printf("resident set: train %ld is not loaded unchanged (%ld)\n", (long)i, (long)e);
+            return(1);
+        }
+        EduBfM_FreeTrain((TrainID *)&edubfm_ut_pages[i], type);
+    }
+
+    remove(fileName);
+
+    printf("resident set: ok\n");
+
+    return(0);
+
+} /* edubfm_ut_residentSet() */
+
+
+/*@================================
+ * edubfm_ut_assignedPool()
+ *================================*/
+/*
+ * Function: static Four edubfm_ut_assignedPool(void)
+ *
+ * Description:
+ *  Assign a file to a buffer pool while its trains are in PAGE_BUF. A
+ *  train modified in PAGE_BUF must be taken out of it and read into the
+ *  assigned buffer pool with its latest data; a train fixed in PAGE_BUF
+ *  must not be read into the assigned buffer pool until it is freed.
+ *
+ * Returns:
+ *  # of failed tests (0 or 1)
+ */
+static Four edubfm_ut_assignedPool(void)
+{
+    Four		e;			/* error */
+    Four		type;			/* assigned buffer pool */
+    char		*buf;
+    PageID		fileId;			/* file of the trains */
+
+
+    type = EduBfM_CreatePool("ut_assigned", 1, 4, BFM_POLICY_CLOCK);
+    if (type < 0)
+    {
+        printf("assigned pool: EduBfM_CreatePool() failed (%ld)\n", (long)type);
+        return(1);
+    }
+
+    /* any id serves; the buffer manager only maps it to the buffer pool */
+    fileId = edubfm_ut_pages[1];
+
+    /* train 9 is modified in PAGE_BUF before the assignment */
+    e = EduBfM_GetTrain((TrainID *)&edubfm_ut_pages[9], &buf, PAGE_BUF);
+    if (e >= 0)
+    {
+        ((Page *)buf)->data[0] = 'A';
+        e = EduBfM_SetDirty((TrainID *)&edubfm_ut_pages[9], PAGE_BUF);
+        EduBfM_FreeTrain((TrainID *)&edubfm_ut_pages[9], PAGE_BUF);
+    }
+    if (e >= 0) e = EduBfM_AssignPool(&fileId, type);
+    if (e < 0 || EduBfM_PoolOf(&fileId, PAGE_BUF) != type)
+    {
+        printf("assigned pool: assignment failed (%ld)\n", (long)e);
+        return(1);
+    }
+
+    e = EduBfM_GetTrain((TrainID *)&edubfm_ut_pages[9], &buf, EduBfM_PoolOf(&fileId, PAGE_BUF));
+    if (e < 0 || ((Page *)buf)->data[0] != 'A')
+    {
+        printf("assigned pool: train 9 is not read with its latest data (%ld)\n", (long)e);
+        return(1);
+    }
+    EduBfM_FreeTrain((TrainID *)&edubfm_ut_pages[9], type);
+
+    if (edubfm_ut_resident(PAGE_BUF, 9) || !edubfm_ut_resident(type, 9))
+    {
+        printf("assigned pool: train 9 is not moved from PAGE_BUF to the assigned pool\n");
+        return(1);
+    }
+
+    /* train 10 is fixed in PAGE_BUF meanwhile */
+    e = EduBfM_GetTrain((TrainID *)&edubfm_ut_pages[10], &buf, PAGE_BUF);
+    if (e >= 0)
+    {
+        e = EduBfM_GetTrain((TrainID *)&edubfm_ut_pages[10], &buf, type);
+        EduBfM_FreeTrain((TrainID *)&edubfm_ut_pages[10], PAGE_BUF);
+    }
+    if (e != eFIXEDBUFFER_EDUBFM)
+    {
+        printf("assigned pool: train 10 fixed in PAGE_BUF is read into the assigned pool (%ld)\n", (long)e);
+        return(1);
+    }
+
+    e = EduBfM_GetTrain((TrainID *)&edubfm_ut_pages[10], &buf, type);
+    if (e >= 0) e = EduBfM_FreeTrain((TrainID *)&edubfm_ut_pages[10], type);
+    if (e < 0 || edubfm_ut_resident(PAGE_BUF, 10))
+    {
+        printf("assigned pool: train 10 is not moved once freed (%ld)\n", (long)e);
+        return(1);
+    }
+
+    e = EduBfM_AssignPool(&fileId, NIL);
+    if (e < 0 || EduBfM_PoolOf(&fileId, PAGE_BUF) != PAGE_BUF)
+    {
+        printf("assigned pool: the assignment is not dropped (%ld)\n", (long)e);
+        return(1);
+    }
+
+    printf("assigned pool: ok\n");
+
+    return(0);
+
+} /* edubfm_ut_assignedPool() */
+
+
+
+Four main(Four argc, char *argv[])
+{
+    Four		e;			/* for errors */
+    Four		i;
+    Four		handle;			/* system handle */
+    char		*devNames[1];		/* device name */
+    Four		volId;			/* volume identifier */
+    Four		numPages[1];		/* # of pages in the device */
+    Four		firstExtNo;		/* first extent of the segment of the tests */
+    PageID		nearPid;
+    XactID		xactId;			/* transaction identifier */
+    Four		nFailed = 0;		/* # of failed tests */
+
+
+    devNames[0] = "unittest.vol";
+    volId = 1001;
+    numPages[0] = 500;
+
+    e = LRDS_Init();
+    if (e < eNOERROR)
+    {
+        printf("LRDS_Init failed!!!\n");
+        exit(1);
+    }
+
+    e = LRDS_AllocHandle(&handle);
+    if (e >= eNOERROR) e = LRDS_FormatDataVolume(1, devNames, "unittest", volId, 16, numPages, 16);
+    if (e >= eNOERROR) e = LRDS_Mount(1, devNames, &volId);
+    if (e >= eNOERROR) e = LRDS_BeginTransaction(&xactId, X_RR_RR);
+    if (e < eNOERROR)
+    {
+        printf("Cannot set up the volume of the tests!!!\n");
+        LRDS_Final();
+        exit(1);
+    }
+
+    /* Allocate the pages of the tests and write the storage system's
+     * pages, which EduBfM_DiscardAll() of the tests throws away. */
+    e = RDsM_CreateSegment(volId, &firstExtNo);
+    if (e >= eNOERROR) e = RDsM_ExtNoToPageId(volId, firstExtNo, &nearPid);
+    for (i = 1; i < UT_NPAGES && e >= eNOERROR; i++)
+        e = RDsM_AllocTrains(volId, firstExtNo, &nearPid, 100, 1, PAGESIZE2, &edubfm_ut_pages[i]);
+    if (e >= eNOERROR) e = EduBfM_FlushAll();
+    if (e < eNOERROR)
+    {
+        printf("Cannot allocate the pages of the tests!!!\n");
+        LRDS_AbortTransaction(&xactId);
+        LRDS_Dismount(volId);
+        LRDS_Final();
+        exit(1);
+    }
+
+    nFailed += edubfm_ut_policies();
+    nFailed += edubfm_ut_resize();
+    nFailed += edubfm_ut_compress();
+    nFailed += edubfm_ut_tier();
+    nFailed += edubfm_ut_residentSet();
+    nFailed += edubfm_ut_assignedPool();
+
+    e = LRDS_CommitTransaction(&xactId);
+    if (e >= eNOERROR) e = LRDS_Dismount(volId);
+    if (e >= eNOERROR) e = LRDS_FreeHandle(handle);
+    if (e >= eNOERROR) e = LRDS_Final();
+    if (e < eNOERROR) printf("Cannot shut down the storage system!!!\n");
+
+    printf("%ld test(s) failed\n", (long)nFailed);
+
+    return(nFailed);
+
+} /* main() */
@@ -0,0 +1,72 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_ValidateTrain.c
+ *
+ * Description : 
+ *  Validate an optimistic read of a train.
+ *
+ * Exports:
+ *  Four EduBfM_ValidateTrain(Four, BfMOptimisticRead *)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_ValidateTrain()
+ *================================*/
+/*
+ * Function: EduBfM_ValidateTrain(Four, BfMOptimisticRead*)
+ *
+ * Description : 
+ *  Check whether the buffer returned by EduBfM_GetTrainOptimistic() has
+ *  kept the train unmodified until now, i.e. whether its version is still
+ *  the one taken at the start of the read. Only reads shared data.
+ *
+ * Returns:
+ *  TRUE if what was read is the train, FALSE if it must be read again, or
+ *  error code
+ *    eBADBUFFERTYPE_BFM - Invalid Buffer type
+ *    eBADPARAMETER_EDUBFM - Invalid read
+ */
+Four EduBfM_ValidateTrain(
+    Four                type,                   /* IN buffer type */
+    BfMOptimisticRead   *read)                  /* IN read to be validated */
+{
+    /*@ Check the validity of given parameters */
+    if(IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
+
+    if(read == NULL || read->index < 0 || read->index >= BFM_MAXNBUFS) ERR(eBADPARAMETER_EDUBFM);
+
+    /* the reads of the buffer may not be moved after the load of the version */
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    return((__atomic_load_n(&BI_VERSION(type, read->index), __ATOMIC_RELAXED) == read->version) ? TRUE : FALSE);
+
+}  /* EduBfM_ValidateTrain() */
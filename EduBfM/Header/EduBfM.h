@@ -26,6 +26,122 @@
 #define _EDUBFM_H_
 
 
+/*@
+ * Constant Definitions
+ */
+/* Buffer Replacement Policies */
+#define BFM_POLICY_CLOCK	0	/* second chance (default) */
+#define BFM_POLICY_LRUK		1	/* LRU-2 */
+#define BFM_POLICY_2Q		2	/* full version of 2Q */
+#define BFM_POLICY_ARC		3	/* adaptive replacement cache */
+#define BFM_POLICY_CLOCKPRO	4	/* CLOCK-Pro */
+#define NUM_BFM_POLICIES	5
+
+/* Placement of the Buffer Pool */
+#define BFM_POOL_HUGEPAGE		0x1	/* back the buffer pool by huge pages (default) */
+#define BFM_POOL_NUMA_INTERLEAVE	0x2	/* interleave the pages over the NUMA nodes */
+#define BFM_POOL_NUMA_PARTITION		0x4	/* bind a range of buffers to each NUMA node */
+
+/* Callers of the Buffer Manager, to which misses are attributed */
+#define BFM_CALLER_OTHER	0
+#define BFM_CALLER_OM		1	/* object manager */
+#define BFM_CALLER_BTM		2	/* B+ tree manager */
+#define BFM_CALLER_CATALOG	3	/* catalog access */
+#define NUM_BFM_CALLERS		4
+
+/* Access intents of EduBfM_GetTrainWithIntent() */
+#define BFM_INTENT_NORMAL	0
+#define BFM_INTENT_ONCE		1	/* read once by a scan; recycle a private ring of buffers */
+#define BFM_INTENT_KEEPHOT	2	/* keep in the buffer pool longer */
+#define NUM_BFM_INTENTS		3
+
+/* Priority classes of the trains for the replacement, see EduBfM_SetPriority() */
+#define BFM_PRIORITY_DATA	0	/* data page; the class of a train just read */
+#define BFM_PRIORITY_OVERFLOW	1	/* overflow page of a large object or a B+ tree */
+#define BFM_PRIORITY_LEAF	2	/* leaf page of a B+ tree */
+#define BFM_PRIORITY_INTERNAL	3	/* internal page of a B+ tree */
+#define BFM_PRIORITY_ROOT	4	/* root page of a B+ tree */
+#define NUM_BFM_PRIORITIES	5
+
+/* Buffer pools, see EduBfM_CreatePool(); PAGE_BUF and LOT_LEAF_BUF are built in */
+#define BFM_MAXPOOLS		8	/* max # of buffer pools including the built-in ones */
+#define BFM_MAXPOOLNAME		32	/* max length of a buffer pool name including the NUL */
+
+/* Operations recorded in a trace, see EduBfM_StartTrace() */
+#define BFM_TRACE_GET		0	/* fix of a train read from the disk if not resident */
+#define BFM_TRACE_FREE		1	/* unfix */
+#define BFM_TRACE_SETDIRTY	2	/* modification of a fixed train */
+#define BFM_TRACE_NEW		3	/* fix of a new train, never read from the disk */
+#define NUM_BFM_TRACEOPS	4
+
+#define BFM_TRACE_MAGIC		0x52546d42	/* "BmTR" */
+
+/* # of buckets of a histogram; bucket 0 counts 0, bucket i counts the
+ * values in [2^(i-1), 2^i), and the last bucket counts all larger values */
+#define BFM_HIST_BUCKETS	24
+
+
+/*@
+ * Type Definitions
+ */
+/* a histogram with power of 2 buckets */
+typedef struct {
+    UEight	count;				/* # of samples */
+    UEight	sum;				/* sum of the samples */
+    UEight	max;				/* largest sample */
+    UEight	bucket[BFM_HIST_BUCKETS];
+} BfMHistogram;
+
+/* a read of a train without fixing it (see EduBfM_GetTrainOptimistic()) */
+typedef struct {
+    Four	index;		/* buffer read; a hint for the next read of the train */
+    UFour	version;	/* version of the buffer when the read started */
+} BfMOptimisticRead;
+
+/* a direct reference to the buffer holding a train, kept by the caller in
+ * place of the hash table lookup (see EduBfM_GetTrainBySwip()) */
+typedef struct {
+    Four	index;		/* buffer holding the train, NIL if unknown */
+} BfMSwip;
+
+/* header of a trace file, followed by the records */
+typedef struct {
+    UFour	magic;		/* BFM_TRACE_MAGIC */
+    UFour	recordSize;	/* sizeof(BfMTraceRecord) */
+} BfMTraceHeader;
+
+/* a record of a trace file */
+typedef struct {
+    UEight	time;		/* microseconds since the trace was started */
+    Four	pageNo;		/* the train (its first page) */
+    Two		volNo;
+    One		op;		/* BFM_TRACE_XXX */
+    One		type;		/* buffer type */
+} BfMTraceRecord;
+
+/* statistics of a buffer pool; all fields are UEight */
+typedef struct {
+    UEight	hits;		/* # of fixes of resident trains */
+    UEight	misses;		/* # of fixes which read a train from the disk */
+    UEight	evictions;	/* # of trains forced out of the buffer pool */
+    UEight	cleanEvictions;	/* # of evicted trains which were clean */
+    UEight	dirtyEvictions;	/* # of evicted trains which had to be written first */
+    UEight	syncFlushes;	/* # of dirty victims written by a fixing thread */
+    UEight	bgFlushes;	/* # of dirty trains written by the background writer */
+    UEight	prefetches;	/* # of trains read ahead */
+    UEight	ringRecycles;	/* # of buffers reused from the ring of a scan */
+    UEight	optimisticFixes; /* # of optimistic reads which had to fix the train */
+    UEight	tierStores;	/* # of replaced trains kept in the compressed tier */
+    UEight	tierHits;	/* # of misses served by the compressed tier */
+    UEight	newTrains;	/* # of trains fixed as new pages, without a read */
+    UEight	droppedWrites;	/* # of dirty trains removed without being written */
+    UEight	missesByCaller[NUM_BFM_CALLERS];	/* misses by BFM_CALLER_XXX */
+    BfMHistogram sweep;		/* buffers passed by the clock hand per victim */
+    BfMHistogram readLatency;	/* microseconds per disk read */
+    BfMHistogram writeLatency;	/* microseconds per disk write */
+} BfMStats;
+
+
 /*@
  * Function Prototypes
  */
@@ -35,6 +151,32 @@ Four EduBfM_GetTrain(TrainID *, char **, Four);
 Four EduBfM_SetDirty(TrainID *, Four);
 Four EduBfM_DiscardAll(void);
 Four EduBfM_FlushAll(void);
+Four EduBfM_SetReplacementPolicy(Four, Four);
+Four EduBfM_GetStats(Four, BfMStats *);
+Four EduBfM_ResetStats(Four);
+Four EduBfM_StartBgWriter(Four, Four, Four);
+Four EduBfM_StopBgWriter(Four);
+Four EduBfM_SetReadAhead(Four, Four);
+Four EduBfM_SetPoolPlacement(Four, Four);
+Four EduBfM_SetCaller(Four);
+Four EduBfM_ResizeBuffers(Four, Four);
+Four EduBfM_GetTrainWithIntent(TrainID *, char **, Four, Four);
+Four EduBfM_GetTrainOptimistic(TrainID *, char **, Four, BfMOptimisticRead *);
+Four EduBfM_ValidateTrain(Four, BfMOptimisticRead *);
+Four EduBfM_GetTrainBySwip(TrainID *, BfMSwip *, char **, Four);
+Four EduBfM_FreeTrainBySwip(BfMSwip *, Four);
+Four EduBfM_SetCompressedTier(Four, Four);
+Four EduBfM_SaveResidentSet(Four, char *);
+Four EduBfM_LoadResidentSet(Four, char *);
+Four EduBfM_SetPriority(TrainID *, Four, Four);
+Four EduBfM_GetNewTrain(TrainID *, char **, Four);
+Four EduBfM_RemoveTrain(TrainID *, Four);
+Four EduBfM_CreatePool(char *, Four, Four, Four);
+Four EduBfM_FindPool(char *);
+Four EduBfM_AssignPool(PageID *, Four);
+Four EduBfM_PoolOf(PageID *, Four);
+Four EduBfM_StartTrace(char *);
+Four EduBfM_StopTrace(void);
 
 
 #endif /* _EDUBFM_H_ */
@@ -26,10 +26,14 @@
 #define _EDUBFM_INTERNAL_H_
 
 
+#include <pthread.h>
+#include "EduBfM.h"
+
 /*@
  * Constant Definitions
  */ 
-/* number of buffer types : number of buffer pools used */
+/* number of buffer types : number of buffer pools created by the storage system;
+ * the buffer pools created by EduBfM_CreatePool() follow them */
 #define NUM_BUF_TYPES 2
 
 /* Buffer Types */
@@ -42,7 +46,7 @@
  *  Four type       : buffer type
  * Returns: TRUE(1) if the buffer type is invalid, otherwise FALSE(0)
  */
-#define IS_BAD_BUFFERTYPE(type) (type < 0 || type >= NUM_BUF_TYPES)
+#define IS_BAD_BUFFERTYPE(type) (type < 0 || type >= BFM_NPOOLS())
 
 /* The structure of key type used at hashing in buffer manager */
 /* same as "typedef BfMHashKey PageID; */
@@ -89,13 +93,14 @@ typedef struct {
 typedef struct {
     BfMHashKey 	key;		/* identify a page */
     Two    	fixed;		/* fixed count */
-    One    	bits;		/* bit 1 : DIRTY, bit 2 : VALID, bit 3 : REFER, bit 4 : NEW */
+    One    	bits;		/* bit 1 : DIRTY, bit 2 : VALID, bit 3 : REFER, bit 4 : NEW, bit 5 : HOT */
     Two    	nextHashEntry;
 } BufferTable;
 
 #define DIRTY  0x01
 #define VALID  0x02
 #define REFER  0x04 // 0b(0000 0100)
+#define HOT    0x10 /* fixed with BFM_INTENT_KEEPHOT */
 #define ALL_0  0x00
 #define ALL_1  ((sizeof(One) == 1) ? (0xff) : (0xffff))
 
@@ -109,13 +114,21 @@ typedef struct {
     Two*       		 	hashTable;	/* hash table */
 } BufferInfo;
 
+/* Macro: BI_INFO(type)
+ * Description: return the information of a buffer pool
+ * Parameter:
+ *  Four type       : buffer type
+ * Returns: (BufferInfo *) information of the buffer pool
+ */
+#define BI_INFO(type)		     (bufPoolInfo[type])
+
 /* Macro: BI_BUFSIZE(type)
  * Description: return the size of a buffer element of a buffer pool (unit: # of pages)
  * Parameter:
  *  Four type       : buffer type
  * Returns: (Two) size of a buffer element
  */
-#define BI_BUFSIZE(type)	     (bufInfo[type].bufSize)
+#define BI_BUFSIZE(type)	     (BI_INFO(type)->bufSize)
 
 /* Macro: BI_NBUFS(type)
  * Description: return the number of buffer elements of a buffer pool
@@ -123,7 +136,16 @@ typedef struct {
  *  Four type       : buffer type
  * Returns: (Two) the number of buffer elements
 */
-#define BI_NBUFS(type)           (bufInfo[type].nBufs)
+#define BI_NBUFS(type)           (BI_INFO(type)->nBufs)
+
+/* Macro: BI_NBUFS_LOAD(type)
+ * Description: read the number of buffer elements without holding a stripe
+ *              latch; it is changed by a resize (see edubfm_Resize.c)
+ * Parameter:
+ *  Four type       : buffer type
+ * Returns: (Two) the number of buffer elements
+*/
+#define BI_NBUFS_LOAD(type)      __atomic_load_n(&BI_NBUFS(type), __ATOMIC_ACQUIRE)
 
 /* Macro: BI_NEXTVICTIM(type)
  * Description: return an array index of the next buffer element(next victim) to be visited to determine whether or not to replace the buffer element by the buffer replacement algorithm
@@ -131,7 +153,7 @@ typedef struct {
  *  Four type       : buffer type
  * Returns: (UTwo) an array index of the next victim
  */
-#define BI_NEXTVICTIM(type)	     (bufInfo[type].nextVictim)
+#define BI_NEXTVICTIM(type)	     (BI_INFO(type)->nextVictim)
 
 /* Macro: BI_KEY(type, idx)
  * Description: return the hash key of the page/train residing in the buffer element
@@ -140,7 +162,7 @@ typedef struct {
  *  Four idx        : array index of the buffer element
  * Returns: (BfMHashKey) hash key
  */
-#define BI_KEY(type, idx)	     (((BufferTable*)bufInfo[type].bufTable)[idx].key)
+#define BI_KEY(type, idx)	     (((BufferTable*)BI_INFO(type)->bufTable)[idx].key)
 
 /* Macro: BI_FIXED(type, idx)
  * Description: return the number of transactions fixing (accessing) the page/train residing in the buffer element
@@ -149,7 +171,7 @@ typedef struct {
  *  Four idx        : array index of the buffer element
  * Returns: (Two) number of transactions
  */
-#define BI_FIXED(type, idx)	     (((BufferTable*)bufInfo[type].bufTable)[idx].fixed)
+#define BI_FIXED(type, idx)	     (((BufferTable*)BI_INFO(type)->bufTable)[idx].fixed)
 
 /* Macro: BI_BITS(type, idx)
  * Description: return a set of bits indicating the state of the buffer element
@@ -158,7 +180,7 @@ typedef struct {
  *  Four idx        : array index of the buffer element
  * Returns: (One) set of bits
  */
-#define BI_BITS(type, idx)	     (((BufferTable*)bufInfo[type].bufTable)[idx].bits)
+#define BI_BITS(type, idx)	     (((BufferTable*)BI_INFO(type)->bufTable)[idx].bits)
 
 /* Macro: BI_NEXTHASHENTRY(type, idx)
  * Description: return the array index of the buffer element containing the next page/train having the identical hash key value
@@ -167,7 +189,7 @@ typedef struct {
  *  Four idx        : array index of the buffer element containing the current page/train
  * Returns: (Two) array index of the buffer element containing the next page/train
  */
-#define BI_NEXTHASHENTRY(type, idx)  (((BufferTable*)bufInfo[type].bufTable)[idx].nextHashEntry)
+#define BI_NEXTHASHENTRY(type, idx)  (((BufferTable*)BI_INFO(type)->bufTable)[idx].nextHashEntry)
 
 /* Macro: BI_BUFFERPOOL(type)
  * Description: return the buffer pool
@@ -175,7 +197,7 @@ typedef struct {
  *  Four type       : buffer type
  * Returns: (char *) pointer to the buffer pool
  */
-#define BI_BUFFERPOOL(type)	     (bufInfo[type].bufferPool)
+#define BI_BUFFERPOOL(type)	     (BI_INFO(type)->bufferPool)
 
 /* Macro: BI_BUFFER(type, idx)
  * Description: return the idx-th element of the buffer pool
@@ -192,7 +214,7 @@ typedef struct {
  *  Four type       : buffer type
  * Returns: (Two*) pointer to the hash table
  */
-#define BI_HASHTABLE(type)	     (bufInfo[type].hashTable)
+#define BI_HASHTABLE(type)	     (BI_INFO(type)->hashTable)
 
 /* Macro: BI_HASHTABLEENTRY(type,idx)
  * Description: return the idx-th element of the buffer table
@@ -230,17 +252,539 @@ typedef struct {
 
 extern BufferInfo bufInfo[];
 
+
+/*@
+ * Buffer Pool Definitions
+ */
+/* # of hash chains of the assignments of files and indexes to buffer pools */
+#define BFM_POOLMAPSIZE		64
+
+/* an assignment of a file or an index to a buffer pool (see EduBfM_AssignPool()) */
+typedef struct BfMPoolMapEntry {
+    PageID			physicalId;	/* PhysicalFileID or PhysicalIndexID */
+    Four			pool;		/* buffer type */
+    struct BfMPoolMapEntry*	next;		/* next entry of the hash chain */
+} BfMPoolMapEntry;
+
+/* information of the buffer pools indexed by buffer type; the first
+ * NUM_BUF_TYPES point into bufInfo[] */
+extern BufferInfo *bufPoolInfo[];
+
+/* # of buffer pools; only grows, and is published after a buffer pool is set up */
+extern Four edubfm_nPools;
+
+/* names of the buffer pools indexed by buffer type */
+extern char bufPoolName[][BFM_MAXPOOLNAME];
+
+/* serializes the creation of buffer pools with EduBfM_DiscardAll() */
+extern pthread_mutex_t edubfm_poolLatch;
+
+/* Macro: BFM_NPOOLS()
+ * Description: return the number of buffer pools
+ * Returns: (Four) number of buffer pools
+ */
+#define BFM_NPOOLS()		     (__atomic_load_n(&edubfm_nPools, __ATOMIC_ACQUIRE))
+
+
+/*@
+ * Latch Definitions
+ */
+/* number of latches partitioning the hash table of a buffer pool;
+ * the hash chain of a hash table entry is protected by exactly one stripe */
+#define NUM_HASH_STRIPES 64
+
+/* Macro: BFM_HASH(k,type)
+ * Description: return the hash value of the key given as a parameter
+ * Parameters:
+ *  BfMHashKey *k   : pointer to the key
+ *  Four type       : buffer type
+ * Returns: (Four) hash value
+ */
+#define BFM_HASH(k,type)	(((k)->volNo + (k)->pageNo) % HASHTABLESIZE(type))
+
+/* Macro: BFM_STRIPE(k,type)
+ * Description: return the stripe latching the hash chain of the key
+ * Parameters:
+ *  BfMHashKey *k   : pointer to the key
+ *  Four type       : buffer type
+ * Returns: (Four) index of the stripe
+ */
+#define BFM_STRIPE(k,type)	(BFM_HASH(k,type) % NUM_HASH_STRIPES)
+
+/* The structure of a per-frame latch.
+ * A buffer element is busy while its train is being read from or written to
+ * the disk; fixers of a busy buffer element wait until the I/O completes.
+ * A buffer element is held while the buffer manager itself has claimed or
+ * fixed it (see edubfm_HoldBuffer()), so that its fixed count is not
+ * mistaken for fixes of the callers. */
+typedef struct {
+    pthread_mutex_t	mutex;
+    pthread_cond_t	cond;
+    Boolean		busy;		/* TRUE while an I/O is in progress */
+    Four		holds;		/* # of holds of the buffer manager */
+} BufferLatch;
+
+/* type definition for latches of a buffer pool */
+typedef struct {
+    pthread_mutex_t	stripe[NUM_HASH_STRIPES];	/* latches on the hash chains */
+    BufferLatch*	frameLatch;			/* latches on the buffer elements */
+    UFour*		version;			/* versions of the buffer elements */
+} BufferLatchInfo;
+
+extern BufferLatchInfo bufLatch[];
+
+/* Macro: BI_FRAMELATCH(type, idx)
+ * Description: return the latch of the buffer element
+ * Parameters:
+ *  Four type       : buffer type
+ *  Four idx        : array index of the buffer element
+ * Returns: (BufferLatch *) pointer to the latch
+ */
+#define BI_FRAMELATCH(type, idx)     (&bufLatch[type].frameLatch[idx])
+
+/* Macro: BI_VERSION(type, idx)
+ * Description: return the version of the buffer element
+ * Parameters:
+ *  Four type       : buffer type
+ *  Four idx        : array index of the buffer element
+ * Returns: (UFour) version
+ */
+#define BI_VERSION(type, idx)        (bufLatch[type].version[idx])
+
+/* The version of a buffer element is odd while the buffer is given to another
+ * train, from the claim of the victim until the read completes, and grows by
+ * 2 whenever the train in the buffer is modified; an optimistic reader takes
+ * the version before reading the buffer and validates it afterwards.
+ */
+#define BI_VERSION_LOAD(type, idx)   __atomic_load_n(&BI_VERSION(type, idx), __ATOMIC_ACQUIRE)
+#define BI_VERSION_ADD(type, idx, n) __atomic_add_fetch(&BI_VERSION(type, idx), (n), __ATOMIC_SEQ_CST)
+
+/* The fixed count and the bits of a buffer element are shared by all threads
+ * fixing the buffer pool; they are only updated by the following atomic macros.
+ */
+#define BI_FIXED_LOAD(type, idx)     __atomic_load_n(&BI_FIXED(type, idx), __ATOMIC_ACQUIRE)
+#define BI_FIXED_INC(type, idx)      __atomic_add_fetch(&BI_FIXED(type, idx), 1, __ATOMIC_ACQ_REL)
+#define BI_FIXED_DEC(type, idx)      __atomic_sub_fetch(&BI_FIXED(type, idx), 1, __ATOMIC_ACQ_REL)
+#define BI_BITS_LOAD(type, idx)      __atomic_load_n(&BI_BITS(type, idx), __ATOMIC_ACQUIRE)
+#define BI_SET_BITS(type, idx, b)    __atomic_or_fetch(&BI_BITS(type, idx), (b), __ATOMIC_ACQ_REL)
+#define BI_FETCH_SET_BITS(type, idx, b) __atomic_fetch_or(&BI_BITS(type, idx), (b), __ATOMIC_ACQ_REL)
+#define BI_CLEAR_BITS(type, idx, b)  __atomic_and_fetch(&BI_BITS(type, idx), ~(b), __ATOMIC_ACQ_REL)
+
+
+/*@
+ * Replacement Policy Definitions
+ */
+/* The interface of a buffer replacement policy.
+ * 'victim' selects an unfixed buffer element for the train 'key' and claims
+ * it with edubfm_ClaimBuffer(); the other functions notify the policy of the
+ * events on buffer elements. The functions of a policy with 'latched' set
+ * are serialized by the latch of the buffer pool's policy.
+ */
+typedef struct {
+    char*	name;					/* name of the policy */
+    Boolean	latched;				/* serialize the calls? */
+    Four	(*init)(Four);				/* set up the state for a buffer pool */
+    void	(*final)(Four);				/* release the state */
+    void	(*hit)(Four, Four);			/* a resident train is fixed */
+    void	(*load)(Four, Four, BfMHashKey *);	/* a train has been read into a buffer */
+    Four	(*victim)(Four, BfMHashKey *);		/* claim a buffer for a new train */
+    void	(*evict)(Four, Four, BfMHashKey *);	/* a train has been forced out */
+    void	(*release)(Four, Four);			/* a buffer has become empty */
+} BfMReplacementPolicy;
+
+/* type definition for the replacement policy of a buffer pool */
+typedef struct {
+    BfMReplacementPolicy*	policy;		/* policy in use */
+    pthread_mutex_t		latch;		/* latch serializing a latched policy */
+    void*			state;		/* policy-specific state */
+} BufferPolicyInfo;
+
+extern BufferPolicyInfo bufPolicy[];
+
+/* type definition for the priority classes of the trains of a buffer pool
+ * A train chosen as a victim while it has lives left loses one and is
+ * treated as fixed again instead; its lives are restored whenever it is
+ * fixed. The arrays are indexed by the array index of the buffer element. */
+typedef struct {
+    One*		priority;	/* BFM_PRIORITY_XXX of the train */
+    One*		lives;		/* # of times the train may still escape the replacement */
+} BufferPriorityInfo;
+
+extern BufferPriorityInfo bufPriority[];
+
+/* Macro: BI_PRIORITY(type, idx) / BI_LIVES(type, idx)
+ * Description: return the priority class / the lives left of the train
+ *              in the buffer element
+ * Parameters:
+ *  Four type       : buffer type
+ *  Four idx        : array index of the buffer element
+ * Returns: (One) priority class / # of lives
+ */
+#define BI_PRIORITY(type, idx)	     (bufPriority[type].priority[idx])
+#define BI_LIVES(type, idx)	     (bufPriority[type].lives[idx])
+
+/* Macro: BI_POLICY(type)
+ * Description: return the replacement policy of a buffer pool
+ * Parameter:
+ *  Four type       : buffer type
+ * Returns: (BfMReplacementPolicy *) replacement policy
+ */
+#define BI_POLICY(type)		     (bufPolicy[type].policy)
+
+/* Macro: BI_POLICYSTATE(type)
+ * Description: return the state of the replacement policy of a buffer pool
+ * Parameter:
+ *  Four type       : buffer type
+ * Returns: (void *) policy-specific state
+ */
+#define BI_POLICYSTATE(type)	     (bufPolicy[type].state)
+
+extern BfMReplacementPolicy edubfm_clockPolicy;
+extern BfMReplacementPolicy edubfm_lrukPolicy;
+extern BfMReplacementPolicy edubfm_twoQPolicy;
+extern BfMReplacementPolicy edubfm_arcPolicy;
+extern BfMReplacementPolicy edubfm_clockProPolicy;
+
+/* replacement policies indexed by BFM_POLICY_XXX */
+extern BfMReplacementPolicy *edubfm_policies[];
+
+/* A list of buffer elements linked through the arrays 'next' and 'prev'
+ * of the policy state; the head is the most recently inserted element. */
+typedef struct {
+    Four	head;
+    Four	tail;
+    Four	size;
+} BfMFrameList;
+
+/* A bounded directory of the keys of evicted trains (ghost entries),
+ * each belonging to one of BFM_MAXGHOSTLISTS lists ordered by insertion. */
+#define BFM_MAXGHOSTLISTS 2
+
+typedef struct {
+    BfMHashKey	key;
+    Four	list;		/* list the entry belongs to, NIL if free */
+    Four	prev;		/* neighbors in the list */
+    Four	next;
+    Four	hashNext;	/* next entry in the hash chain */
+} BfMGhostEntry;
+
+typedef struct {
+    Four		capacity;	/* max # of entries */
+    BfMGhostEntry*	entry;
+    Four*		hashTable;	/* heads of the hash chains */
+    Four		freeEntry;	/* list of free entries chained by 'next' */
+    BfMFrameList	list[BFM_MAXGHOSTLISTS];
+} BfMGhostDir;
+
+/*@
+ * Background Writer Definitions
+ */
+/* type definition for the background writer of a buffer pool */
+typedef struct {
+    pthread_t		thread;
+    pthread_mutex_t	mutex;		/* protects the fields below */
+    pthread_cond_t	cond;		/* signaled to wake up or stop the writer */
+    Boolean		running;	/* is the writer thread alive? */
+    Boolean		stop;		/* has the writer been asked to stop? */
+    Boolean		wakeup;		/* has the writer been asked to sweep now? */
+    Four		cleanTarget;	/* # of clean unfixed buffers to keep ahead of the clock hand */
+    Four		interval;	/* sleep time between sweeps in milliseconds */
+} BufferWriterInfo;
+
+extern BufferWriterInfo bufWriter[];
+
+/* Macro: BI_BGWRITER_ACTIVE(type)
+ * Description: is the background writer of the buffer pool running?
+ * Parameter:
+ *  Four type       : buffer type
+ * Returns: (Boolean) TRUE if the writer is running
+ */
+#define BI_BGWRITER_ACTIVE(type)     __atomic_load_n(&bufWriter[type].running, __ATOMIC_ACQUIRE)
+
+/*@
+ * Read-Ahead Definitions
+ */
+#define BFM_MAXREADAHEAD	32	/* max # of trains read ahead at once */
+
+/* type definition for the sequential read detection of a buffer pool */
+typedef struct {
+    pthread_mutex_t	mutex;		/* protects the fields below */
+    Four		maxWindow;	/* max # of trains read ahead, 0 if disabled */
+    Four		window;		/* # of trains to read ahead next time */
+    Four		run;		/* # of sequential reads in a row */
+    BfMHashKey		lastMiss;	/* train read on demand last */
+    BfMHashKey		nextAhead;	/* first train past the last read-ahead window */
+} BufferReadAheadInfo;
+
+extern BufferReadAheadInfo bufReadAhead[];
+
+/*@
+ * Warm Restart Definitions
+ */
+#define BFM_RESIDENTSET_MAGIC	0x52666d42	/* "BfmR", the first word of a resident set file */
+
+/* A resident set file is a header followed by 'nEntries' entries, one for
+ * each train which was in the buffer pool when the file was saved. */
+typedef struct {
+    Four		magic;		/* BFM_RESIDENTSET_MAGIC */
+    Four		type;		/* buffer type */
+    Four		bufSize;	/* # of pages of a train */
+    Four		nEntries;	/* # of entries following */
+} BfMResidentSetHeader;
+
+/* Macro: BFM_HEAT(bits)
+ * Description: return how hot a train is from the bits of its buffer element;
+ *              a train fixed to be kept hot is hotter than a referenced one
+ */
+#define BFM_HEAT(bits)		((((bits) & HOT) ? 2 : 0) + (((bits) & REFER) ? 1 : 0))
+
+typedef struct {
+    BfMHashKey		key;		/* train */
+    Four		heat;		/* BFM_HEAT() of the train when saved */
+} BfMResidentEntry;
+
+/* a resident set to be read back into a buffer pool by a loader thread */
+typedef struct {
+    Four		type;		/* buffer type */
+    Four		nEntries;	/* # of entries */
+    BfMResidentEntry*	entry;		/* the entries follow the job */
+} BfMWarmLoadJob;
+
+/* type definition for the loader thread of a buffer pool */
+typedef struct {
+    pthread_t		thread;
+    Boolean		running;	/* has the thread been started and not joined yet? */
+    Boolean		cancel;		/* has the loader been asked to give up? */
+} BufferWarmLoadInfo;
+
+/*@
+ * Resize Definitions
+ */
+/* max # of buffers of a buffer pool, so that the index of a hash table
+ * entry, up to 3 * nBufs - 1, fits in Two */
+#define BFM_MAXNBUFS		10922
+
+/* type definition for the resizing of a buffer pool
+ * The buffer table and the frame latches have room for 'tableCapacity'
+ * buffers and the buffer pool for 'poolCapacity' buffers, so that a buffer
+ * pool grows without moving the buffers fixed. The buffers from nBufs up
+ * to 'highWater' have been given up by a shrink and stay claimed. */
+typedef struct {
+    pthread_mutex_t	mutex;		/* serializes the resizes and the moves of the buffer pool */
+    Four		tableCapacity;	/* # of entries of the buffer table and the frame latches */
+    Four		poolCapacity;	/* # of buffers the buffer pool has room for */
+    Four		highWater;	/* # of buffer table entries set up */
+    Four		placement;	/* BFM_POOL_XXX flags of the buffer pool */
+    Boolean		optimistic;	/* has a train been read optimistically? */
+    void*		retired;	/* buffer pools moved away from, kept for the optimistic readers */
+} BufferResizeInfo;
+
+extern BufferResizeInfo bufResize[];
+
+/*@
+ * Dirty List Definitions
+ */
+/* type definition for the dirty list of a buffer pool
+ * The buffer elements whose trains have been modified since they were last
+ * written, linked through 'next' and 'prev' in the order they became dirty;
+ * the head is the most recently dirtied. A linked buffer element may have
+ * been written meanwhile, so the dirty bit is checked before use. */
+typedef struct {
+    pthread_mutex_t	mutex;		/* protects the fields below */
+    BfMFrameList	list;
+    Four*		next;		/* links toward the oldest, indexed by buffer */
+    Four*		prev;		/* links toward the newest */
+    Boolean*		linked;		/* is the buffer element in the list? */
+} BufferDirtyInfo;
+
+extern BufferDirtyInfo bufDirty[];
+
+/*@
+ * Buffer Ring Definitions
+ */
+#define BFM_MAXRINGSIZE		16	/* max # of buffers of a ring */
+
+/* type definition for the ring of buffers recycled by the scans of a thread */
+typedef struct {
+    Four	frame[BFM_MAXRINGSIZE];	/* buffers read into by the scans */
+    Four	nFrames;		/* # of buffers in the ring */
+    Four	next;			/* buffer to be recycled next */
+} BfMRing;
+
+/*@
+ * Compressed Tier Definitions
+ */
+#define BFM_TIERHASHSIZE	1024	/* # of hash chains of a compressed tier */
+
+/* a train kept compressed in the tier; the compressed data follows the entry */
+typedef struct BfMTierEntry {
+    BfMHashKey			key;		/* train */
+    Four			size;		/* size of the compressed data */
+    struct BfMTierEntry*	nextHash;	/* next entry of the hash chain */
+    struct BfMTierEntry*	newer;		/* entries in the order of insertion */
+    struct BfMTierEntry*	older;
+} BfMTierEntry;
+
+/* Macro: TIER_DATA(entry)
+ * Description: return the compressed data of a tier entry
+ */
+#define TIER_DATA(entry)	((char *)((entry) + 1))
+
+/* type definition for the compressed tier of a buffer pool
+ * Clean trains replaced in the buffer pool are kept compressed, up to
+ * 'maxBytes' bytes, the oldest being dropped first. A train is either in
+ * the buffer pool or in the tier, never in both. */
+typedef struct {
+    pthread_mutex_t	mutex;		/* protects the fields below */
+    Four		maxBytes;	/* capacity in bytes, 0 if disabled */
+    Four		usedBytes;	/* bytes of the entries */
+    BfMTierEntry*	chain[BFM_TIERHASHSIZE];
+    BfMTierEntry*	newest;
+    BfMTierEntry*	oldest;
+} BufferTierInfo;
+
+extern BufferTierInfo bufTier[];
+
+/* Macro: BI_TIER_ACTIVE(type)
+ * Description: is the compressed tier of the buffer pool enabled?
+ * Parameter:
+ *  Four type       : buffer type
+ * Returns: (Boolean) TRUE if the tier is enabled
+ */
+#define BI_TIER_ACTIVE(type)	     (__atomic_load_n(&bufTier[type].maxBytes, __ATOMIC_RELAXED) > 0)
+
+/* statistics of the buffer pools */
+extern BfMStats bufStats[];
+
+/* Macro: BFM_STAT_INC(type, field)
+ * Description: increment a statistics counter of a buffer pool
+ * Parameters:
+ *  Four type       : buffer type
+ *  field           : name of the counter in BfMStats
+ */
+#define BFM_STAT_INC(type, field)    __atomic_add_fetch(&bufStats[type].field, 1, __ATOMIC_RELAXED)
+
+/*@
+ * Trace Definitions
+ */
+#define BFM_TRACEBUFSIZE	4096	/* # of records written to the trace file at once */
+
+/* type definition for the trace recorder (see EduBfM_StartTrace()) */
+typedef struct {
+    pthread_mutex_t	mutex;		/* protects the fields below */
+    Boolean		active;		/* is a trace being recorded? */
+    Boolean		failed;		/* has a write of the trace file failed? */
+    FILE*		fp;		/* trace file */
+    UEight		start;		/* time the trace was started */
+    Four		nRecords;	/* # of records in 'record' */
+    BfMTraceRecord	record[BFM_TRACEBUFSIZE];
+} BufferTraceInfo;
+
+extern BufferTraceInfo bufTrace;
+
+/* Macro: BFM_TRACE(op, key, type)
+ * Description: record an operation on a train if a trace is being recorded
+ * Parameters:
+ *  Four op         : BFM_TRACE_XXX
+ *  BfMHashKey *key : the train
+ *  Four type       : buffer type
+ */
+#define BFM_TRACE(op, key, type) \
+    if (__atomic_load_n(&bufTrace.active, __ATOMIC_RELAXED)) edubfm_TraceRecord(op, key, type)
+
+/* caller of the buffer manager in this thread (BFM_CALLER_XXX) */
+extern __thread Four edubfm_caller;
+
 /*@
  * Function Prototypes
  */
 /* internal function prototypes */
-Four edubfm_AllocTrain(Four);
+Four edubfm_AllocTrain(BfMHashKey *, Four, Four);
 Four edubfm_Delete(BfMHashKey *, Four);
 Four edubfm_DeleteAll(void);
 Four edubfm_FlushTrain(TrainID *, Four);
-Four edubfm_Insert(BfMHashKey *, Two, Four); 
+Four edubfm_FlushBuffer(Four, Four);
+Four edubfm_FlushTrains(Four);
+Four edubfm_Insert(BfMHashKey *, Four, Four);
 Four edubfm_LookUp(BfMHashKey *, Four);
 Four edubfm_ReadTrain(TrainID *, char *, Four);
+Four edubfm_Init(void);
+Four edubfm_SetUpPool(Four);
+Four edubfm_SetUpPoolLatches(Four);
+Four edubfm_SetUpPoolMemory(Four);
+Four edubfm_SetUpPoolPolicy(Four);
+Four edubfm_SetUpPoolDirtyList(Four);
+Four edubfm_AllocPool(Four, Four, Four);
+void edubfm_FreePool(Four);
+Four edubfm_PoolMapSet(PageID *, Four);
+Four edubfm_PoolMapGet(PageID *);
+Four edubfm_EvictFromOtherPools(BfMHashKey *, Four, Boolean);
+Four edubfm_InitLatches(void);
+Four edubfm_InitFrameLatch(Four, Four);
+void edubfm_LatchKey(BfMHashKey *, Four);
+void edubfm_UnlatchKey(BfMHashKey *, Four);
+void edubfm_LatchAllStripes(Four);
+void edubfm_UnlatchAllStripes(Four);
+void edubfm_LatchIO(void);
+void edubfm_UnlatchIO(void);
+void edubfm_HoldBuffer(Four, Four);
+void edubfm_UnholdBuffer(Four, Four);
+Boolean edubfm_WaitHeldBuffer(Four, Four, BfMHashKey *);
+Boolean edubfm_ClaimBuffer(Four, Four);
+void edubfm_UnclaimBuffer(Four, Four);
+void edubfm_ReleaseBuffer(Four, Four);
+Boolean edubfm_FenceBuffer(Four, Four);
+void edubfm_UnfenceBuffer(Four, Four);
+Four edubfm_AdvanceClockHand(Four);
+void edubfm_BeginFrameIO(Four, Four);
+void edubfm_EndFrameIO(Four, Four);
+void edubfm_WaitFrameIO(Four, Four);
+Four edubfm_InitPolicies(void);
+Four edubfm_InitBufferPools(void);
+Four edubfm_RemapBufferPool(Four, Four, Four);
+Four edubfm_ResizeBufferPool(Four, Four);
+Four edubfm_ResetPolicy(Four);
+Four edubfm_PolicyVictim(Four, BfMHashKey *);
+void edubfm_PolicyHit(Four, Four);
+void edubfm_PolicyLoad(Four, Four, BfMHashKey *);
+void edubfm_PolicyEvict(Four, Four, BfMHashKey *);
+void edubfm_PolicyRelease(Four, Four);
+void edubfm_PolicySetPriority(Four, Four, Four);
+void edubfm_ListInit(BfMFrameList *);
+void edubfm_ListPushHead(BfMFrameList *, Four *, Four *, Four);
+void edubfm_ListRemove(BfMFrameList *, Four *, Four *, Four);
+Four edubfm_GhostInit(BfMGhostDir *, Four);
+void edubfm_GhostFinal(BfMGhostDir *);
+Four edubfm_GhostFind(BfMGhostDir *, BfMHashKey *);
+void edubfm_GhostInsert(BfMGhostDir *, BfMHashKey *, Four);
+void edubfm_GhostRemove(BfMGhostDir *, Four);
+void edubfm_GhostRemoveOldest(BfMGhostDir *, Four);
+void *edubfm_BgWriterMain(void *);
+void edubfm_WakeBgWriter(Four);
+void edubfm_ReadAhead(BfMHashKey *, Four);
+void edubfm_PrefetchTrains(Four, BfMHashKey *, Four);
+void *edubfm_WarmLoadMain(void *);
+void edubfm_StartWarmLoad(BfMWarmLoadJob *);
+void edubfm_StopWarmLoad(Four, Boolean);
+Four edubfm_Compress(char *, Four, char *, Four);
+Four edubfm_Decompress(char *, Four, char *, Four);
+BfMTierEntry *edubfm_TierPack(Four, Four);
+void edubfm_TierPut(Four, BfMTierEntry *);
+Boolean edubfm_TierGet(Four, BfMHashKey *, char *);
+void edubfm_TierRemove(Four, BfMHashKey *);
+void edubfm_TierResize(Four, Four);
+void edubfm_TierClear(Four);
+Four edubfm_InitDirtyLists(void);
+void edubfm_DirtyLink(Four, Four);
+void edubfm_DirtyUnlink(Four, Four);
+void edubfm_DirtyClear(Four);
+Four edubfm_DirtyFrames(Four, Four *, Four);
+Four edubfm_RingVictim(Four);
+void edubfm_RingAdd(Four, Four);
+UEight edubfm_Now(void);
+void edubfm_TraceRecord(Four, BfMHashKey *, Four);
+Four edubfm_TraceFlush(void);
+void edubfm_HistAdd(BfMHistogram *, UEight);
 
 
 #endif /* _EDUBFM_INTERNAL_H_ */
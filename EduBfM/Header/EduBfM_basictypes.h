@@ -42,6 +42,10 @@ typedef unsigned short          UTwo;
 typedef int                     Four;
 typedef unsigned int            UFour;
 
+/* eight bytes data type */
+typedef long                    Eight;
+typedef unsigned long           UEight;
+
 /* invarialbe size data type */       
 typedef char                    One_Invariable;
 typedef unsigned char           UOne_Invariable;
@@ -49,6 +53,8 @@ typedef Two                     Two_Invariable;
 typedef UTwo                    UTwo_Invariable;
 typedef Four                    Four_Invariable;
 typedef UFour                   UFour_Invariable;
+typedef Eight                   Eight_Invariable;
+typedef UEight                  UEight_Invariable;
 
 /* Boolean Type */
 typedef enum { FALSE, TRUE } Boolean;
@@ -97,4 +97,13 @@ typedef PageID TrainID;		/* use its first page's PageID as the TrainID */
 #define eNOERROR 0
 
 
+/*
+ * Macro Definitions
+ */
+#undef MIN
+#define MIN(a,b) (((a) < (b)) ? (a):(b))
+#undef MAX
+#define MAX(a,b) (((a) >= (b)) ? (a):(b))
+
+
 #endif /* _EDUBFM_COMMON_H_ */
@@ -97,3 +97,12 @@
 #define eNOMORELOCKCONTROLBLOCKS_BFM             ERR_ENCODE_ERROR_CODE(BFM_ERR_BASE,59)
 #define NUM_ERRORS_BFM_ERR_BASE                  60
 #define eNOTSUPPORTED_EDUBFM		             ERR_ENCODE_ERROR_CODE(BFM_ERR_BASE,61)
+#define eMEMORYALLOCERR_EDUBFM		             ERR_ENCODE_ERROR_CODE(BFM_ERR_BASE,62)
+#define eBADPOLICY_EDUBFM		             ERR_ENCODE_ERROR_CODE(BFM_ERR_BASE,63)
+#define eTHREADCREATEFAILED_EDUBFM	             ERR_ENCODE_ERROR_CODE(BFM_ERR_BASE,64)
+#define eBADPARAMETER_EDUBFM		             ERR_ENCODE_ERROR_CODE(BFM_ERR_BASE,65)
+#define eFIXEDBUFFER_EDUBFM		             ERR_ENCODE_ERROR_CODE(BFM_ERR_BASE,66)
+#define eFILEIOERR_EDUBFM		             ERR_ENCODE_ERROR_CODE(BFM_ERR_BASE,67)
+#define eBADFILEFORMAT_EDUBFM		             ERR_ENCODE_ERROR_CODE(BFM_ERR_BASE,68)
+#define eTOOMANYPOOLS_EDUBFM		             ERR_ENCODE_ERROR_CODE(BFM_ERR_BASE,69)
+#define eDUPLICATEPOOL_EDUBFM		             ERR_ENCODE_ERROR_CODE(BFM_ERR_BASE,70)
@@ -28,6 +28,8 @@
 
 Four	RDsM_ReadTrain(PageID *, char *, Two);
 Four	RDsM_WriteTrain(char *, PageID *, Two);
+Four	RDsM_ReadTrains(PageID *, char *, Four, Two);
+Four	RDsM_WriteTrains(char *, PageID *, Four, Two);
 
 
 #endif /* _RDsM_H_ */
@@ -29,11 +29,12 @@
  *  Allocate a new buffer from the buffer pool.
  *
  * Exports:
- *  Four edubfm_AllocTrain(Four)
+ *  Four edubfm_AllocTrain(BfMHashKey *, Four, Four)
  */
 
 
 #include <errno.h>
+#include <stdlib.h> /* for free */
 #include "EduBfM_common.h"
 #include "EduBfM_Internal.h"
 
@@ -44,7 +45,7 @@ extern CfgParams_T sm_cfgParams;
  * edubfm_AllocTrain()
  *================================*/
 /*
- * Function: Four edubfm_AllocTrain(Four)
+ * Function: Four edubfm_AllocTrain(BfMHashKey *, Four, Four)
  *
  * Description : 
  * (Following description is for original ODYSSEUS/COSMOS BfM.
@@ -52,15 +53,20 @@ extern CfgParams_T sm_cfgParams;
  *
  *  Allocate a new buffer from the buffer pool.
  *  The used buffer pool is specified by the parameter 'type'.
- *  This routine uses the second chance buffer replacement algorithm
- *  to select a victim.  That is, if the reference bit of current checking
- *  entry (indicated by BI_NEXTVICTIM(type), macro for
- *  bufInfo[type].nextVictim) is set, then simply clear
- *  the bit for the second chance and proceed to the next entry, otherwise
- *  the current buffer indicated by BI_NEXTVICTIM(type) is selected to be
- *  returned.
+ *  The victim is selected by the replacement policy of the buffer pool
+ *  (the second chance algorithm by default, see edubfm_PolicyClock.c);
+ *  'newKey' is the train to be read into the buffer, which some policies
+ *  use to decide the victim. For a train read once by a scan
+ *  (BFM_INTENT_ONCE), a buffer of the calling thread's ring is recycled
+ *  if possible (see edubfm_Ring.c).
  *  Before return the buffer, if the dirty bit of the victim is set, it 
  *  must be force out to the disk.
+ *  A clean victim is kept compressed in the tier of the buffer pool, if
+ *  enabled (see edubfm_Tier.c), unless it is recycled from a ring.
+ *  The victim is returned claimed, i.e. with fixed count 1, and deleted
+ *  from the hash table, so that no other thread can take or fix it; its
+ *  version is odd until the caller reads the new train into it. The claim
+ *  is no longer counted as a hold (see edubfm_HoldBuffer()).
  *
  * Returns;
  *  1) An index of a new buffer from the buffer pool
@@ -69,62 +75,101 @@ extern CfgParams_T sm_cfgParams;
  *     some errors caused by fuction calls
  */
 Four edubfm_AllocTrain(
-    Four 	type)			/* IN type of buffer (PAGE or TRAIN) */
+    BfMHashKey	*newKey,		/* IN train to be read into the buffer */
+    Four 	type,			/* IN type of buffer (PAGE or TRAIN) */
+    Four	intent)			/* IN access intent (BFM_INTENT_XXX) */
 {
     Four 	e;			/* for error */
     Four 	victim;			/* return value */
-    Four 	i;
-    Four    fixCount = 0;
+    Boolean	recycled;		/* is the victim from the ring? */
+    BfMHashKey  key;        /* key of the train held by the victim */
+    Boolean     dirty;      /* was the victim written before the replacement? */
+    BfMTierEntry *packed;   /* the train of the victim compressed for the tier */
 
-    
 
 	/* Error check whether using not supported functionality by EduBfM */
 	if(sm_cfgParams.useBulkFlush) ERR(eNOTSUPPORTED_EDUBFM);
 
-    /* Second chance algorithm for selecting victim buffer element */
-    i = BI_NEXTVICTIM(type); 
     while (1)
     {
-        if (BI_FIXED(type, i) == 0)
+        /* The ring and the policy return the victim claimed. */
+        victim = (intent == BFM_INTENT_ONCE) ? edubfm_RingVictim(type) : NIL;
+        recycled = (victim != NIL);
+        if (!recycled)
         {
-            if (BI_BITS(type, i) & REFER) // Check Refer bit is 1
-            {
-                BI_BITS(type, i) = (BI_BITS(type, i) & (~REFER));
-            }
-            else // If Refer bit is 0 
+            victim = edubfm_PolicyVictim(type, newKey);
+            if (victim < 0) ERR(victim);
+        }
+
+        key = BI_KEY(type, victim);
+        dirty = FALSE;
+
+        /* The victim stays in the hash table while it is forced out, so that
+         * nobody can read the stale train from the disk in the meantime. */
+        if (BI_BITS_LOAD(type, victim) & DIRTY) 
+        {
+            e = edubfm_FlushBuffer(type, victim);
+            if (e < 0)
             {
-                break;
+                edubfm_UnclaimBuffer(type, victim);
+                ERR (e);
             }
+            BFM_STAT_INC(type, syncFlushes);
+            dirty = TRUE;
+        }
+
+        /* Do not delete hash entry of discarded buffer element which pageNo is NIL */
+        if (key.pageNo == NIL)
+        {
+            /* optimistic readers and fixers through swips fail from now on */
+            BI_VERSION_ADD(type, victim, 1);
+            break;
         }
-        else 
+
+        /* The clean train is compressed for the tier before it is taken. */
+        packed = (!recycled && BI_TIER_ACTIVE(type)) ? edubfm_TierPack(type, victim) : NULL;
+
+        /* Somebody may have fixed the train during the flush; choose another victim. */
+        edubfm_LatchKey(&key, type);
+        if (edubfm_FenceBuffer(type, victim))
         {
-            fixCount += 1;
-            if (fixCount == BI_NBUFS(type))
+            if (!(BI_BITS_LOAD(type, victim) & DIRTY) && EQUALKEY(&key, &BI_KEY(type, victim)))
             {
-                ERR (eNOUNFIXEDBUF_BFM);
+                e = edubfm_Delete(&key, type);
+                if (e >= 0 && packed != NULL) edubfm_TierPut(type, packed);
+                edubfm_UnlatchKey(&key, type);
+                if (e < 0)
+                {
+                    free(packed);
+                    edubfm_UnfenceBuffer(type, victim);
+                    edubfm_UnclaimBuffer(type, victim);
+                    ERR (e);
+                }
+                break;
             }
+            edubfm_UnfenceBuffer(type, victim);
         }
+        edubfm_UnlatchKey(&key, type);
+        free(packed);
 
-        i = (i + 1) % BI_NBUFS(type);
+        edubfm_UnclaimBuffer(type, victim);
     }
 
-    victim = i;
-    if (BI_BITS(type, victim) & DIRTY) 
-    {
-        e = edubfm_FlushTrain((TrainID*)&BI_KEY(type, victim), type);
-        if (e < 0) ERR (e);
-    }
+    if (intent == BFM_INTENT_ONCE) edubfm_RingAdd(type, victim);
+    if (recycled) BFM_STAT_INC(type, ringRecycles);
 
-    BI_BITS(type, victim) = ALL_0;
-    BI_NEXTVICTIM(type) = ((victim + 1) % BI_NBUFS(type));
-
-    /* Do not delete hash entry of discarded buffer element which pageNo is NIL */
-    if (BI_KEY(type, victim).pageNo != NIL)
+    edubfm_PolicyEvict(type, victim, &key);
+    if (key.pageNo != NIL)
     {
-        e = edubfm_Delete(&BI_KEY(type, victim), type);
-        if (e < 0) ERR (e);
+        BFM_STAT_INC(type, evictions);
+        if (dirty) BFM_STAT_INC(type, dirtyEvictions);
+        else BFM_STAT_INC(type, cleanEvictions);
     }
 
+    __atomic_store_n(&BI_BITS(type, victim), ALL_0, __ATOMIC_RELEASE);
+
+    /* the victim is out of the hash table; its claim is the caller's now */
+    edubfm_UnholdBuffer(type, victim);
 
     return( victim );
     
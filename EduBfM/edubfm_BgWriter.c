@@ -0,0 +1,235 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_BgWriter.c
+ *
+ * Description:
+ *  The background writer of a buffer pool. It walks the dirty list of the
+ *  buffer pool, the oldest dirty train first, and forces out the unfixed
+ *  dirty trains until enough buffers are clean, so that a fixing thread
+ *  rarely has to write a dirty victim itself.
+ *
+ * Exports:
+ *  BufferWriterInfo bufWriter[]
+ *  void *edubfm_BgWriterMain(void *)
+ *  void edubfm_WakeBgWriter(Four)
+ */
+
+
+#include <stdlib.h> /* for malloc & free */
+#include <time.h>
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+/*@
+ * global variables
+ */
+/* background writers of the buffer pools */
+BufferWriterInfo bufWriter[BFM_MAXPOOLS] = {
+    [0 ... BFM_MAXPOOLS-1] = { .mutex = PTHREAD_MUTEX_INITIALIZER, .cond = PTHREAD_COND_INITIALIZER }
+};
+
+
+
+/*@================================
+ * edubfm_BgWriterSweep()
+ *================================*/
+/*
+ * Function: static void edubfm_BgWriterSweep(Four, Boolean)
+ *
+ * Description:
+ *  Walk the dirty list from the oldest dirty buffer element on, and force
+ *  out each unfixed and unreferenced train, until 'cleanTarget' buffer
+ *  elements of the buffer pool are clean. When woken up by a fixing thread
+ *  which has met a dirty victim ('urgent'), up to 'cleanTarget' trains are
+ *  written even if enough buffers are clean, since the clock is passing
+ *  over dirty ones. Only the dirty buffer elements are visited. A buffer
+ *  element is claimed while it is written so that it is neither modified
+ *  nor chosen as a victim in the meantime. Under the clock policy,
+ *  referenced trains are left alone since they are likely to be updated
+ *  again; the other policies do not maintain the reference bits, so every
+ *  dirty unfixed train is written.
+ *
+ * Returns:
+ *  None
+ */
+static void edubfm_BgWriterSweep(
+    Four		type,			/* IN buffer type */
+    Boolean		urgent)			/* IN has a fixing thread met a dirty victim? */
+{
+    Four		e;			/* error */
+    Four		n = BI_NBUFS_LOAD(type);
+    Four		k;
+    Four		i;
+    Four		nDirty;			/* # of buffers in the dirty list */
+    Four		*dirty;			/* buffers in the dirty list, the oldest first */
+    Four		toWrite;		/* # of trains to be written */
+    Four		target;
+    One			bits;
+    BfMHashKey		key;
+    Boolean		useRefer;		/* is the clock choosing the victims? */
+
+
+    useRefer = (BI_POLICY(type) == &edubfm_clockPolicy);
+    target = MIN(bufWriter[type].cleanTarget, n);
+
+    dirty = (Four *)malloc(sizeof(Four) * n);
+    if (dirty == NULL) return;
+
+    nDirty = edubfm_DirtyFrames(type, dirty, n);
+    toWrite = urgent ? target : target - (n - nDirty);
+
+    for (k = 0; k < nDirty && toWrite > 0; k++)
+    {
+        i = dirty[k];
+        if (i >= n) continue;
+
+        if (BI_FIXED_LOAD(type, i) != 0) continue;
+
+        bits = BI_BITS_LOAD(type, i);
+        if (useRefer && (bits & REFER)) continue;
+        if (!(bits & DIRTY)) continue;
+
+        if (!edubfm_ClaimBuffer(type, i)) continue;
+
+        key = BI_KEY(type, i);
+        if (key.pageNo != NIL && (BI_BITS_LOAD(type, i) & DIRTY))
+        {
+            /* a failed write leaves the train dirty for the fixing threads */
+            e = edubfm_FlushBuffer(type, i);
+            if (e >= 0)
+            {
+                BFM_STAT_INC(type, bgFlushes);
+                toWrite--;
+            }
+        }
+
+        edubfm_UnclaimBuffer(type, i);
+    }
+
+    free(dirty);
+
+} /* edubfm_BgWriterSweep() */
+
+
+
+/*@================================
+ * edubfm_BgWriterMain()
+ *================================*/
+/*
+ * Function: void *edubfm_BgWriterMain(void *)
+ *
+ * Description:
+ *  The body of the background writer thread of the buffer pool 'arg'.
+ *  Sweep the buffer table every 'interval' milliseconds, or at once when
+ *  woken up by edubfm_WakeBgWriter(), until EduBfM_StopBgWriter() is called.
+ *  A sweep is skipped while the buffer pool is resized or moved, so that
+ *  the writer neither reads the size being changed nor holds a claim
+ *  which would make the move fail.
+ *
+ * Returns:
+ *  NULL
+ */
+void *edubfm_BgWriterMain(
+    void		*arg)			/* IN buffer type */
+{
+    Four		type = (Four)(long)arg;	/* buffer type */
+    BufferWriterInfo	*w = &bufWriter[type];
+    struct timespec	until;			/* end of the sleep */
+    Boolean		urgent;			/* woken up by a fixing thread? */
+
+
+    pthread_mutex_lock(&w->mutex);
+
+    while (!w->stop)
+    {
+        urgent = w->wakeup;
+        w->wakeup = FALSE;
+
+        pthread_mutex_unlock(&w->mutex);
+
+        /* no sweep while the buffer pool is resized or moved */
+        if (pthread_mutex_trylock(&bufResize[type].mutex) == 0)
+        {
+            edubfm_BgWriterSweep(type, urgent);
+            pthread_mutex_unlock(&bufResize[type].mutex);
+        }
+
+        pthread_mutex_lock(&w->mutex);
+
+        if (w->stop) break;
+
+        if (!w->wakeup)
+        {
+            clock_gettime(CLOCK_REALTIME, &until);
+            until.tv_sec += w->interval / 1000;
+            until.tv_nsec += (long)(w->interval % 1000) * 1000000L;
+            if (until.tv_nsec >= 1000000000L)
+            {
+                until.tv_sec++;
+                until.tv_nsec -= 1000000000L;
+            }
+
+            pthread_cond_timedwait(&w->cond, &w->mutex, &until);
+        }
+    }
+
+    pthread_mutex_unlock(&w->mutex);
+
+    return(NULL);
+
+} /* edubfm_BgWriterMain() */
+
+
+
+/*@================================
+ * edubfm_WakeBgWriter()
+ *================================*/
+/*
+ * Function: void edubfm_WakeBgWriter(Four)
+ *
+ * Description:
+ *  Ask the background writer of the buffer pool to sweep at once.
+ *  Called by a fixing thread which has met a dirty victim.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_WakeBgWriter(
+    Four		type)			/* IN buffer type */
+{
+    BufferWriterInfo	*w = &bufWriter[type];
+
+
+    pthread_mutex_lock(&w->mutex);
+    if (!w->wakeup)
+    {
+        w->wakeup = TRUE;
+        pthread_cond_signal(&w->cond);
+    }
+    pthread_mutex_unlock(&w->mutex);
+
+} /* edubfm_WakeBgWriter() */
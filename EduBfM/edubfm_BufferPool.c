@@ -0,0 +1,385 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_BufferPool.c
+ *
+ * Description:
+ *  Place the buffer pool (the frames of bufInfo[type].bufferPool) in memory
+ *  backed by huge pages and spread it over the NUMA nodes.
+ *  The buffer pool is allocated with malloc() and freed with free() by the
+ *  storage system, so it is replaced by memory from posix_memalign(), which
+ *  free() accepts, rather than by an mmap()ed region. Huge pages are asked
+ *  for with madvise(MADV_HUGEPAGE) (transparent huge pages, 2MB on x86-64);
+ *  the NUMA placement is set with the mbind() system call. Both are hints:
+ *  if the kernel does not support them, regular pages are used.
+ *  At the first call the buffer table and the buffer pool are moved into
+ *  allocations with room for BFM_MAXNBUFS buffers, so that the buffer pool
+ *  can grow in place (see edubfm_Resize.c). Untouched pages of the reserved
+ *  room take no physical memory.
+ *
+ * Exports:
+ *  Four edubfm_InitBufferPools(void)
+ *  Four edubfm_SetUpPoolMemory(Four)
+ *  Four edubfm_RemapBufferPool(Four, Four, Four)
+ */
+
+
+#include <stdlib.h>	/* for posix_memalign & free */
+#include <string.h>	/* for memcpy */
+#include <dirent.h>	/* for opendir */
+#include <unistd.h>	/* for syscall */
+#include <sys/mman.h>	/* for madvise */
+#include <sys/syscall.h>
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+/*@
+ * constant definitions
+ */
+#define BFM_HUGEPAGESIZE	(2 * 1024 * 1024)	/* size of a transparent huge page */
+
+/* memory policies of mbind(2) */
+#define BFM_MPOL_BIND		2
+#define BFM_MPOL_INTERLEAVE	3
+
+#define BFM_MAXNUMANODES	64
+
+
+/*@
+ * global variables
+ */
+static pthread_once_t edubfm_bufferPoolOnce = PTHREAD_ONCE_INIT;
+
+
+
+/*@================================
+ * edubfm_NumaNodes()
+ *================================*/
+/*
+ * Function: static Four edubfm_NumaNodes(void)
+ *
+ * Description:
+ *  Count the NUMA nodes of the machine.
+ *
+ * Returns:
+ *  # of NUMA nodes, 1 if unknown
+ */
+static Four edubfm_NumaNodes(void)
+{
+    DIR			*dir;
+    struct dirent	*d;
+    Four		nNodes = 0;
+
+
+    dir = opendir("/sys/devices/system/node");
+    if (dir == NULL) return(1);
+
+    while ((d = readdir(dir)) != NULL)
+        if (strncmp(d->d_name, "node", 4) == 0 && d->d_name[4] >= '0' && d->d_name[4] <= '9')
+            nNodes++;
+
+    closedir(dir);
+
+    return(MIN(MAX(nNodes, 1), BFM_MAXNUMANODES));
+
+} /* edubfm_NumaNodes() */
+
+
+
+/*@================================
+ * edubfm_PlaceMemory()
+ *================================*/
+/*
+ * Function: static void edubfm_PlaceMemory(char *, Four, Four, Four)
+ *
+ * Description:
+ *  Set the NUMA policy of a new buffer pool before it is touched.
+ *  BFM_POOL_NUMA_INTERLEAVE spreads the pages round robin over the nodes;
+ *  BFM_POOL_NUMA_PARTITION splits the buffer pool into one range of
+ *  buffers per node, each bound to its node.
+ *
+ * Returns:
+ *  None
+ */
+static void edubfm_PlaceMemory(
+    char		*pool,			/* IN new buffer pool */
+    Four		type,			/* IN buffer type */
+    Four		allocSize,		/* IN size of the allocation */
+    Four		flags)			/* IN BFM_POOL_XXX */
+{
+    Four		nNodes = edubfm_NumaNodes();
+    Four		node;
+    Four		trainBytes = PAGESIZE * BI_BUFSIZE(type);
+    Four		nFrames = allocSize / trainBytes;	/* including the room to grow */
+    Four		first, last;		/* buffers of a partition */
+    unsigned long	mask;
+    char		*start, *end;
+
+
+    if (nNodes < 2) return;
+
+    if (flags & BFM_POOL_NUMA_INTERLEAVE)
+    {
+        mask = (nNodes == BFM_MAXNUMANODES) ? ~0UL : (1UL << nNodes) - 1;
+        (void) syscall(SYS_mbind, pool, allocSize, BFM_MPOL_INTERLEAVE, &mask, BFM_MAXNUMANODES + 1, 0);
+    }
+    else if (flags & BFM_POOL_NUMA_PARTITION)
+    {
+        for (node = 0; node < nNodes; node++)
+        {
+            first = nFrames * node / nNodes;
+            last = nFrames * (node + 1) / nNodes;
+            if (first == last) continue;
+
+            /* mbind() works on whole pages */
+            start = pool + ((first * trainBytes) / PAGESIZE) * PAGESIZE;
+            end = (node == nNodes - 1) ? pool + allocSize : pool + last * trainBytes;
+
+            mask = 1UL << node;
+            (void) syscall(SYS_mbind, start, end - start, BFM_MPOL_BIND, &mask, BFM_MAXNUMANODES + 1, 0);
+        }
+    }
+
+} /* edubfm_PlaceMemory() */
+
+
+
+/*@================================
+ * edubfm_RemapBufferPool()
+ *================================*/
+/*
+ * Function: Four edubfm_RemapBufferPool(Four, Four, Four)
+ *
+ * Description:
+ *  Move the buffer pool into new memory, with room for 'capacity' buffers,
+ *  placed as 'flags' says.
+ *  All stripe latches are held and every buffer element is claimed and
+ *  fenced during the move, so it fails if any train is fixed; the contents
+ *  and the buffer table are kept. The caller holds the resize latch of the buffer pool.
+ *  Once trains have been read optimistically from the buffer pool, the old
+ *  memory is kept on the retired list rather than freed.
+ *
+ * Returns:
+ *  error code
+ *    eFIXEDBUFFER_EDUBFM - a train is fixed
+ *    eMEMORYALLOCERR_EDUBFM - memory allocation failed
+ */
+Four edubfm_RemapBufferPool(
+    Four		type,			/* IN buffer type */
+    Four		flags,			/* IN BFM_POOL_XXX */
+    Four		capacity)		/* IN # of buffers to make room for */
+{
+    Four		i, j;
+    Four		poolSize;		/* size of the frames in use */
+    Four		allocSize;		/* size of the new allocation */
+    Four		align;
+    void		*pool;
+    void		*old;			/* buffer pool moved away from */
+
+
+    /* keep everybody away from the frames: nobody can fix a train without
+     * a stripe latch or a swip, nor replace a buffer without claiming it */
+    edubfm_LatchAllStripes(type);
+    for (i = 0; i < BI_NBUFS(type); i++)
+    {
+        if (edubfm_ClaimBuffer(type, i))
+        {
+            if (edubfm_FenceBuffer(type, i)) continue;
+            edubfm_UnclaimBuffer(type, i);
+        }
+
+        for (j = 0; j < i; j++)
+        {
+            edubfm_UnfenceBuffer(type, j);
+            edubfm_UnclaimBuffer(type, j);
+        }
+        edubfm_UnlatchAllStripes(type);
+        ERR(eFIXEDBUFFER_EDUBFM);
+    }
+
+    poolSize = PAGESIZE * BI_BUFSIZE(type) * BI_NBUFS(type);
+    allocSize = PAGESIZE * BI_BUFSIZE(type) * MAX(capacity, BI_NBUFS(type));
+    if (flags & BFM_POOL_HUGEPAGE)
+    {
+        align = BFM_HUGEPAGESIZE;
+        allocSize = (allocSize + BFM_HUGEPAGESIZE - 1) / BFM_HUGEPAGESIZE * BFM_HUGEPAGESIZE;
+    }
+    else
+        align = PAGESIZE;
+
+    if (posix_memalign(&pool, align, allocSize) != 0)
+    {
+        for (i = 0; i < BI_NBUFS(type); i++)
+        {
+            edubfm_UnfenceBuffer(type, i);
+            edubfm_UnclaimBuffer(type, i);
+        }
+        edubfm_UnlatchAllStripes(type);
+        ERR(eMEMORYALLOCERR_EDUBFM);
+    }
+
+#ifdef MADV_HUGEPAGE
+    if (flags & BFM_POOL_HUGEPAGE) (void) madvise(pool, allocSize, MADV_HUGEPAGE);
+#endif
+    if (flags & (BFM_POOL_NUMA_INTERLEAVE | BFM_POOL_NUMA_PARTITION))
+        edubfm_PlaceMemory((char *)pool, type, allocSize, flags);
+
+    memcpy(pool, BI_BUFFERPOOL(type), poolSize);
+    old = BI_BUFFERPOOL(type);
+    BI_BUFFERPOOL(type) = pool;
+
+    /* An optimistic reader may still be reading the old buffer pool, and
+     * fails its validation since the versions have changed: keep the old
+     * buffer pool, linked through its first word, instead of freeing it. */
+    for (i = 0; i < BI_NBUFS(type); i++) edubfm_UnfenceBuffer(type, i);
+    if (__atomic_load_n(&bufResize[type].optimistic, __ATOMIC_SEQ_CST))
+    {
+        *(void **)old = bufResize[type].retired;
+        bufResize[type].retired = old;
+    }
+    else
+        free(old);
+    bufResize[type].poolCapacity = allocSize / (PAGESIZE * BI_BUFSIZE(type));
+    bufResize[type].placement = flags;
+
+    for (i = 0; i < BI_NBUFS(type); i++) edubfm_UnclaimBuffer(type, i);
+    edubfm_UnlatchAllStripes(type);
+
+    return(eNOERROR);
+
+} /* edubfm_RemapBufferPool() */
+
+
+
+/*@================================
+ * edubfm_ReserveBufferTable()
+ *================================*/
+/*
+ * Function: static void edubfm_ReserveBufferTable(Four)
+ *
+ * Description:
+ *  Move the buffer table into an allocation with room for BFM_MAXNBUFS
+ *  entries. Nobody else uses the buffer table during the initialization.
+ *  If the allocation fails, the buffer table stays as it is and the buffer
+ *  pool cannot grow.
+ *
+ * Returns:
+ *  None
+ */
+static void edubfm_ReserveBufferTable(
+    Four		type)			/* IN buffer type */
+{
+    BufferTable		*table;
+
+
+    bufResize[type].tableCapacity = BI_NBUFS(type);
+    bufResize[type].highWater = BI_NBUFS(type);
+    bufResize[type].poolCapacity = BI_NBUFS(type);
+
+    table = (BufferTable *)malloc(sizeof(BufferTable) * BFM_MAXNBUFS);
+    if (table == NULL) return;
+
+    memcpy(table, BI_INFO(type)->bufTable, sizeof(BufferTable) * BI_NBUFS(type));
+    free(BI_INFO(type)->bufTable);
+    BI_INFO(type)->bufTable = table;
+    bufResize[type].tableCapacity = BFM_MAXNBUFS;
+
+} /* edubfm_ReserveBufferTable() */
+
+
+
+/*@================================
+ * edubfm_SetUpPoolMemory()
+ *================================*/
+/*
+ * Function: Four edubfm_SetUpPoolMemory(Four)
+ *
+ * Description:
+ *  Reserve room for a buffer pool to grow and move it into huge pages.
+ *  A buffer pool which cannot be moved stays as it is.
+ *
+ * Returns:
+ *  error code
+ */
+Four edubfm_SetUpPoolMemory(
+    Four		type)			/* IN buffer type */
+{
+    edubfm_ReserveBufferTable(type);
+
+    /* the room is only reserved if the whole of it can be allocated */
+    if (edubfm_RemapBufferPool(type, BFM_POOL_HUGEPAGE, bufResize[type].tableCapacity) < 0)
+        (void) edubfm_RemapBufferPool(type, BFM_POOL_HUGEPAGE, BI_NBUFS(type));
+
+    return(eNOERROR);
+
+} /* edubfm_SetUpPoolMemory() */
+
+
+
+/*@================================
+ * edubfm_MapBufferPools()
+ *================================*/
+/*
+ * Function: static void edubfm_MapBufferPools(void)
+ *
+ * Description:
+ *  Set up the memory of the buffer pools created by the storage system.
+ *  Called only once through pthread_once().
+ *
+ * Returns:
+ *  None
+ */
+static void edubfm_MapBufferPools(void)
+{
+    Four		type;
+
+
+    for (type = 0; type < NUM_BUF_TYPES; type++)
+        (void) edubfm_SetUpPoolMemory(type);
+
+} /* edubfm_MapBufferPools() */
+
+
+
+/*@================================
+ * edubfm_InitBufferPools()
+ *================================*/
+/*
+ * Function: Four edubfm_InitBufferPools(void)
+ *
+ * Description:
+ *  Move the buffer pools into huge pages at the first call.
+ *
+ * Returns:
+ *  error code
+ */
+Four edubfm_InitBufferPools(void)
+{
+    pthread_once(&edubfm_bufferPoolOnce, edubfm_MapBufferPools);
+
+    return(eNOERROR);
+
+} /* edubfm_InitBufferPools() */
@@ -0,0 +1,302 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_Compress.c
+ *
+ * Description:
+ *  A small LZ77 compressor for the trains kept in the compressed tier, in
+ *  the block format of LZ4: a sequence is a token whose high nibble is the
+ *  # of literals and whose low nibble is the match length - 4 (15 meaning
+ *  that bytes of 255 and a final smaller byte follow), the literals, the
+ *  2-byte offset of the match and the extension of the match length. The
+ *  last sequence has literals only. Matches are found through a hash table
+ *  of 4-byte prefixes; index pages, whose keys share long prefixes, and
+ *  the zero-filled free space of pages compress well.
+ *
+ * Exports:
+ *  Four edubfm_Compress(char *, Four, char *, Four)
+ *  Four edubfm_Decompress(char *, Four, char *, Four)
+ */
+
+
+#include <string.h> /* for memcpy & memset */
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+/*@
+ * constant definitions
+ */
+#define LZ_MINMATCH	4		/* min match length */
+#define LZ_LASTLITERALS	5		/* # of bytes at the end always left as literals */
+#define LZ_MAXOFFSET	65535		/* max distance of a match */
+#define LZ_HASHLOG	12		/* log2 of the # of hash table entries */
+
+/* Macro: LZ_HASH(v)
+ * Description: hash 4 bytes into an entry of the hash table
+ */
+#define LZ_HASH(v)	((UFour)((v) * 2654435761U) >> (32 - LZ_HASHLOG))
+
+
+
+/*@================================
+ * edubfm_LZRead32()
+ *================================*/
+/*
+ * Function: static UFour edubfm_LZRead32(char *)
+ *
+ * Description:
+ *  Return the 4 bytes at 'p', which need not be aligned.
+ *
+ * Returns:
+ *  the 4 bytes
+ */
+static UFour edubfm_LZRead32(
+    char		*p)			/* IN bytes */
+{
+    UFour		v;
+
+
+    memcpy(&v, p, sizeof(UFour));
+
+    return(v);
+
+} /* edubfm_LZRead32() */
+
+
+
+/*@================================
+ * edubfm_LZPutLength()
+ *================================*/
+/*
+ * Function: static Four edubfm_LZPutLength(char *, Four, Four, Four)
+ *
+ * Description:
+ *  Write the extension bytes of a length of 15 or more at dst[op].
+ *
+ * Returns:
+ *  the new output position, or -1 if 'cap' is exceeded
+ */
+static Four edubfm_LZPutLength(
+    char		*dst,			/* OUT output */
+    Four		op,			/* IN output position */
+    Four		cap,			/* IN size of the output */
+    Four		len)			/* IN length - 15 */
+{
+    for (; len >= 255; len -= 255)
+    {
+        if (op >= cap) return(-1);
+        dst[op++] = (char)255;
+    }
+    if (op >= cap) return(-1);
+    dst[op++] = (char)len;
+
+    return(op);
+
+} /* edubfm_LZPutLength() */
+
+
+
+/*@================================
+ * edubfm_LZPutSequence()
+ *================================*/
+/*
+ * Function: static Four edubfm_LZPutSequence(char *, Four, Four, char *, Four, Four, Four)
+ *
+ * Description:
+ *  Write a sequence of 'nLiterals' literals followed by a match of 'len'
+ *  bytes at distance 'offset'; a 'len' of 0 writes the last sequence.
+ *
+ * Returns:
+ *  the new output position, or -1 if 'cap' is exceeded
+ */
+static Four edubfm_LZPutSequence(
+    char		*dst,			/* OUT output */
+    Four		op,			/* IN output position */
+    Four		cap,			/* IN size of the output */
+    char		*literals,		/* IN literals */
+    Four		nLiterals,		/* IN # of literals */
+    Four		offset,			/* IN distance of the match */
+    Four		len)			/* IN match length, 0 if none */
+{
+    Four		token;			/* position of the token */
+    Four		m = (len > 0) ? len - LZ_MINMATCH : 0;
+
+
+    if (op >= cap) return(-1);
+    token = op++;
+    dst[token] = (char)((MIN(nLiterals, 15) << 4) | MIN(m, 15));
+
+    if (nLiterals >= 15 && (op = edubfm_LZPutLength(dst, op, cap, nLiterals - 15)) < 0) return(-1);
+
+    if (op + nLiterals > cap) return(-1);
+    memcpy(dst + op, literals, nLiterals);
+    op += nLiterals;
+
+    if (len == 0) return(op);
+
+    if (op + 2 > cap) return(-1);
+    dst[op++] = (char)(offset & 0xff);
+    dst[op++] = (char)(offset >> 8);
+
+    if (m >= 15 && (op = edubfm_LZPutLength(dst, op, cap, m - 15)) < 0) return(-1);
+
+    return(op);
+
+} /* edubfm_LZPutSequence() */
+
+
+
+/*@================================
+ * edubfm_Compress()
+ *================================*/
+/*
+ * Function: Four edubfm_Compress(char *, Four, char *, Four)
+ *
+ * Description:
+ *  Compress the 'n' bytes at 'src' into at most 'cap' bytes at 'dst'.
+ *
+ * Returns:
+ *  size of the compressed data, or 0 if it does not fit in 'cap' bytes
+ */
+Four edubfm_Compress(
+    char		*src,			/* IN data to be compressed */
+    Four		n,			/* IN size of the data */
+    char		*dst,			/* OUT compressed data */
+    Four		cap)			/* IN size of 'dst' */
+{
+    Four		table[1 << LZ_HASHLOG];	/* last position of each hash value */
+    Four		ip = 0;			/* input position */
+    Four		anchor = 0;		/* first byte not written yet */
+    Four		op = 0;			/* output position */
+    Four		ref;			/* candidate match */
+    Four		len;			/* match length */
+    Four		limit = n - LZ_LASTLITERALS - LZ_MINMATCH;
+    UFour		v;
+
+
+    memset(table, 0xff, sizeof(table));		/* all -1 */
+
+    while (ip < limit)
+    {
+        v = edubfm_LZRead32(src + ip);
+        ref = table[LZ_HASH(v)];
+        table[LZ_HASH(v)] = ip;
+
+        if (ref < 0 || ip - ref > LZ_MAXOFFSET || edubfm_LZRead32(src + ref) != v)
+        {
+            ip++;
+            continue;
+        }
+
+        for (len = LZ_MINMATCH; ip + len < n - LZ_LASTLITERALS && src[ref + len] == src[ip + len]; len++);
+
+        op = edubfm_LZPutSequence(dst, op, cap, src + anchor, ip - anchor, ip - ref, len);
+        if (op < 0) return(0);
+
+        ip += len;
+        anchor = ip;
+    }
+
+    op = edubfm_LZPutSequence(dst, op, cap, src + anchor, n - anchor, 0, 0);
+    if (op < 0) return(0);
+
+    return(op);
+
+} /* edubfm_Compress() */
+
+
+
+/*@================================
+ * edubfm_Decompress()
+ *================================*/
+/*
+ * Function: Four edubfm_Decompress(char *, Four, char *, Four)
+ *
+ * Description:
+ *  Decompress the 'n' bytes at 'src', made by edubfm_Compress(), into
+ *  'size' bytes at 'dst'.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_EDUBFM - the data is corrupt or does not decompress into 'size' bytes
+ */
+Four edubfm_Decompress(
+    char		*src,			/* IN compressed data */
+    Four		n,			/* IN size of the compressed data */
+    char		*dst,			/* OUT data */
+    Four		size)			/* IN size of the data */
+{
+    Four		ip = 0;			/* input position */
+    Four		op = 0;			/* output position */
+    Four		token;
+    Four		len;
+    Four		offset;
+    UOne		b;
+
+
+    while (ip < n)
+    {
+        token = (UOne)src[ip++];
+
+        len = token >> 4;
+        if (len == 15)
+            do {
+                if (ip >= n) ERR(eBADPARAMETER_EDUBFM);
+                b = (UOne)src[ip++];
+                len += b;
+            } while (b == 255);
+
+        if (ip + len > n || op + len > size) ERR(eBADPARAMETER_EDUBFM);
+        memcpy(dst + op, src + ip, len);
+        ip += len;
+        op += len;
+
+        if (ip == n) break;			/* the last sequence */
+
+        if (ip + 2 > n) ERR(eBADPARAMETER_EDUBFM);
+        offset = (UOne)src[ip] | ((UOne)src[ip + 1] << 8);
+        ip += 2;
+
+        len = token & 15;
+        if (len == 15)
+            do {
+                if (ip >= n) ERR(eBADPARAMETER_EDUBFM);
+                b = (UOne)src[ip++];
+                len += b;
+            } while (b == 255);
+        len += LZ_MINMATCH;
+
+        if (offset == 0 || offset > op || op + len > size) ERR(eBADPARAMETER_EDUBFM);
+
+        /* byte by byte, since the match may overlap the output */
+        for (; len > 0; len--, op++) dst[op] = dst[op - offset];
+    }
+
+    if (op != size) ERR(eBADPARAMETER_EDUBFM);
+
+    return(eNOERROR);
+
+} /* edubfm_Decompress() */
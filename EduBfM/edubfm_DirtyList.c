@@ -0,0 +1,304 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_DirtyList.c
+ *
+ * Description:
+ *  Dirty lists of the buffer pools. The buffer elements holding a train
+ *  modified since it was last written are linked in the order they became
+ *  dirty, so that the flush and the background writer visit only the dirty
+ *  buffer elements, the oldest first, instead of the whole buffer table.
+ *  A buffer element is linked when its dirty bit is set and unlinked when
+ *  its train has been written and is still clean; the dirty bit is the
+ *  truth, and the visitors of a list skip a buffer element found clean.
+ *
+ * Exports:
+ *  BufferDirtyInfo bufDirty[]
+ *  Four edubfm_InitDirtyLists(void)
+ *  Four edubfm_SetUpPoolDirtyList(Four)
+ *  void edubfm_DirtyLink(Four, Four)
+ *  void edubfm_DirtyUnlink(Four, Four)
+ *  void edubfm_DirtyClear(Four)
+ *  Four edubfm_DirtyFrames(Four, Four *, Four)
+ */
+
+
+#include <stdlib.h> /* for malloc */
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+/*@
+ * global variables
+ */
+/* dirty lists of the buffer pools */
+BufferDirtyInfo bufDirty[BFM_MAXPOOLS] = {
+    [0 ... BFM_MAXPOOLS-1] = { .mutex = PTHREAD_MUTEX_INITIALIZER }
+};
+
+static pthread_once_t edubfm_dirtyListOnce = PTHREAD_ONCE_INIT;
+static Four edubfm_dirtyListInitError = eNOERROR;
+
+
+
+/*@================================
+ * edubfm_SetUpPoolDirtyList()
+ *================================*/
+/*
+ * Function: Four edubfm_SetUpPoolDirtyList(Four)
+ *
+ * Description:
+ *  Allocate the links of the dirty list of a buffer pool for the largest
+ *  buffer pool and link the buffer elements which are already dirty.
+ *
+ * Returns:
+ *  error code
+ *    eMEMORYALLOCERR_EDUBFM - memory allocation failed
+ */
+Four edubfm_SetUpPoolDirtyList(
+    Four		type)			/* IN buffer type */
+{
+    Four		i;
+    BufferDirtyInfo	*d = &bufDirty[type];
+
+
+    d->next = (Four *)malloc(sizeof(Four) * BFM_MAXNBUFS);
+    d->prev = (Four *)malloc(sizeof(Four) * BFM_MAXNBUFS);
+    d->linked = (Boolean *)calloc(BFM_MAXNBUFS, sizeof(Boolean));
+    if (d->next == NULL || d->prev == NULL || d->linked == NULL)
+        ERR(eMEMORYALLOCERR_EDUBFM);
+
+    edubfm_ListInit(&d->list);
+
+    for (i = 0; i < BI_NBUFS(type); i++)
+    {
+        if (BI_KEY(type, i).pageNo != NIL && (BI_BITS_LOAD(type, i) & DIRTY))
+        {
+            edubfm_ListPushHead(&d->list, d->next, d->prev, i);
+            d->linked[i] = TRUE;
+        }
+    }
+
+    return(eNOERROR);
+
+} /* edubfm_SetUpPoolDirtyList() */
+
+
+
+/*@================================
+ * edubfm_BuildDirtyLists()
+ *================================*/
+/*
+ * Function: static void edubfm_BuildDirtyLists(void)
+ *
+ * Description:
+ *  Build the dirty lists of the buffer pools created by the storage
+ *  system. Called only once through pthread_once().
+ *
+ * Returns:
+ *  None (the error code is kept in edubfm_dirtyListInitError)
+ */
+static void edubfm_BuildDirtyLists(void)
+{
+    Four		e;			/* error */
+    Four		type;
+
+
+    for (type = 0; type < NUM_BUF_TYPES; type++)
+    {
+        e = edubfm_SetUpPoolDirtyList(type);
+        if (e < 0)
+        {
+            edubfm_dirtyListInitError = e;
+            return;
+        }
+    }
+
+} /* edubfm_BuildDirtyLists() */
+
+
+
+/*@================================
+ * edubfm_InitDirtyLists()
+ *================================*/
+/*
+ * Function: Four edubfm_InitDirtyLists(void)
+ *
+ * Description:
+ *  Build the dirty lists of the buffer pools at the first call.
+ *
+ * Returns:
+ *  error code
+ *    eMEMORYALLOCERR_EDUBFM - memory allocation failed
+ */
+Four edubfm_InitDirtyLists(void)
+{
+    pthread_once(&edubfm_dirtyListOnce, edubfm_BuildDirtyLists);
+
+    if (edubfm_dirtyListInitError < 0) ERR(edubfm_dirtyListInitError);
+
+    return(eNOERROR);
+
+} /* edubfm_InitDirtyLists() */
+
+
+
+/*@================================
+ * edubfm_DirtyLink()
+ *================================*/
+/*
+ * Function: void edubfm_DirtyLink(Four, Four)
+ *
+ * Description:
+ *  Link the buffer element at the head of the dirty list. Called by the
+ *  thread which has turned its dirty bit on. A buffer element still linked
+ *  from an earlier modification was written meanwhile, so it is moved to
+ *  the head as if it became dirty now.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_DirtyLink(
+    Four		type,			/* IN buffer type */
+    Four		index)			/* IN buffer element became dirty */
+{
+    BufferDirtyInfo	*d = &bufDirty[type];
+
+
+    pthread_mutex_lock(&d->mutex);
+
+    if (d->linked[index])
+        edubfm_ListRemove(&d->list, d->next, d->prev, index);
+
+    edubfm_ListPushHead(&d->list, d->next, d->prev, index);
+    d->linked[index] = TRUE;
+
+    pthread_mutex_unlock(&d->mutex);
+
+} /* edubfm_DirtyLink() */
+
+
+
+/*@================================
+ * edubfm_DirtyUnlink()
+ *================================*/
+/*
+ * Function: void edubfm_DirtyUnlink(Four, Four)
+ *
+ * Description:
+ *  Unlink the buffer element from the dirty list after its train has been
+ *  written, unless the train has been modified again during the write.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_DirtyUnlink(
+    Four		type,			/* IN buffer type */
+    Four		index)			/* IN buffer element written */
+{
+    BufferDirtyInfo	*d = &bufDirty[type];
+
+
+    pthread_mutex_lock(&d->mutex);
+
+    if (d->linked[index] && !(BI_BITS_LOAD(type, index) & DIRTY))
+    {
+        edubfm_ListRemove(&d->list, d->next, d->prev, index);
+        d->linked[index] = FALSE;
+    }
+
+    pthread_mutex_unlock(&d->mutex);
+
+} /* edubfm_DirtyUnlink() */
+
+
+
+/*@================================
+ * edubfm_DirtyClear()
+ *================================*/
+/*
+ * Function: void edubfm_DirtyClear(Four)
+ *
+ * Description:
+ *  Empty the dirty list of the buffer pool. Called when all the trains of
+ *  the buffer pool have been discarded.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_DirtyClear(
+    Four		type)			/* IN buffer type */
+{
+    BufferDirtyInfo	*d = &bufDirty[type];
+
+
+    pthread_mutex_lock(&d->mutex);
+
+    while (d->list.tail != NIL)
+    {
+        d->linked[d->list.tail] = FALSE;
+        edubfm_ListRemove(&d->list, d->next, d->prev, d->list.tail);
+    }
+
+    pthread_mutex_unlock(&d->mutex);
+
+} /* edubfm_DirtyClear() */
+
+
+
+/*@================================
+ * edubfm_DirtyFrames()
+ *================================*/
+/*
+ * Function: Four edubfm_DirtyFrames(Four, Four *, Four)
+ *
+ * Description:
+ *  Copy up to 'max' buffer elements of the dirty list into 'index', the
+ *  oldest dirty first. The caller must check the dirty bit of each, since
+ *  a buffer element may be written as soon as the list is unlatched.
+ *
+ * Returns:
+ *  # of buffer elements copied
+ */
+Four edubfm_DirtyFrames(
+    Four		type,			/* IN buffer type */
+    Four		*index,			/* OUT buffer elements */
+    Four		max)			/* IN size of 'index' */
+{
+    BufferDirtyInfo	*d = &bufDirty[type];
+    Four		i;
+    Four		n = 0;
+
+
+    pthread_mutex_lock(&d->mutex);
+
+    for (i = d->list.tail; i != NIL && n < max; i = d->prev[i])
+        index[n++] = i;
+
+    pthread_mutex_unlock(&d->mutex);
+
+    return(n);
+
+} /* edubfm_DirtyFrames() */
@@ -30,6 +30,7 @@
  *
  * Exports:
  *  Four edubfm_FlushTrain(TrainID *, Four)
+ *  Four edubfm_FlushBuffer(Four, Four)
  */
 
 
@@ -71,15 +72,17 @@ Four edubfm_FlushTrain(
 	/* Error check whether using not supported functionality by EduBfM */
 	if (RM_IS_ROLLBACK_REQUIRED()) ERR(eNOTSUPPORTED_EDUBFM);
 
+    CHECKKEY((BfMHashKey *)trainId);
+
+    edubfm_LatchKey((BfMHashKey *)trainId, type);
     index = edubfm_LookUp((BfMHashKey *)trainId, type);
+    edubfm_UnlatchKey((BfMHashKey *)trainId, type);
 
     /* Can find index and corresponding buffer element is dirty */
-    if (index != NOTFOUND_IN_HTABLE && (BI_BITS(type, index) & DIRTY))
+    if (index != NOTFOUND_IN_HTABLE && (BI_BITS_LOAD(type, index) & DIRTY))
     {
-        e = RDsM_WriteTrain(BI_BUFFER(type, index), trainId, BI_BUFSIZE(type));
+        e = edubfm_FlushBuffer(type, index);
         if (e < 0) ERR (e);
-
-        BI_BITS(type, index) = BI_BITS(type, index) & (~DIRTY);
     }
     else 
     {
@@ -89,3 +92,55 @@ Four edubfm_FlushTrain(
     return( eNOERROR );
 
 }  /* edubfm_FlushTrain */
+
+
+
+/*@================================
+ * edubfm_FlushBuffer()
+ *================================*/
+/*
+ * Function: Four edubfm_FlushBuffer(Four, Four)
+ *
+ * Description :
+ *  Write the train held by a buffer element into the disk.
+ *  The caller knows the buffer element and keeps it from being replaced,
+ *  e.g. by claiming it, so no look-up is needed.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four edubfm_FlushBuffer(
+    Four			type,			/* IN buffer type */
+    Four			index)			/* IN buffer element to be flushed */
+{
+    Four 			e;			/* for errors */
+    BfMHashKey			key;			/* train held by the buffer element */
+    UEight			start;			/* start time of the write */
+
+
+	/* Error check whether using not supported functionality by EduBfM */
+	if (RM_IS_ROLLBACK_REQUIRED()) ERR(eNOTSUPPORTED_EDUBFM);
+
+    key = BI_KEY(type, index);
+
+    /* Clear the dirty bit before writing so that an update made during
+     * the write sets it again. */
+    BI_CLEAR_BITS(type, index, DIRTY);
+
+    edubfm_LatchIO();
+    start = edubfm_Now();
+    e = RDsM_WriteTrain(BI_BUFFER(type, index), (TrainID *)&key, BI_BUFSIZE(type));
+    edubfm_HistAdd(&bufStats[type].writeLatency, edubfm_Now() - start);
+    edubfm_UnlatchIO();
+    if (e < 0)
+    {
+        BI_SET_BITS(type, index, DIRTY);
+        ERR (e);
+    }
+
+    edubfm_DirtyUnlink(type, index);
+
+    return( eNOERROR );
+
+}  /* edubfm_FlushBuffer */
@@ -0,0 +1,260 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_FlushTrains.c
+ *
+ * Description :
+ *  Write all dirty trains of a buffer pool into the disk in the order of
+ *  their disk addresses, combining trains adjacent on the disk into one
+ *  multi-train write.
+ *
+ * Exports:
+ *  Four edubfm_FlushTrains(Four)
+ */
+
+
+#include <stdlib.h> /* for malloc, free & qsort */
+#include <string.h> /* for memcpy */
+#include "EduBfM_common.h"
+#include "RDsM.h"
+#include "RM.h"
+#include "EduBfM_Internal.h"
+
+
+/*@
+ * constant and type definitions
+ */
+#define BFM_MAXFLUSHRUN 32	/* max # of trains written by one RDsM_WriteTrains() */
+
+/* a dirty buffer element to be flushed */
+typedef struct {
+    BfMHashKey	key;		/* train held by the buffer element */
+    Four	index;		/* index of the buffer element */
+} FlushEntry;
+
+
+
+/*@================================
+ * edubfm_CompareFlushEntry()
+ *================================*/
+/*
+ * Function: static int edubfm_CompareFlushEntry(const void *, const void *)
+ *
+ * Description :
+ *  Order the flush entries by (volNo, pageNo); used by qsort().
+ */
+static int edubfm_CompareFlushEntry(
+    const void		*a,
+    const void		*b)
+{
+    const BfMHashKey	*x = &((const FlushEntry *)a)->key;
+    const BfMHashKey	*y = &((const FlushEntry *)b)->key;
+
+
+    if (x->volNo != y->volNo) return((x->volNo < y->volNo) ? -1 : 1);
+    if (x->pageNo != y->pageNo) return((x->pageNo < y->pageNo) ? -1 : 1);
+
+    return(0);
+
+} /* edubfm_CompareFlushEntry() */
+
+
+
+/*@================================
+ * edubfm_WriteRun()
+ *================================*/
+/*
+ * Function: static Four edubfm_WriteRun(Four, FlushEntry *, Four, char *)
+ *
+ * Description :
+ *  Write 'nTrains' trains adjacent on the disk with a single
+ *  RDsM_WriteTrains(). If the buffer elements are not adjacent in the
+ *  buffer pool, the trains are gathered in 'staging' first.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+static Four edubfm_WriteRun(
+    Four		type,			/* IN buffer type */
+    FlushEntry		*run,			/* IN trains to be written */
+    Four		nTrains,		/* IN # of trains */
+    char		*staging)		/* IN staging area of BFM_MAXFLUSHRUN trains */
+{
+    Four		e;			/* error */
+    Four		k;
+    Four		trainBytes = PAGESIZE * BI_BUFSIZE(type);
+    Boolean		contiguous = TRUE;	/* adjacent in the buffer pool, too? */
+    char		*buf;
+    UEight		start;			/* start time of the write */
+
+
+    for (k = 0; k < nTrains; k++)
+    {
+        /* Clear the dirty bit before writing so that an update made during
+         * the write sets it again. */
+        BI_CLEAR_BITS(type, run[k].index, DIRTY);
+        if (run[k].index != run[0].index + k) contiguous = FALSE;
+    }
+
+    if (contiguous)
+        buf = BI_BUFFER(type, run[0].index);
+    else
+    {
+        buf = staging;
+        for (k = 0; k < nTrains; k++)
+            memcpy(buf + k * trainBytes, BI_BUFFER(type, run[k].index), trainBytes);
+    }
+
+    edubfm_LatchIO();
+    start = edubfm_Now();
+    if (nTrains == 1)
+        e = RDsM_WriteTrain(buf, (PageID *)&run[0].key, BI_BUFSIZE(type));
+    else
+        e = RDsM_WriteTrains(buf, (PageID *)&run[0].key, nTrains, BI_BUFSIZE(type));
+    edubfm_HistAdd(&bufStats[type].writeLatency, edubfm_Now() - start);
+    edubfm_UnlatchIO();
+
+    if (e < 0)
+    {
+        for (k = 0; k < nTrains; k++)
+            BI_SET_BITS(type, run[k].index, DIRTY);
+        ERR(e);
+    }
+
+    for (k = 0; k < nTrains; k++)
+        edubfm_DirtyUnlink(type, run[k].index);
+
+    return(eNOERROR);
+
+} /* edubfm_WriteRun() */
+
+
+
+/*@================================
+ * edubfm_FlushTrains()
+ *================================*/
+/*
+ * Function: Four edubfm_FlushTrains(Four)
+ *
+ * Description :
+ *  Write all dirty trains of the buffer pool into the disk.
+ *  The dirty buffer elements are taken from the dirty list, without
+ *  visiting the clean ones, and fixed so that they are not
+ *  replaced meanwhile, sorted by (volNo, pageNo), and each run of up to
+ *  BFM_MAXFLUSHRUN trains which are adjacent on the disk is written by one
+ *  RDsM_WriteTrains(). A failed run does not stop the other runs; the
+ *  first error is returned.
+ *
+ * Returns:
+ *  error code
+ *    eMEMORYALLOCERR_EDUBFM - memory allocation failed
+ *    some errors caused by function calls
+ */
+Four edubfm_FlushTrains(
+    Four		type)			/* IN buffer type */
+{
+    Four		e;			/* error */
+    Four		firstError = eNOERROR;	/* first error of the runs */
+    Four		i;
+    Four		k;
+    Four		start, end;		/* a run is entry[start .. end-1] */
+    Four		nEntries = 0;
+    Four		n;			/* # of buffers */
+    Four		nDirty;			/* # of buffers in the dirty list */
+    Four		*dirty;			/* buffers in the dirty list */
+    FlushEntry		*entry;
+    char		*staging;
+    BfMHashKey		key;
+
+
+	/* Error check whether using not supported functionality by EduBfM */
+	if (RM_IS_ROLLBACK_REQUIRED()) ERR(eNOTSUPPORTED_EDUBFM);
+
+    /* the buffer pool may be resized meanwhile */
+    n = BI_NBUFS_LOAD(type);
+
+    dirty = (Four *)malloc(sizeof(Four) * n);
+    entry = (FlushEntry *)malloc(sizeof(FlushEntry) * n);
+    staging = (char *)malloc(PAGESIZE * BI_BUFSIZE(type) * BFM_MAXFLUSHRUN);
+    if (dirty == NULL || entry == NULL || staging == NULL)
+    {
+        free(dirty);
+        free(entry);
+        free(staging);
+        ERR(eMEMORYALLOCERR_EDUBFM);
+    }
+
+    /* collect and fix the dirty buffer elements */
+    nDirty = edubfm_DirtyFrames(type, dirty, n);
+    for (k = 0; k < nDirty; k++)
+    {
+        i = dirty[k];
+        if (i >= n || !(BI_BITS_LOAD(type, i) & DIRTY)) continue;
+
+        key = BI_KEY(type, i);
+        if (key.pageNo == NIL) continue;
+
+        edubfm_LatchKey(&key, type);
+        if (EQUALKEY(&key, &BI_KEY(type, i)) && (BI_BITS_LOAD(type, i) & DIRTY))
+        {
+            edubfm_HoldBuffer(type, i);
+            BI_FIXED_INC(type, i);
+            entry[nEntries].key = key;
+            entry[nEntries].index = i;
+            nEntries++;
+        }
+        edubfm_UnlatchKey(&key, type);
+    }
+    free(dirty);
+
+    qsort(entry, nEntries, sizeof(FlushEntry), edubfm_CompareFlushEntry);
+
+    for (start = 0; start < nEntries; start = end)
+    {
+        for (end = start + 1;
+             end < nEntries && end - start < BFM_MAXFLUSHRUN &&
+             entry[end].key.volNo == entry[start].key.volNo &&
+             entry[end].key.pageNo == entry[end-1].key.pageNo + BI_BUFSIZE(type);
+             end++);
+
+        e = edubfm_WriteRun(type, &entry[start], end - start, staging);
+        if (e < 0 && firstError == eNOERROR) firstError = e;
+    }
+
+    for (i = 0; i < nEntries; i++)
+    {
+        BI_FIXED_DEC(type, entry[i].index);
+        edubfm_UnholdBuffer(type, entry[i].index);
+    }
+
+    free(entry);
+    free(staging);
+
+    if (firstError < 0) ERR(firstError);
+
+    return(eNOERROR);
+
+} /* edubfm_FlushTrains() */
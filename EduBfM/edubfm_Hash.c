@@ -31,10 +31,12 @@
  *  and each entry has an index which indicates a buffer in a buffer pool.
  *  An ordinary hashing method is used and linear probing strategy is
  *  used if collision has occurred.
+ *  The caller must hold the stripe latch of the key (edubfm_LatchKey()),
+ *  or all stripe latches for edubfm_DeleteAll().
  *
  * Exports:
  *  Four edubfm_LookUp(BfMHashKey *, Four)
- *  Four edubfm_Insert(BfMHaskKey *, Two, Four)
+ *  Four edubfm_Insert(BfMHaskKey *, Four, Four)
  *  Four edubfm_Delete(BfMHashKey *, Four)
  *  Four edubfm_DeleteAll(void)
  */
@@ -46,25 +48,11 @@
 
 
 
-/*@
- * macro definitions
- */  
-
-/* Macro: BFM_HASH(k,type)
- * Description: return the hash value of the key given as a parameter
- * Parameters:
- *  BfMHashKey *k   : pointer to the key
- *  Four type       : buffer type
- * Returns: (Two) hash value
- */
-#define BFM_HASH(k,type)	(((k)->volNo + (k)->pageNo) % HASHTABLESIZE(type))
-
-
 /*@================================
  * edubfm_Insert()
  *================================*/
 /*
- * Function: Four edubfm_Insert(BfMHashKey *, Two, Four)
+ * Function: Four edubfm_Insert(BfMHashKey *, Four, Four)
  *
  * Description:
  * (Following description is for original ODYSSEUS/COSMOS BfM.
@@ -79,11 +67,11 @@
  */
 Four edubfm_Insert(
     BfMHashKey 		*key,			/* IN a hash key in Buffer Manager */
-    Two 		index,			/* IN an index used in the buffer pool */
+    Four 		index,			/* IN an index used in the buffer pool */
     Four 		type)			/* IN buffer type */
 {
     Four 		i;			
-    Two  		hashValue;
+    Four  		hashValue;
 
 
     CHECKKEY(key);    /*@ check validity of key */
@@ -95,11 +83,8 @@ Four edubfm_Insert(
     i = BI_HASHTABLEENTRY(type, hashValue); // original array index 
     *(BI_HASHTABLE(type) + hashValue) = index; // replace hash table entry with input array index
 
-    /* case that original array index exists, which means collison exists */
-    if (i != NIL) 
-    {
-        BI_NEXTHASHENTRY(type, index) = i;
-    }
+    /* chain the original array index (NIL if no collision exists) */
+    BI_NEXTHASHENTRY(type, index) = i;
     
     return( eNOERROR );
 
@@ -128,10 +113,9 @@ Four edubfm_Delete(
     BfMHashKey          *key,                   /* IN a hash key in buffer manager */
     Four                type )                  /* IN buffer type */
 {
-    Two                 i, prev;                
-    Two                 hashValue;
+    Four                i, prev;                
+    Four                hashValue;
 
-    // printf("%d %d\n",key->pageNo, key->volNo);
     CHECKKEY(key);    /*@ check validity of key */
 
     hashValue = BFM_HASH(key, type);
@@ -142,42 +126,30 @@ Four edubfm_Delete(
         return (eNOERROR);
     }
 
-    BfMHashKey *tmp_key = &BI_KEY(type, i);
-    CHECKKEY(tmp_key);
-
-    /* no collison exits */
-    if (BI_NEXTHASHENTRY(type, i) == NIL)
+    /* find the element in the chain, remembering its predecessor */
+    prev = NIL;
+    while (!EQUALKEY(key, &BI_KEY(type, i)))
     {
-        if (EQUALKEY(key, tmp_key))
-        {
-            *(BI_HASHTABLE(type) + hashValue) = NIL;
-        }
-        else 
+        prev = i;
+        i = BI_NEXTHASHENTRY(type, i);
+        if (i == NIL)
         {
             ERR (eNOTFOUND_BFM);
         }
     }
-    else /* collison happens */
+
+    if (prev == NIL)
     {
-        while (1)
-        {
-            prev = i;
-            i = BI_NEXTHASHENTRY(type, i);
-            if (i == NIL)
-            {
-                ERR (eNOTFOUND_BFM);
-            }
-
-            tmp_key = &BI_KEY(type, i);
-            CHECKKEY(tmp_key);
-            if (EQUALKEY(key, tmp_key))
-            {
-                BI_NEXTHASHENTRY(type, prev) = BI_NEXTHASHENTRY(type, i);
-                break;
-            }
-        }
+        *(BI_HASHTABLE(type) + hashValue) = BI_NEXTHASHENTRY(type, i);
+    }
+    else
+    {
+        BI_NEXTHASHENTRY(type, prev) = BI_NEXTHASHENTRY(type, i);
     }
 
+    /* a stale link could lead a lookup into the chain of another stripe */
+    BI_NEXTHASHENTRY(type, i) = NIL;
+
     return (eNOERROR);
 
 }  /* edubfm_Delete */
@@ -205,8 +177,8 @@ Four edubfm_LookUp(
     BfMHashKey          *key,                   /* IN a hash key in Buffer Manager */
     Four                type)                   /* IN buffer type */
 {
-    Two                 i, j;                   /* indices */
-    Two                 hashValue;
+    Four                i;                      /* index */
+    Four                hashValue;
 
     CHECKKEY(key);    /*@ check validity of key */
 
@@ -232,8 +204,6 @@ Four edubfm_LookUp(
 
     return i;
 
-    //return(NOTFOUND_IN_HTABLE);
-
 }  /* edubfm_LookUp */
 
 
@@ -255,10 +225,10 @@ Four edubfm_LookUp(
  */
 Four edubfm_DeleteAll(void)
 {
-    Two 	i;
+    Four 	i;
     Four        tableSize;
 
-    for (Four type = 0; type < 2; type++)
+    for (Four type = 0; type < BFM_NPOOLS(); type++)
     { 
         tableSize = HASHTABLESIZE(type);
         for (i = 0; i < tableSize; i++)
@@ -0,0 +1,118 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_Init.c
+ *
+ * Description:
+ *  Initialize the data structures EduBfM keeps beside the buffer pools.
+ *  The buffer pools themselves (bufInfo[]) are created by the storage
+ *  system, so these data structures are set up lazily by the first call
+ *  to an EduBfM interface function.
+ *
+ * Exports:
+ *  Four edubfm_Init(void)
+ *  Four edubfm_SetUpPool(Four)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * edubfm_Init()
+ *================================*/
+/*
+ * Function: Four edubfm_Init(void)
+ *
+ * Description:
+ *  Initialize the data structures EduBfM keeps beside the buffer pools.
+ *  It is safe to call this function many times and from several threads.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four edubfm_Init(void)
+{
+    Four	e;			/* error */
+
+
+    e = edubfm_InitLatches();
+    if (e < 0) ERR(e);
+
+    e = edubfm_InitBufferPools();
+    if (e < 0) ERR(e);
+
+    e = edubfm_InitPolicies();
+    if (e < 0) ERR(e);
+
+    e = edubfm_InitDirtyLists();
+    if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* edubfm_Init() */
+
+
+
+/*@================================
+ * edubfm_SetUpPool()
+ *================================*/
+/*
+ * Function: Four edubfm_SetUpPool(Four)
+ *
+ * Description:
+ *  Set up the data structures EduBfM keeps beside a buffer pool created by
+ *  EduBfM_CreatePool(), in the order edubfm_Init() sets them up for the
+ *  buffer pools created by the storage system. The buffer pool is not yet
+ *  visible to the other threads.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four edubfm_SetUpPool(
+    Four	type)			/* IN buffer type */
+{
+    Four	e;			/* error */
+
+
+    e = edubfm_SetUpPoolLatches(type);
+    if (e < 0) ERR(e);
+
+    e = edubfm_SetUpPoolMemory(type);
+    if (e < 0) ERR(e);
+
+    e = edubfm_SetUpPoolPolicy(type);
+    if (e < 0) ERR(e);
+
+    e = edubfm_SetUpPoolDirtyList(type);
+    if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* edubfm_SetUpPool() */
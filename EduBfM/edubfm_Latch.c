@@ -0,0 +1,728 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_Latch.c
+ *
+ * Description:
+ *  Latches which make the buffer manager safe to be called from several
+ *  threads at the same time.
+ *  The hash table of each buffer pool is partitioned into NUM_HASH_STRIPES
+ *  stripes; a hash chain may only be read or modified while holding its
+ *  stripe. Each buffer element has its own latch used to wait for the I/O
+ *  on the element. The fixed count and the bits of the buffer table are
+ *  updated atomically, and the clock hand of the replacement algorithm is
+ *  advanced with compare-and-swap.
+ *
+ * Exports:
+ *  Four edubfm_InitLatches(void)
+ *  Four edubfm_SetUpPoolLatches(Four)
+ *  Four edubfm_InitFrameLatch(Four, Four)
+ *  void edubfm_LatchKey(BfMHashKey *, Four)
+ *  void edubfm_UnlatchKey(BfMHashKey *, Four)
+ *  void edubfm_LatchAllStripes(Four)
+ *  void edubfm_UnlatchAllStripes(Four)
+ *  void edubfm_LatchIO(void)
+ *  void edubfm_UnlatchIO(void)
+ *  void edubfm_HoldBuffer(Four, Four)
+ *  void edubfm_UnholdBuffer(Four, Four)
+ *  Boolean edubfm_WaitHeldBuffer(Four, Four, BfMHashKey *)
+ *  Boolean edubfm_ClaimBuffer(Four, Four)
+ *  void edubfm_UnclaimBuffer(Four, Four)
+ *  void edubfm_ReleaseBuffer(Four, Four)
+ *  Boolean edubfm_FenceBuffer(Four, Four)
+ *  void edubfm_UnfenceBuffer(Four, Four)
+ *  Four edubfm_AdvanceClockHand(Four)
+ *  void edubfm_BeginFrameIO(Four, Four)
+ *  void edubfm_EndFrameIO(Four, Four)
+ *  void edubfm_WaitFrameIO(Four, Four)
+ */
+
+
+#include <stdlib.h> /* for malloc & free */
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+/*@
+ * global variables
+ */
+/* latches of the buffer pools */
+BufferLatchInfo bufLatch[BFM_MAXPOOLS] = {
+    [0 ... BFM_MAXPOOLS-1] = { { [0 ... NUM_HASH_STRIPES-1] = PTHREAD_MUTEX_INITIALIZER }, NULL, NULL }
+};
+
+/* RDsM is not reentrant, so the disk I/O of all threads is serialized */
+static pthread_mutex_t edubfm_ioLatch = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_once_t edubfm_latchOnce = PTHREAD_ONCE_INIT;
+static Four edubfm_latchInitError = eNOERROR;
+
+
+
+/*@================================
+ * edubfm_InitFrameLatch()
+ *================================*/
+/*
+ * Function: Four edubfm_InitFrameLatch(Four, Four)
+ *
+ * Description:
+ *  Initialize the latch of a buffer element.
+ *
+ * Returns:
+ *  error code
+ *    eMUTEXINITFAILED_BFM - latch initialization failed
+ */
+Four edubfm_InitFrameLatch(
+    Four	type,			/* IN buffer type */
+    Four	index)			/* IN index of the buffer element */
+{
+    if (pthread_mutex_init(&BI_FRAMELATCH(type, index)->mutex, NULL) != 0 ||
+        pthread_cond_init(&BI_FRAMELATCH(type, index)->cond, NULL) != 0)
+        ERR(eMUTEXINITFAILED_BFM);
+
+    BI_FRAMELATCH(type, index)->busy = FALSE;
+    BI_FRAMELATCH(type, index)->holds = 0;
+
+    return(eNOERROR);
+
+} /* edubfm_InitFrameLatch() */
+
+
+
+/*@================================
+ * edubfm_SetUpPoolLatches()
+ *================================*/
+/*
+ * Function: Four edubfm_SetUpPoolLatches(Four)
+ *
+ * Description:
+ *  Allocate the per-frame latches and versions of a buffer pool, with room
+ *  for BFM_MAXNBUFS buffer elements so that the buffer pool can grow; only
+ *  the latches of the existing buffer elements are initialized.
+ *
+ * Returns:
+ *  error code
+ *    eMEMORYALLOCERR_EDUBFM - memory allocation failed
+ *    eMUTEXINITFAILED_BFM - latch initialization failed
+ */
+Four edubfm_SetUpPoolLatches(
+    Four	type)			/* IN buffer type */
+{
+    Four	e;			/* error */
+    Four	i;			/* index */
+
+
+    bufLatch[type].frameLatch = (BufferLatch *)malloc(sizeof(BufferLatch) * BFM_MAXNBUFS);
+    bufLatch[type].version = (UFour *)calloc(BFM_MAXNBUFS, sizeof(UFour));
+    if (bufLatch[type].frameLatch == NULL || bufLatch[type].version == NULL)
+        ERR(eMEMORYALLOCERR_EDUBFM);
+
+    for (i = 0; i < BI_NBUFS(type); i++)
+    {
+        e = edubfm_InitFrameLatch(type, i);
+        if (e < 0) ERR(e);
+    }
+
+    return(eNOERROR);
+
+} /* edubfm_SetUpPoolLatches() */
+
+
+
+/*@================================
+ * edubfm_AllocFrameLatches()
+ *================================*/
+/*
+ * Function: static void edubfm_AllocFrameLatches(void)
+ *
+ * Description:
+ *  Allocate the per-frame latches and versions of the buffer pools created
+ *  by the storage system. Called only once through pthread_once().
+ *
+ * Returns:
+ *  None (the error code is kept in edubfm_latchInitError)
+ */
+static void edubfm_AllocFrameLatches(void)
+{
+    Four	e;			/* error */
+    Four	type;			/* buffer type */
+
+
+    for (type = 0; type < NUM_BUF_TYPES; type++)
+    {
+        e = edubfm_SetUpPoolLatches(type);
+        if (e < 0)
+        {
+            edubfm_latchInitError = e;
+            return;
+        }
+    }
+
+} /* edubfm_AllocFrameLatches() */
+
+
+
+/*@================================
+ * edubfm_InitLatches()
+ *================================*/
+/*
+ * Function: Four edubfm_InitLatches(void)
+ *
+ * Description:
+ *  Initialize the per-frame latches. The buffer pools are created by the
+ *  storage system before any EduBfM function is called, so the latches are
+ *  allocated lazily at the first call.
+ *
+ * Returns:
+ *  error code
+ *    eMEMORYALLOCERR_EDUBFM - memory allocation failed
+ *    eMUTEXINITFAILED_BFM - latch initialization failed
+ */
+Four edubfm_InitLatches(void)
+{
+    pthread_once(&edubfm_latchOnce, edubfm_AllocFrameLatches);
+
+    return(edubfm_latchInitError);
+
+} /* edubfm_InitLatches() */
+
+
+
+/*@================================
+ * edubfm_LatchKey()
+ *================================*/
+/*
+ * Function: void edubfm_LatchKey(BfMHashKey *, Four)
+ *
+ * Description:
+ *  Acquire the stripe latch protecting the hash chain of 'key'.
+ *  The key must be valid (see CHECKKEY).
+ *  The stripe of a key depends on the size of the buffer pool, which may be
+ *  changed while this thread waits for the latch (see edubfm_Resize.c);
+ *  in that case the latch of the new stripe is acquired instead.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_LatchKey(
+    BfMHashKey		*key,			/* IN a hash key in buffer manager */
+    Four		type)			/* IN buffer type */
+{
+    Four		stripe;
+
+
+    while (1)
+    {
+        /* BFM_STRIPE() with the size read atomically, as no latch is held yet */
+        stripe = ((key->volNo + key->pageNo) % HASHTABLESIZE_TO_NBUFS(BI_NBUFS_LOAD(type))) % NUM_HASH_STRIPES;
+        pthread_mutex_lock(&bufLatch[type].stripe[stripe]);
+
+        /* the size cannot change while any stripe latch is held */
+        if (stripe == BFM_STRIPE(key, type)) break;
+
+        pthread_mutex_unlock(&bufLatch[type].stripe[stripe]);
+    }
+
+} /* edubfm_LatchKey() */
+
+
+
+/*@================================
+ * edubfm_UnlatchKey()
+ *================================*/
+/*
+ * Function: void edubfm_UnlatchKey(BfMHashKey *, Four)
+ *
+ * Description:
+ *  Release the stripe latch protecting the hash chain of 'key'.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_UnlatchKey(
+    BfMHashKey		*key,			/* IN a hash key in buffer manager */
+    Four		type)			/* IN buffer type */
+{
+    pthread_mutex_unlock(&bufLatch[type].stripe[BFM_STRIPE(key, type)]);
+
+} /* edubfm_UnlatchKey() */
+
+
+
+/*@================================
+ * edubfm_LatchAllStripes()
+ *================================*/
+/*
+ * Function: void edubfm_LatchAllStripes(Four)
+ *
+ * Description:
+ *  Acquire all stripe latches of a buffer pool in ascending order.
+ *  Used by the operations touching the whole hash table.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_LatchAllStripes(
+    Four		type)			/* IN buffer type */
+{
+    Four		i;
+
+
+    for (i = 0; i < NUM_HASH_STRIPES; i++)
+        pthread_mutex_lock(&bufLatch[type].stripe[i]);
+
+} /* edubfm_LatchAllStripes() */
+
+
+
+/*@================================
+ * edubfm_UnlatchAllStripes()
+ *================================*/
+/*
+ * Function: void edubfm_UnlatchAllStripes(Four)
+ *
+ * Description:
+ *  Release all stripe latches of a buffer pool.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_UnlatchAllStripes(
+    Four		type)			/* IN buffer type */
+{
+    Four		i;
+
+
+    for (i = NUM_HASH_STRIPES - 1; i >= 0; i--)
+        pthread_mutex_unlock(&bufLatch[type].stripe[i]);
+
+} /* edubfm_UnlatchAllStripes() */
+
+
+
+/*@================================
+ * edubfm_LatchIO()
+ *================================*/
+/*
+ * Function: void edubfm_LatchIO(void)
+ *
+ * Description:
+ *  Acquire the latch serializing calls to RDsM.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_LatchIO(void)
+{
+    pthread_mutex_lock(&edubfm_ioLatch);
+
+} /* edubfm_LatchIO() */
+
+
+
+/*@================================
+ * edubfm_UnlatchIO()
+ *================================*/
+/*
+ * Function: void edubfm_UnlatchIO(void)
+ *
+ * Description:
+ *  Release the latch serializing calls to RDsM.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_UnlatchIO(void)
+{
+    pthread_mutex_unlock(&edubfm_ioLatch);
+
+} /* edubfm_UnlatchIO() */
+
+
+
+/*@================================
+ * edubfm_HoldBuffer()
+ *================================*/
+/*
+ * Function: void edubfm_HoldBuffer(Four, Four)
+ *
+ * Description:
+ *  Count a hold of the buffer manager on the buffer element, before it
+ *  claims or fixes the element for itself. The hold is counted first and
+ *  given back by edubfm_UnholdBuffer() after the fix, so that a fix of the
+ *  buffer manager is always covered by a hold.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_HoldBuffer(
+    Four		type,			/* IN buffer type */
+    Four		index)			/* IN index of the buffer element */
+{
+    BufferLatch		*latch = BI_FRAMELATCH(type, index);
+
+
+    pthread_mutex_lock(&latch->mutex);
+    latch->holds++;
+    pthread_mutex_unlock(&latch->mutex);
+
+} /* edubfm_HoldBuffer() */
+
+
+
+/*@================================
+ * edubfm_UnholdBuffer()
+ *================================*/
+/*
+ * Function: void edubfm_UnholdBuffer(Four, Four)
+ *
+ * Description:
+ *  Give back a hold counted by edubfm_HoldBuffer(), once the fix of the
+ *  buffer manager is gone or has become the fix of a caller, and wake up
+ *  the threads waiting in edubfm_WaitHeldBuffer().
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_UnholdBuffer(
+    Four		type,			/* IN buffer type */
+    Four		index)			/* IN index of the buffer element */
+{
+    BufferLatch		*latch = BI_FRAMELATCH(type, index);
+
+
+    pthread_mutex_lock(&latch->mutex);
+    if (--latch->holds == 0) pthread_cond_broadcast(&latch->cond);
+    pthread_mutex_unlock(&latch->mutex);
+
+} /* edubfm_UnholdBuffer() */
+
+
+
+/*@================================
+ * edubfm_WaitHeldBuffer()
+ *================================*/
+/*
+ * Function: Boolean edubfm_WaitHeldBuffer(Four, Four, BfMHashKey *)
+ *
+ * Description:
+ *  Called holding the stripe latch of 'key', whose train is in the buffer
+ *  element 'index' and could not be claimed. The stripe latch is released.
+ *  If the buffer element is held by the buffer manager or busy, wait until
+ *  it is neither; otherwise its fixed count, if any, is the callers' own.
+ *
+ * Returns:
+ *  FALSE if the buffer element is fixed by callers, otherwise TRUE
+ */
+Boolean edubfm_WaitHeldBuffer(
+    Four		type,			/* IN buffer type */
+    Four		index,			/* IN index of the buffer element */
+    BfMHashKey		*key)			/* IN train in the buffer element */
+{
+    BufferLatch		*latch = BI_FRAMELATCH(type, index);
+    Boolean		fixed;			/* is it fixed by callers? */
+
+
+    pthread_mutex_lock(&latch->mutex);
+
+    /* the train cannot leave the buffer element while the stripe latch is held */
+    fixed = (!latch->busy && latch->holds == 0 && BI_FIXED_LOAD(type, index) > 0);
+    edubfm_UnlatchKey(key, type);
+
+    while (latch->busy || latch->holds > 0)
+        pthread_cond_wait(&latch->cond, &latch->mutex);
+
+    pthread_mutex_unlock(&latch->mutex);
+
+    return(fixed ? FALSE : TRUE);
+
+} /* edubfm_WaitHeldBuffer() */
+
+
+
+/*@================================
+ * edubfm_ClaimBuffer()
+ *================================*/
+/*
+ * Function: Boolean edubfm_ClaimBuffer(Four, Four)
+ *
+ * Description:
+ *  Try to take an unfixed buffer element exclusively by changing its fixed
+ *  count from 0 to 1 atomically. Only one thread can claim an element, and
+ *  nobody else can fix it through the hash table afterwards without the
+ *  claiming thread noticing the changed fixed count. A claim is a hold of
+ *  the buffer manager, given back by edubfm_UnclaimBuffer() or
+ *  edubfm_UnholdBuffer().
+ *
+ * Returns:
+ *  TRUE if the buffer element is claimed, otherwise FALSE
+ */
+Boolean edubfm_ClaimBuffer(
+    Four		type,			/* IN buffer type */
+    Four		index)			/* IN index of the buffer element */
+{
+    Two			unfixed = 0;
+
+
+    edubfm_HoldBuffer(type, index);
+
+    if (__atomic_compare_exchange_n(&BI_FIXED(type, index), &unfixed, 1, FALSE,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        return(TRUE);
+
+    edubfm_UnholdBuffer(type, index);
+
+    return(FALSE);
+
+} /* edubfm_ClaimBuffer() */
+
+
+
+/*@================================
+ * edubfm_UnclaimBuffer()
+ *================================*/
+/*
+ * Function: void edubfm_UnclaimBuffer(Four, Four)
+ *
+ * Description:
+ *  Give back a buffer element claimed by edubfm_ClaimBuffer() as it is.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_UnclaimBuffer(
+    Four		type,			/* IN buffer type */
+    Four		index)			/* IN index of the buffer element */
+{
+    BI_FIXED_DEC(type, index);
+    edubfm_UnholdBuffer(type, index);
+
+} /* edubfm_UnclaimBuffer() */
+
+
+
+/*@================================
+ * edubfm_ReleaseBuffer()
+ *================================*/
+/*
+ * Function: void edubfm_ReleaseBuffer(Four, Four)
+ *
+ * Description:
+ *  Give back a claimed buffer element which is not in the hash table
+ *  as an empty buffer element; its version becomes even again.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_ReleaseBuffer(
+    Four		type,			/* IN buffer type */
+    Four		index)			/* IN index of the buffer element */
+{
+    BI_KEY(type, index).pageNo = NIL;
+    __atomic_store_n(&BI_BITS(type, index), ALL_0, __ATOMIC_RELEASE);
+    if (BI_VERSION_LOAD(type, index) & 1) BI_VERSION_ADD(type, index, 1);
+    edubfm_PolicyRelease(type, index);
+    BI_FIXED_DEC(type, index);
+
+} /* edubfm_ReleaseBuffer() */
+
+
+
+/*@================================
+ * edubfm_FenceBuffer()
+ *================================*/
+/*
+ * Function: Boolean edubfm_FenceBuffer(Four, Four)
+ *
+ * Description:
+ *  Keep the fixers through swips away from a buffer element fixed once by
+ *  the caller, before its train is taken away. The version is made odd
+ *  first and the fixed count checked afterwards, while a fixer through a
+ *  swip increments the fixed count first and checks the version
+ *  afterwards (see EduBfM_GetTrainBySwip()), so that at least one of them
+ *  notices the other. If the element is fixed by others, the version is
+ *  made even again.
+ *
+ * Returns:
+ *  TRUE if the caller's fix is the only one, otherwise FALSE
+ */
+Boolean edubfm_FenceBuffer(
+    Four		type,			/* IN buffer type */
+    Four		index)			/* IN index of the buffer element */
+{
+    BI_VERSION_ADD(type, index, 1);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if (BI_FIXED_LOAD(type, index) == 1) return(TRUE);
+
+    BI_VERSION_ADD(type, index, 1);
+
+    return(FALSE);
+
+} /* edubfm_FenceBuffer() */
+
+
+
+/*@================================
+ * edubfm_UnfenceBuffer()
+ *================================*/
+/*
+ * Function: void edubfm_UnfenceBuffer(Four, Four)
+ *
+ * Description:
+ *  Make the version of a buffer element fenced by edubfm_FenceBuffer()
+ *  even again; the train in the buffer element has not been taken away,
+ *  or the element is left empty.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_UnfenceBuffer(
+    Four		type,			/* IN buffer type */
+    Four		index)			/* IN index of the buffer element */
+{
+    BI_VERSION_ADD(type, index, 1);
+
+} /* edubfm_UnfenceBuffer() */
+
+
+
+/*@================================
+ * edubfm_AdvanceClockHand()
+ *================================*/
+/*
+ * Function: Four edubfm_AdvanceClockHand(Four)
+ *
+ * Description:
+ *  Atomically move the clock hand (BI_NEXTVICTIM(type)) one buffer element
+ *  forward and return the element it pointed to.
+ *
+ * Returns:
+ *  index of the buffer element to be examined next
+ */
+Four edubfm_AdvanceClockHand(
+    Four		type)			/* IN buffer type */
+{
+    UTwo		hand;			/* current position of the clock hand */
+    Four		n = BI_NBUFS_LOAD(type);	/* # of buffers */
+
+
+    hand = __atomic_load_n(&BI_NEXTVICTIM(type), __ATOMIC_ACQUIRE);
+    while (!__atomic_compare_exchange_n(&BI_NEXTVICTIM(type), &hand,
+                                        (UTwo)((hand + 1) % n), FALSE,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+    return(hand % n);
+
+} /* edubfm_AdvanceClockHand() */
+
+
+
+/*@================================
+ * edubfm_BeginFrameIO()
+ *================================*/
+/*
+ * Function: void edubfm_BeginFrameIO(Four, Four)
+ *
+ * Description:
+ *  Mark the buffer element busy; fixers wait in edubfm_WaitFrameIO()
+ *  until edubfm_EndFrameIO() is called.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_BeginFrameIO(
+    Four		type,			/* IN buffer type */
+    Four		index)			/* IN index of the buffer element */
+{
+    BufferLatch		*latch = BI_FRAMELATCH(type, index);
+
+
+    pthread_mutex_lock(&latch->mutex);
+    latch->busy = TRUE;
+    pthread_mutex_unlock(&latch->mutex);
+
+} /* edubfm_BeginFrameIO() */
+
+
+
+/*@================================
+ * edubfm_EndFrameIO()
+ *================================*/
+/*
+ * Function: void edubfm_EndFrameIO(Four, Four)
+ *
+ * Description:
+ *  Mark the I/O on the buffer element complete, make its version even
+ *  again, and wake up the waiting fixers. If the I/O failed, the caller must have reset the key of the
+ *  buffer element to NIL beforehand so that the fixers notice it.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_EndFrameIO(
+    Four		type,			/* IN buffer type */
+    Four		index)			/* IN index of the buffer element */
+{
+    BufferLatch		*latch = BI_FRAMELATCH(type, index);
+
+
+    /* the train has been read into the buffer, or its key reset to NIL */
+    if (BI_VERSION_LOAD(type, index) & 1) BI_VERSION_ADD(type, index, 1);
+
+    pthread_mutex_lock(&latch->mutex);
+    latch->busy = FALSE;
+    pthread_cond_broadcast(&latch->cond);
+    pthread_mutex_unlock(&latch->mutex);
+
+} /* edubfm_EndFrameIO() */
+
+
+
+/*@================================
+ * edubfm_WaitFrameIO()
+ *================================*/
+/*
+ * Function: void edubfm_WaitFrameIO(Four, Four)
+ *
+ * Description:
+ *  Wait until the I/O on the buffer element completes.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_WaitFrameIO(
+    Four		type,			/* IN buffer type */
+    Four		index)			/* IN index of the buffer element */
+{
+    BufferLatch		*latch = BI_FRAMELATCH(type, index);
+
+
+    pthread_mutex_lock(&latch->mutex);
+    while (latch->busy)
+        pthread_cond_wait(&latch->cond, &latch->mutex);
+    pthread_mutex_unlock(&latch->mutex);
+
+} /* edubfm_WaitFrameIO() */
@@ -0,0 +1,395 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_Policy.c
+ *
+ * Description:
+ *  Dispatch the buffer replacement events of a buffer pool to the
+ *  replacement policy chosen for the pool. The priority classes of the
+ *  trains are applied here, on top of whichever policy is in use.
+ *
+ * Exports:
+ *  BfMReplacementPolicy *edubfm_policies[]
+ *  Four edubfm_InitPolicies(void)
+ *  Four edubfm_SetUpPoolPolicy(Four)
+ *  Four edubfm_ResetPolicy(Four)
+ *  Four edubfm_PolicyVictim(Four, BfMHashKey *)
+ *  void edubfm_PolicyHit(Four, Four)
+ *  void edubfm_PolicyLoad(Four, Four, BfMHashKey *)
+ *  void edubfm_PolicyEvict(Four, Four, BfMHashKey *)
+ *  void edubfm_PolicyRelease(Four, Four)
+ *  void edubfm_PolicySetPriority(Four, Four, Four)
+ */
+
+
+#include <stdlib.h> /* for calloc */
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+/*@
+ * global variables
+ */
+/* replacement policies of the buffer pools; the clock is used by default */
+BufferPolicyInfo bufPolicy[BFM_MAXPOOLS] = {
+    [0 ... BFM_MAXPOOLS-1] = { &edubfm_clockPolicy, PTHREAD_MUTEX_INITIALIZER, NULL }
+};
+
+/* replacement policies indexed by BFM_POLICY_XXX */
+BfMReplacementPolicy *edubfm_policies[NUM_BFM_POLICIES] = {
+    &edubfm_clockPolicy,		/* BFM_POLICY_CLOCK */
+    &edubfm_lrukPolicy,			/* BFM_POLICY_LRUK */
+    &edubfm_twoQPolicy,			/* BFM_POLICY_2Q */
+    &edubfm_arcPolicy,			/* BFM_POLICY_ARC */
+    &edubfm_clockProPolicy		/* BFM_POLICY_CLOCKPRO */
+};
+
+/* priority classes of the trains in the buffer pools */
+BufferPriorityInfo bufPriority[BFM_MAXPOOLS];
+
+/* # of lives of a train of each priority class; a train of the upper levels
+ * of a B+ tree escapes the replacement more often than those below it */
+static const One edubfm_priorityLives[NUM_BFM_PRIORITIES] = { 0, 0, 1, 2, 3 };
+
+/* Macro: POLICY_LATCH(type) / POLICY_UNLATCH(type)
+ * Description: serialize the calls to a latched policy
+ */
+#define POLICY_LATCH(type) \
+    if (BI_POLICY(type)->latched) pthread_mutex_lock(&bufPolicy[type].latch)
+#define POLICY_UNLATCH(type) \
+    if (BI_POLICY(type)->latched) pthread_mutex_unlock(&bufPolicy[type].latch)
+
+static pthread_once_t edubfm_policyOnce = PTHREAD_ONCE_INIT;
+static Four edubfm_policyInitError = eNOERROR;
+
+
+
+/*@================================
+ * edubfm_SetUpPoolPolicy()
+ *================================*/
+/*
+ * Function: Four edubfm_SetUpPoolPolicy(Four)
+ *
+ * Description:
+ *  Set up the state of the replacement policy and the priority classes of
+ *  a buffer pool.
+ *
+ * Returns:
+ *  error code
+ *    eMEMORYALLOCERR_EDUBFM - memory allocation failed
+ *    some errors caused by function calls
+ */
+Four edubfm_SetUpPoolPolicy(
+    Four	type)			/* IN buffer type */
+{
+    Four	e;			/* error */
+
+
+    /* every train is a data page until told otherwise */
+    bufPriority[type].priority = (One *)calloc(BFM_MAXNBUFS, sizeof(One));
+    bufPriority[type].lives = (One *)calloc(BFM_MAXNBUFS, sizeof(One));
+    if (bufPriority[type].priority == NULL || bufPriority[type].lives == NULL)
+        ERR(eMEMORYALLOCERR_EDUBFM);
+
+    e = BI_POLICY(type)->init(type);
+    if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* edubfm_SetUpPoolPolicy() */
+
+
+
+/*@================================
+ * edubfm_SetUpPolicies()
+ *================================*/
+/*
+ * Function: static void edubfm_SetUpPolicies(void)
+ *
+ * Description:
+ *  Set up the state of the replacement policies and the priority classes
+ *  of the buffer pools created by the storage system. Called only once
+ *  through pthread_once().
+ *
+ * Returns:
+ *  None (the error code is kept in edubfm_policyInitError)
+ */
+static void edubfm_SetUpPolicies(void)
+{
+    Four	e;			/* error */
+    Four	type;			/* buffer type */
+
+
+    for (type = 0; type < NUM_BUF_TYPES; type++)
+    {
+        e = edubfm_SetUpPoolPolicy(type);
+        if (e < 0)
+        {
+            edubfm_policyInitError = e;
+            return;
+        }
+    }
+
+} /* edubfm_SetUpPolicies() */
+
+
+
+/*@================================
+ * edubfm_InitPolicies()
+ *================================*/
+/*
+ * Function: Four edubfm_InitPolicies(void)
+ *
+ * Description:
+ *  Set up the state of the replacement policies of all buffer pools at
+ *  the first call.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four edubfm_InitPolicies(void)
+{
+    pthread_once(&edubfm_policyOnce, edubfm_SetUpPolicies);
+
+    if (edubfm_policyInitError < 0) ERR(edubfm_policyInitError);
+
+    return(eNOERROR);
+
+} /* edubfm_InitPolicies() */
+
+
+
+/*@================================
+ * edubfm_ResetPolicy()
+ *================================*/
+/*
+ * Function: Four edubfm_ResetPolicy(Four)
+ *
+ * Description:
+ *  Discard the state of the replacement policy of a buffer pool and set it
+ *  up again from the current contents of the buffer pool.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four edubfm_ResetPolicy(
+    Four	type)			/* IN buffer type */
+{
+    Four	e;			/* error */
+
+
+    POLICY_LATCH(type);
+    BI_POLICY(type)->final(type);
+    e = BI_POLICY(type)->init(type);
+    POLICY_UNLATCH(type);
+    if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* edubfm_ResetPolicy() */
+
+
+
+/*@================================
+ * edubfm_PolicyVictim()
+ *================================*/
+/*
+ * Function: Four edubfm_PolicyVictim(Four, BfMHashKey *)
+ *
+ * Description:
+ *  Select and claim an unfixed buffer element to hold the train 'key'.
+ *  A victim whose train has lives left (see EduBfM_SetPriority()) is
+ *  notified to the policy as a hit, referenced, given back, and loses a
+ *  life, so that it is passed over as if it had been fixed again; the
+ *  selection is then repeated. Since lives are only restored by fixes,
+ *  this ends.
+ *
+ * Returns:
+ *  index of the claimed buffer element, or error code
+ *    eNOUNFIXEDBUF_BFM - There is no unfixed buffer.
+ */
+Four edubfm_PolicyVictim(
+    Four	type,			/* IN buffer type */
+    BfMHashKey	*key)			/* IN train to be read */
+{
+    Four	victim;
+
+
+    while (1)
+    {
+        POLICY_LATCH(type);
+        victim = BI_POLICY(type)->victim(type, key);
+        if (victim >= 0 && BI_KEY(type, victim).pageNo != NIL &&
+            __atomic_load_n(&BI_LIVES(type, victim), __ATOMIC_RELAXED) > 0)
+        {
+            BI_POLICY(type)->hit(type, victim);
+            __atomic_sub_fetch(&BI_LIVES(type, victim), 1, __ATOMIC_RELAXED);
+            POLICY_UNLATCH(type);
+
+            BI_SET_BITS(type, victim, REFER);
+            edubfm_UnclaimBuffer(type, victim);
+            continue;
+        }
+        POLICY_UNLATCH(type);
+
+        return(victim);
+    }
+
+} /* edubfm_PolicyVictim() */
+
+
+
+/*@================================
+ * edubfm_PolicyHit()
+ *================================*/
+/*
+ * Function: void edubfm_PolicyHit(Four, Four)
+ *
+ * Description:
+ *  Notify the policy that a resident train has been fixed. The train gets
+ *  all the lives of its priority class back.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_PolicyHit(
+    Four	type,			/* IN buffer type */
+    Four	index)			/* IN buffer element */
+{
+    __atomic_store_n(&BI_LIVES(type, index),
+                     edubfm_priorityLives[(Four)BI_PRIORITY(type, index)], __ATOMIC_RELAXED);
+
+    POLICY_LATCH(type);
+    BI_POLICY(type)->hit(type, index);
+    POLICY_UNLATCH(type);
+
+} /* edubfm_PolicyHit() */
+
+
+
+/*@================================
+ * edubfm_PolicyLoad()
+ *================================*/
+/*
+ * Function: void edubfm_PolicyLoad(Four, Four, BfMHashKey *)
+ *
+ * Description:
+ *  Notify the policy that a train has been read into a buffer element.
+ *  The train is a data page without extra lives until its fixer tells
+ *  otherwise.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_PolicyLoad(
+    Four	type,			/* IN buffer type */
+    Four	index,			/* IN buffer element */
+    BfMHashKey	*key)			/* IN train read */
+{
+    BI_PRIORITY(type, index) = BFM_PRIORITY_DATA;
+    __atomic_store_n(&BI_LIVES(type, index), 0, __ATOMIC_RELAXED);
+
+    POLICY_LATCH(type);
+    BI_POLICY(type)->load(type, index, key);
+    POLICY_UNLATCH(type);
+
+} /* edubfm_PolicyLoad() */
+
+
+
+/*@================================
+ * edubfm_PolicyEvict()
+ *================================*/
+/*
+ * Function: void edubfm_PolicyEvict(Four, Four, BfMHashKey *)
+ *
+ * Description:
+ *  Notify the policy that the train 'key' has been forced out of the
+ *  claimed buffer element. The key is NIL if the element was empty.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_PolicyEvict(
+    Four	type,			/* IN buffer type */
+    Four	index,			/* IN buffer element */
+    BfMHashKey	*key)			/* IN train forced out */
+{
+    POLICY_LATCH(type);
+    BI_POLICY(type)->evict(type, index, key);
+    POLICY_UNLATCH(type);
+
+} /* edubfm_PolicyEvict() */
+
+
+
+/*@================================
+ * edubfm_PolicyRelease()
+ *================================*/
+/*
+ * Function: void edubfm_PolicyRelease(Four, Four)
+ *
+ * Description:
+ *  Notify the policy that a claimed buffer element is given back empty.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_PolicyRelease(
+    Four	type,			/* IN buffer type */
+    Four	index)			/* IN buffer element */
+{
+    POLICY_LATCH(type);
+    BI_POLICY(type)->release(type, index);
+    POLICY_UNLATCH(type);
+
+} /* edubfm_PolicyRelease() */
+
+
+
+/*@================================
+ * edubfm_PolicySetPriority()
+ *================================*/
+/*
+ * Function: void edubfm_PolicySetPriority(Four, Four, Four)
+ *
+ * Description:
+ *  Set the priority class of the train in the fixed buffer element and
+ *  give it all the lives of the class.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_PolicySetPriority(
+    Four	type,			/* IN buffer type */
+    Four	index,			/* IN buffer element */
+    Four	priority)		/* IN BFM_PRIORITY_XXX */
+{
+    BI_PRIORITY(type, index) = (One)priority;
+    __atomic_store_n(&BI_LIVES(type, index), edubfm_priorityLives[priority], __ATOMIC_RELAXED);
+
+} /* edubfm_PolicySetPriority() */
@@ -0,0 +1,311 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_Policy2Q.c
+ *
+ * Description:
+ *  The full version of the 2Q buffer replacement policy (Johnson & Shasha,
+ *  VLDB 1994). A train read for the first time enters the FIFO queue A1in;
+ *  a train evicted from A1in leaves its key in the ghost queue A1out; a
+ *  train read again while its key is in A1out enters the LRU queue Am.
+ *  Trains fixed while they are in A1in are not promoted, so a sequential
+ *  scan passes through A1in without disturbing Am, unless their priority
+ *  class gives them lives (see EduBfM_SetPriority()).
+ *
+ * Exports:
+ *  BfMReplacementPolicy edubfm_twoQPolicy
+ */
+
+
+#include <stdlib.h> /* for malloc & free */
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+/*@
+ * constant and type definitions
+ */
+/* queues a buffer element belongs to */
+#define TWOQ_NONE	0	/* claimed and not yet loaded */
+#define TWOQ_FREE	1
+#define TWOQ_A1IN	2
+#define TWOQ_AM		3
+
+#define TWOQ_A1OUT	0	/* ghost list of A1out */
+
+typedef struct {
+    Four*		next;		/* links of the queues */
+    Four*		prev;
+    Four*		where;		/* queue of each buffer element */
+    BfMFrameList	queue[4];	/* queues indexed by TWOQ_FREE ... TWOQ_AM */
+    BfMGhostDir		a1out;		/* keys evicted from A1in */
+    Four		kin;		/* target size of A1in */
+} TwoQState;
+
+#define TWOQ_STATE(type)	((TwoQState *)BI_POLICYSTATE(type))
+
+
+
+/*@================================
+ * edubfm_TwoQMove()
+ *================================*/
+/*
+ * Description:
+ *  Move the buffer element to the head of the queue 'q'.
+ */
+static void edubfm_TwoQMove(
+    TwoQState	*s,			/* INOUT policy state */
+    Four	index,			/* IN buffer element */
+    Four	q)			/* IN destination queue */
+{
+    if (s->where[index] != TWOQ_NONE)
+        edubfm_ListRemove(&s->queue[s->where[index]], s->next, s->prev, index);
+
+    s->where[index] = q;
+    if (q != TWOQ_NONE)
+        edubfm_ListPushHead(&s->queue[q], s->next, s->prev, index);
+
+} /* edubfm_TwoQMove() */
+
+
+
+/*@================================
+ * edubfm_TwoQInit()
+ *================================*/
+static Four edubfm_TwoQInit(
+    Four	type)			/* IN buffer type */
+{
+    TwoQState	*s;
+    Four	n = BI_NBUFS(type);
+    Four	i;
+    Four	e;
+
+
+    s = (TwoQState *)calloc(1, sizeof(TwoQState));
+    if (s == NULL) ERR(eMEMORYALLOCERR_EDUBFM);
+
+    s->next = (Four *)malloc(sizeof(Four) * n);
+    s->prev = (Four *)malloc(sizeof(Four) * n);
+    s->where = (Four *)calloc(n, sizeof(Four));
+    if (s->next == NULL || s->prev == NULL || s->where == NULL)
+    {
+        free(s->next); free(s->prev); free(s->where); free(s);
+        ERR(eMEMORYALLOCERR_EDUBFM);
+    }
+
+    /* Kin = 25% and Kout = 50% of the buffer pool as suggested by the paper */
+    s->kin = n / 4 > 0 ? n / 4 : 1;
+    e = edubfm_GhostInit(&s->a1out, n / 2);
+    if (e < 0)
+    {
+        free(s->next); free(s->prev); free(s->where); free(s);
+        ERR(e);
+    }
+
+    for (i = 0; i < 4; i++)
+        edubfm_ListInit(&s->queue[i]);
+
+    /* trains already in the buffer pool are regarded as read once */
+    for (i = 0; i < n; i++)
+        edubfm_TwoQMove(s, i, BI_KEY(type, i).pageNo == NIL ? TWOQ_FREE : TWOQ_A1IN);
+
+    BI_POLICYSTATE(type) = s;
+
+    return(eNOERROR);
+
+} /* edubfm_TwoQInit() */
+
+
+
+/*@================================
+ * edubfm_TwoQFinal()
+ *================================*/
+static void edubfm_TwoQFinal(
+    Four	type)			/* IN buffer type */
+{
+    TwoQState	*s = TWOQ_STATE(type);
+
+
+    if (s == NULL) return;
+
+    edubfm_GhostFinal(&s->a1out);
+    free(s->next);
+    free(s->prev);
+    free(s->where);
+    free(s);
+    BI_POLICYSTATE(type) = NULL;
+
+} /* edubfm_TwoQFinal() */
+
+
+
+/*@================================
+ * edubfm_TwoQHit()
+ *================================*/
+static void edubfm_TwoQHit(
+    Four	type,			/* IN buffer type */
+    Four	index)			/* IN buffer element */
+{
+    TwoQState	*s = TWOQ_STATE(type);
+
+
+    if (s->where[index] == TWOQ_AM ||
+        (s->where[index] == TWOQ_A1IN && BI_LIVES(type, index) > 0))
+        edubfm_TwoQMove(s, index, TWOQ_AM);
+
+} /* edubfm_TwoQHit() */
+
+
+
+/*@================================
+ * edubfm_TwoQLoad()
+ *================================*/
+static void edubfm_TwoQLoad(
+    Four	type,			/* IN buffer type */
+    Four	index,			/* IN buffer element */
+    BfMHashKey	*key)			/* IN train read */
+{
+    TwoQState	*s = TWOQ_STATE(type);
+    Four	g;
+
+
+    g = edubfm_GhostFind(&s->a1out, key);
+    if (g != NIL)
+    {
+        edubfm_GhostRemove(&s->a1out, g);
+        edubfm_TwoQMove(s, index, TWOQ_AM);
+    }
+    else
+        edubfm_TwoQMove(s, index, TWOQ_A1IN);
+
+} /* edubfm_TwoQLoad() */
+
+
+
+/*@================================
+ * edubfm_TwoQClaimFromTail()
+ *================================*/
+/*
+ * Description:
+ *  Claim the least recent unfixed buffer element of the queue.
+ *
+ * Returns:
+ *  index of the claimed buffer element, NIL if there is none
+ */
+static Four edubfm_TwoQClaimFromTail(
+    Four	type,			/* IN buffer type */
+    TwoQState	*s,			/* IN policy state */
+    Four	q)			/* IN queue */
+{
+    Four	i;
+
+
+    for (i = s->queue[q].tail; i != NIL; i = s->prev[i])
+        if (BI_FIXED_LOAD(type, i) == 0 && edubfm_ClaimBuffer(type, i)) return(i);
+
+    return(NIL);
+
+} /* edubfm_TwoQClaimFromTail() */
+
+
+
+/*@================================
+ * edubfm_TwoQVictim()
+ *================================*/
+/*
+ * Description:
+ *  Claim an empty buffer element if any; otherwise evict from A1in while
+ *  it is larger than Kin, and from Am otherwise.
+ */
+static Four edubfm_TwoQVictim(
+    Four	type,			/* IN buffer type */
+    BfMHashKey	*key)			/* IN train to be read */
+{
+    TwoQState	*s = TWOQ_STATE(type);
+    Four	first, second;		/* queues in the order they are tried */
+    Four	i;
+
+
+    i = edubfm_TwoQClaimFromTail(type, s, TWOQ_FREE);
+    if (i != NIL) return(i);
+
+    if (s->queue[TWOQ_A1IN].size > s->kin || s->queue[TWOQ_AM].size == 0)
+    {
+        first = TWOQ_A1IN; second = TWOQ_AM;
+    }
+    else
+    {
+        first = TWOQ_AM; second = TWOQ_A1IN;
+    }
+
+    i = edubfm_TwoQClaimFromTail(type, s, first);
+    if (i != NIL) return(i);
+
+    i = edubfm_TwoQClaimFromTail(type, s, second);
+    if (i != NIL) return(i);
+
+    ERR(eNOUNFIXEDBUF_BFM);
+
+} /* edubfm_TwoQVictim() */
+
+
+
+/*@================================
+ * edubfm_TwoQEvict()
+ *================================*/
+static void edubfm_TwoQEvict(
+    Four	type,			/* IN buffer type */
+    Four	index,			/* IN buffer element */
+    BfMHashKey	*key)			/* IN train forced out */
+{
+    TwoQState	*s = TWOQ_STATE(type);
+
+
+    if (s->where[index] == TWOQ_A1IN && key->pageNo != NIL)
+        edubfm_GhostInsert(&s->a1out, key, TWOQ_A1OUT);
+
+    edubfm_TwoQMove(s, index, TWOQ_NONE);
+
+} /* edubfm_TwoQEvict() */
+
+
+
+/*@================================
+ * edubfm_TwoQRelease()
+ *================================*/
+static void edubfm_TwoQRelease(
+    Four	type,			/* IN buffer type */
+    Four	index)			/* IN buffer element */
+{
+    edubfm_TwoQMove(TWOQ_STATE(type), index, TWOQ_FREE);
+
+} /* edubfm_TwoQRelease() */
+
+
+BfMReplacementPolicy edubfm_twoQPolicy = {
+    "2Q", TRUE,
+    edubfm_TwoQInit, edubfm_TwoQFinal, edubfm_TwoQHit, edubfm_TwoQLoad,
+    edubfm_TwoQVictim, edubfm_TwoQEvict, edubfm_TwoQRelease
+};
@@ -0,0 +1,338 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_PolicyARC.c
+ *
+ * Description:
+ *  The Adaptive Replacement Cache policy (Megiddo & Modha, FAST 2003).
+ *  Resident trains are kept in T1 (read once recently) and T2 (fixed again
+ *  while resident or read again soon after eviction); the keys of trains
+ *  evicted from T1 and T2 are remembered in the ghost lists B1 and B2.
+ *  A read of a train in B1 (B2) moves the target size p of T1 up (down).
+ *
+ * Exports:
+ *  BfMReplacementPolicy edubfm_arcPolicy
+ */
+
+
+#include <stdlib.h> /* for malloc & free */
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+/*@
+ * constant and type definitions
+ */
+/* lists a buffer element belongs to */
+#define ARC_NONE	0	/* claimed and not yet loaded */
+#define ARC_FREE	1
+#define ARC_T1		2
+#define ARC_T2		3
+
+/* ghost lists */
+#define ARC_B1		0
+#define ARC_B2		1
+
+typedef struct {
+    Four*		next;		/* links of the lists */
+    Four*		prev;
+    Four*		where;		/* list of each buffer element */
+    BfMFrameList	list[4];	/* lists indexed by ARC_FREE ... ARC_T2 */
+    BfMGhostDir		ghost;		/* B1 and B2 */
+    Four		p;		/* target size of T1 */
+} ARCState;
+
+#define ARC_STATE(type)		((ARCState *)BI_POLICYSTATE(type))
+
+
+
+/*@================================
+ * edubfm_ARCMove()
+ *================================*/
+/*
+ * Description:
+ *  Move the buffer element to the head (MRU end) of the list 'l'.
+ */
+static void edubfm_ARCMove(
+    ARCState	*s,			/* INOUT policy state */
+    Four	index,			/* IN buffer element */
+    Four	l)			/* IN destination list */
+{
+    if (s->where[index] != ARC_NONE)
+        edubfm_ListRemove(&s->list[s->where[index]], s->next, s->prev, index);
+
+    s->where[index] = l;
+    if (l != ARC_NONE)
+        edubfm_ListPushHead(&s->list[l], s->next, s->prev, index);
+
+} /* edubfm_ARCMove() */
+
+
+
+/*@================================
+ * edubfm_ARCInit()
+ *================================*/
+static Four edubfm_ARCInit(
+    Four	type)			/* IN buffer type */
+{
+    ARCState	*s;
+    Four	n = BI_NBUFS(type);
+    Four	i;
+    Four	e;
+
+
+    s = (ARCState *)calloc(1, sizeof(ARCState));
+    if (s == NULL) ERR(eMEMORYALLOCERR_EDUBFM);
+
+    s->next = (Four *)malloc(sizeof(Four) * n);
+    s->prev = (Four *)malloc(sizeof(Four) * n);
+    s->where = (Four *)calloc(n, sizeof(Four));
+    if (s->next == NULL || s->prev == NULL || s->where == NULL)
+    {
+        free(s->next); free(s->prev); free(s->where); free(s);
+        ERR(eMEMORYALLOCERR_EDUBFM);
+    }
+
+    /* |B1| + |B2| <= c, so that the directory covers 2c trains in total */
+    e = edubfm_GhostInit(&s->ghost, n);
+    if (e < 0)
+    {
+        free(s->next); free(s->prev); free(s->where); free(s);
+        ERR(e);
+    }
+
+    for (i = 0; i < 4; i++)
+        edubfm_ListInit(&s->list[i]);
+    s->p = 0;
+
+    /* trains already in the buffer pool are regarded as read once */
+    for (i = 0; i < n; i++)
+        edubfm_ARCMove(s, i, BI_KEY(type, i).pageNo == NIL ? ARC_FREE : ARC_T1);
+
+    BI_POLICYSTATE(type) = s;
+
+    return(eNOERROR);
+
+} /* edubfm_ARCInit() */
+
+
+
+/*@================================
+ * edubfm_ARCFinal()
+ *================================*/
+static void edubfm_ARCFinal(
+    Four	type)			/* IN buffer type */
+{
+    ARCState	*s = ARC_STATE(type);
+
+
+    if (s == NULL) return;
+
+    edubfm_GhostFinal(&s->ghost);
+    free(s->next);
+    free(s->prev);
+    free(s->where);
+    free(s);
+    BI_POLICYSTATE(type) = NULL;
+
+} /* edubfm_ARCFinal() */
+
+
+
+/*@================================
+ * edubfm_ARCHit()
+ *================================*/
+static void edubfm_ARCHit(
+    Four	type,			/* IN buffer type */
+    Four	index)			/* IN buffer element */
+{
+    ARCState	*s = ARC_STATE(type);
+
+
+    if (s->where[index] == ARC_T1 || s->where[index] == ARC_T2)
+        edubfm_ARCMove(s, index, ARC_T2);
+
+} /* edubfm_ARCHit() */
+
+
+
+/*@================================
+ * edubfm_ARCLoad()
+ *================================*/
+/*
+ * Description:
+ *  Adapt p if the train has been found in a ghost list and put the train
+ *  into T2; otherwise put it into T1.
+ */
+static void edubfm_ARCLoad(
+    Four	type,			/* IN buffer type */
+    Four	index,			/* IN buffer element */
+    BfMHashKey	*key)			/* IN train read */
+{
+    ARCState	*s = ARC_STATE(type);
+    Four	c = BI_NBUFS(type);
+    Four	b1 = s->ghost.list[ARC_B1].size;
+    Four	b2 = s->ghost.list[ARC_B2].size;
+    Four	g;
+
+
+    g = edubfm_GhostFind(&s->ghost, key);
+    if (g == NIL)
+    {
+        /* keep |T1| + |B1| <= c */
+        if (s->list[ARC_T1].size + b1 >= c)
+            edubfm_GhostRemoveOldest(&s->ghost, ARC_B1);
+
+        edubfm_ARCMove(s, index, ARC_T1);
+        return;
+    }
+
+    if (s->ghost.entry[g].list == ARC_B1)
+        s->p = MIN(c, s->p + MAX(1, b2 / b1));
+    else
+        s->p = MAX(0, s->p - MAX(1, b1 / b2));
+
+    edubfm_GhostRemove(&s->ghost, g);
+    edubfm_ARCMove(s, index, ARC_T2);
+
+} /* edubfm_ARCLoad() */
+
+
+
+/*@================================
+ * edubfm_ARCClaimFromTail()
+ *================================*/
+/*
+ * Description:
+ *  Claim the least recent unfixed buffer element of the list.
+ *
+ * Returns:
+ *  index of the claimed buffer element, NIL if there is none
+ */
+static Four edubfm_ARCClaimFromTail(
+    Four	type,			/* IN buffer type */
+    ARCState	*s,			/* IN policy state */
+    Four	l)			/* IN list */
+{
+    Four	i;
+
+
+    for (i = s->list[l].tail; i != NIL; i = s->prev[i])
+        if (BI_FIXED_LOAD(type, i) == 0 && edubfm_ClaimBuffer(type, i)) return(i);
+
+    return(NIL);
+
+} /* edubfm_ARCClaimFromTail() */
+
+
+
+/*@================================
+ * edubfm_ARCVictim()
+ *================================*/
+/*
+ * Description:
+ *  Claim an empty buffer element if any; otherwise REPLACE of the paper:
+ *  evict from T1 if |T1| exceeds p (or equals p and the train to be read
+ *  is in B2), and from T2 otherwise.
+ */
+static Four edubfm_ARCVictim(
+    Four	type,			/* IN buffer type */
+    BfMHashKey	*key)			/* IN train to be read */
+{
+    ARCState	*s = ARC_STATE(type);
+    Four	t1 = s->list[ARC_T1].size;
+    Four	first, second;		/* lists in the order they are tried */
+    Four	g;
+    Four	i;
+
+
+    i = edubfm_ARCClaimFromTail(type, s, ARC_FREE);
+    if (i != NIL) return(i);
+
+    g = edubfm_GhostFind(&s->ghost, key);
+
+    if (t1 > 0 && (t1 > s->p || (t1 == s->p && g != NIL && s->ghost.entry[g].list == ARC_B2)))
+    {
+        first = ARC_T1; second = ARC_T2;
+    }
+    else
+    {
+        first = ARC_T2; second = ARC_T1;
+    }
+
+    i = edubfm_ARCClaimFromTail(type, s, first);
+    if (i != NIL) return(i);
+
+    i = edubfm_ARCClaimFromTail(type, s, second);
+    if (i != NIL) return(i);
+
+    ERR(eNOUNFIXEDBUF_BFM);
+
+} /* edubfm_ARCVictim() */
+
+
+
+/*@================================
+ * edubfm_ARCEvict()
+ *================================*/
+static void edubfm_ARCEvict(
+    Four	type,			/* IN buffer type */
+    Four	index,			/* IN buffer element */
+    BfMHashKey	*key)			/* IN train forced out */
+{
+    ARCState	*s = ARC_STATE(type);
+
+
+    if (key->pageNo != NIL)
+    {
+        if (s->where[index] == ARC_T1)
+            edubfm_GhostInsert(&s->ghost, key, ARC_B1);
+        else if (s->where[index] == ARC_T2)
+            edubfm_GhostInsert(&s->ghost, key, ARC_B2);
+    }
+
+    edubfm_ARCMove(s, index, ARC_NONE);
+
+} /* edubfm_ARCEvict() */
+
+
+
+/*@================================
+ * edubfm_ARCRelease()
+ *================================*/
+static void edubfm_ARCRelease(
+    Four	type,			/* IN buffer type */
+    Four	index)			/* IN buffer element */
+{
+    edubfm_ARCMove(ARC_STATE(type), index, ARC_FREE);
+
+} /* edubfm_ARCRelease() */
+
+
+BfMReplacementPolicy edubfm_arcPolicy = {
+    "ARC", TRUE,
+    edubfm_ARCInit, edubfm_ARCFinal, edubfm_ARCHit, edubfm_ARCLoad,
+    edubfm_ARCVictim, edubfm_ARCEvict, edubfm_ARCRelease
+};
@@ -0,0 +1,140 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_PolicyClock.c
+ *
+ * Description:
+ *  The second chance (clock) buffer replacement policy, the default policy
+ *  of EduBfM. It keeps no state besides the REFER bits and the clock hand
+ *  of the buffer pool, so its functions need no latch.
+ *
+ * Exports:
+ *  BfMReplacementPolicy edubfm_clockPolicy
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * edubfm_ClockVictim()
+ *================================*/
+/*
+ * Function: static Four edubfm_ClockVictim(Four, BfMHashKey *)
+ *
+ * Description:
+ *  Select a victim with the second chance algorithm. If the reference bit
+ *  of the current checking entry (indicated by BI_NEXTVICTIM(type)) is set,
+ *  then simply clear the bit for the second chance and proceed to the next
+ *  entry, otherwise claim the current entry.
+ *  While the background writer is running, unreferenced dirty entries are
+ *  passed over and left to the writer, unless a whole round of the clock
+ *  has found nothing else.
+ *
+ * Returns:
+ *  index of the claimed buffer element, or error code
+ *    eNOUNFIXEDBUF_BFM - There is no unfixed buffer.
+ */
+static Four edubfm_ClockVictim(
+    Four	type,			/* IN buffer type */
+    BfMHashKey	*key)			/* IN train to be read */
+{
+    Four	i, j;
+    Four	fixCount = 0;
+    Four	dirtyCount = 0;		/* # of dirty entries passed over */
+    UEight	sweep = 0;		/* # of entries passed by the clock hand */
+
+
+    while (1)
+    {
+        i = edubfm_AdvanceClockHand(type);
+        sweep++;
+
+        if (BI_FIXED_LOAD(type, i) != 0)
+        {
+            fixCount += 1;
+            if (fixCount == BI_NBUFS_LOAD(type))
+            {
+                /* The hand is shared, so the other threads may have passed
+                 * the unfixed entries; look at all entries before giving up.
+                 * The entries being drained by a shrink look fixed, too. */
+                for (j = 0; j < BI_NBUFS_LOAD(type) && BI_FIXED_LOAD(type, j) != 0; j++);
+                if (j == BI_NBUFS_LOAD(type)) ERR (eNOUNFIXEDBUF_BFM);
+                fixCount = 0;
+            }
+            continue;
+        }
+        fixCount = 0;   /* count the fixed entries met in a row */
+
+        if (BI_BITS_LOAD(type, i) & REFER) // Check Refer bit is 1
+        {
+            BI_CLEAR_BITS(type, i, REFER);
+            continue;
+        }
+
+        if (BI_BITS_LOAD(type, i) & HOT)   // a hot entry gets one more chance
+        {
+            BI_CLEAR_BITS(type, i, HOT);
+            continue;
+        }
+
+        if ((BI_BITS_LOAD(type, i) & DIRTY) && BI_BGWRITER_ACTIVE(type) &&
+            dirtyCount < BI_NBUFS_LOAD(type))
+        {
+            if (dirtyCount++ == 0) edubfm_WakeBgWriter(type);
+            continue;
+        }
+
+        // If Refer bit is 0, take the buffer element exclusively
+        if (edubfm_ClaimBuffer(type, i))
+        {
+            edubfm_HistAdd(&bufStats[type].sweep, sweep);
+            return(i);
+        }
+    }
+
+} /* edubfm_ClockVictim() */
+
+
+
+/*@
+ * The events other than the victim selection need no bookkeeping;
+ * GetTrain sets the REFER bit of a fixed buffer element itself.
+ */
+static Four edubfm_ClockInit(Four type) { return(eNOERROR); }
+static void edubfm_ClockFinal(Four type) { }
+static void edubfm_ClockHit(Four type, Four index) { }
+static void edubfm_ClockLoad(Four type, Four index, BfMHashKey *key) { }
+static void edubfm_ClockEvict(Four type, Four index, BfMHashKey *key) { }
+static void edubfm_ClockRelease(Four type, Four index) { }
+
+
+BfMReplacementPolicy edubfm_clockPolicy = {
+    "CLOCK", FALSE,
+    edubfm_ClockInit, edubfm_ClockFinal, edubfm_ClockHit, edubfm_ClockLoad,
+    edubfm_ClockVictim, edubfm_ClockEvict, edubfm_ClockRelease
+};
@@ -0,0 +1,355 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_PolicyClockPro.c
+ *
+ * Description:
+ *  A simplified CLOCK-Pro buffer replacement policy (Jiang et al., USENIX
+ *  ATC 2005). Resident trains are hot or cold; a cold train is evicted by
+ *  the cold hand unless it has been fixed since the hand passed it, and a
+ *  cold train fixed during its test period becomes hot. The hot hand turns
+ *  unreferenced hot trains cold whenever there are more than (nBufs - mc)
+ *  hot trains. The keys of cold trains evicted in their test period are
+ *  kept in a bounded non-resident list; reading such a train again makes it
+ *  hot and grows mc, and a test period expiring from the list shrinks mc.
+ *  Both hands sweep the buffer table in the order of the array index.
+ *
+ * Exports:
+ *  BfMReplacementPolicy edubfm_clockProPolicy
+ */
+
+
+#include <stdlib.h> /* for malloc & free */
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+/*@
+ * constant and type definitions
+ */
+/* status of a buffer element */
+#define CP_NONE		0	/* claimed and not yet loaded */
+#define CP_FREE		1
+#define CP_COLD		2
+#define CP_HOT		3
+
+#define CP_NONRESIDENT	0	/* ghost list of the non-resident cold trains */
+
+typedef struct {
+    One*	status;			/* status of each buffer element */
+    Boolean*	ref;			/* fixed since the last pass of a hand? */
+    Boolean*	test;			/* cold train in its test period? */
+    Four	nHot;			/* # of hot trains */
+    Four	mc;			/* target # of resident cold trains */
+    Four	handCold;
+    Four	handHot;
+    BfMGhostDir	nonResident;		/* cold trains evicted in their test period */
+} ClockProState;
+
+#define CP_STATE(type)		((ClockProState *)BI_POLICYSTATE(type))
+
+
+
+/*@================================
+ * edubfm_ClockProInit()
+ *================================*/
+static Four edubfm_ClockProInit(
+    Four		type)		/* IN buffer type */
+{
+    ClockProState	*s;
+    Four		n = BI_NBUFS(type);
+    Four		i;
+    Four		e;
+
+
+    s = (ClockProState *)calloc(1, sizeof(ClockProState));
+    if (s == NULL) ERR(eMEMORYALLOCERR_EDUBFM);
+
+    s->status = (One *)calloc(n, sizeof(One));
+    s->ref = (Boolean *)calloc(n, sizeof(Boolean));
+    s->test = (Boolean *)calloc(n, sizeof(Boolean));
+    if (s->status == NULL || s->ref == NULL || s->test == NULL)
+    {
+        free(s->status); free(s->ref); free(s->test); free(s);
+        ERR(eMEMORYALLOCERR_EDUBFM);
+    }
+
+    e = edubfm_GhostInit(&s->nonResident, n);
+    if (e < 0)
+    {
+        free(s->status); free(s->ref); free(s->test); free(s);
+        ERR(e);
+    }
+
+    /* start with 10% of the buffer pool for cold trains */
+    s->mc = MAX(1, n / 10);
+    s->nHot = 0;
+    s->handCold = 0;
+    s->handHot = 0;
+
+    for (i = 0; i < n; i++)
+        s->status[i] = (BI_KEY(type, i).pageNo == NIL) ? CP_FREE : CP_COLD;
+
+    BI_POLICYSTATE(type) = s;
+
+    return(eNOERROR);
+
+} /* edubfm_ClockProInit() */
+
+
+
+/*@================================
+ * edubfm_ClockProFinal()
+ *================================*/
+static void edubfm_ClockProFinal(
+    Four		type)		/* IN buffer type */
+{
+    ClockProState	*s = CP_STATE(type);
+
+
+    if (s == NULL) return;
+
+    edubfm_GhostFinal(&s->nonResident);
+    free(s->status);
+    free(s->ref);
+    free(s->test);
+    free(s);
+    BI_POLICYSTATE(type) = NULL;
+
+} /* edubfm_ClockProFinal() */
+
+
+
+/*@================================
+ * edubfm_ClockProRunHotHand()
+ *================================*/
+/*
+ * Description:
+ *  Turn hot trains cold until there are at most (nBufs - mc) hot trains.
+ *  If 'force' is TRUE, turn at least one hot train cold.
+ */
+static void edubfm_ClockProRunHotHand(
+    Four		type,		/* IN buffer type */
+    ClockProState	*s,		/* INOUT policy state */
+    Boolean		force)		/* IN demote at least one? */
+{
+    Four		n = BI_NBUFS(type);
+    Four		i;
+
+
+    while (s->nHot > 0 && (force || s->nHot > n - s->mc))
+    {
+        i = s->handHot;
+        s->handHot = (i + 1) % n;
+
+        if (s->status[i] != CP_HOT) continue;
+
+        if (s->ref[i])
+        {
+            s->ref[i] = FALSE;
+            continue;
+        }
+
+        s->status[i] = CP_COLD;
+        s->test[i] = FALSE;
+        s->nHot--;
+        force = FALSE;
+    }
+
+} /* edubfm_ClockProRunHotHand() */
+
+
+
+/*@================================
+ * edubfm_ClockProHit()
+ *================================*/
+static void edubfm_ClockProHit(
+    Four		type,		/* IN buffer type */
+    Four		index)		/* IN buffer element */
+{
+    CP_STATE(type)->ref[index] = TRUE;
+
+} /* edubfm_ClockProHit() */
+
+
+
+/*@================================
+ * edubfm_ClockProLoad()
+ *================================*/
+static void edubfm_ClockProLoad(
+    Four		type,		/* IN buffer type */
+    Four		index,		/* IN buffer element */
+    BfMHashKey		*key)		/* IN train read */
+{
+    ClockProState	*s = CP_STATE(type);
+    Four		g;
+
+
+    s->ref[index] = FALSE;
+
+    g = edubfm_GhostFind(&s->nonResident, key);
+    if (g != NIL)
+    {
+        /* re-read within the test period: the cold allocation was too small */
+        edubfm_GhostRemove(&s->nonResident, g);
+        s->mc = MIN(BI_NBUFS(type) - 1, s->mc + 1);
+        s->status[index] = CP_HOT;
+        s->test[index] = FALSE;
+        s->nHot++;
+        edubfm_ClockProRunHotHand(type, s, FALSE);
+    }
+    else
+    {
+        s->status[index] = CP_COLD;
+        s->test[index] = TRUE;
+    }
+
+} /* edubfm_ClockProLoad() */
+
+
+
+/*@================================
+ * edubfm_ClockProVictim()
+ *================================*/
+/*
+ * Description:
+ *  Run the cold hand until an empty or unreferenced cold buffer element
+ *  is claimed. If a whole sweep finds no victim, turn a hot train cold
+ *  and sweep again.
+ */
+static Four edubfm_ClockProVictim(
+    Four		type,		/* IN buffer type */
+    BfMHashKey		*key)		/* IN train to be read */
+{
+    ClockProState	*s = CP_STATE(type);
+    Four		n = BI_NBUFS(type);
+    Four		i;
+    Four		step;
+    Four		fixCount;
+
+
+    while (1)
+    {
+        fixCount = 0;
+
+        for (step = 0; step < n; step++)
+        {
+            i = s->handCold;
+            s->handCold = (i + 1) % n;
+
+            if (BI_FIXED_LOAD(type, i) != 0)
+            {
+                fixCount++;
+                continue;
+            }
+
+            if (s->status[i] == CP_FREE)
+            {
+                if (edubfm_ClaimBuffer(type, i)) return(i);
+                continue;
+            }
+
+            if (s->status[i] != CP_COLD) continue;
+
+            if (s->ref[i])
+            {
+                s->ref[i] = FALSE;
+                if (s->test[i])
+                {
+                    s->status[i] = CP_HOT;
+                    s->test[i] = FALSE;
+                    s->nHot++;
+                    edubfm_ClockProRunHotHand(type, s, FALSE);
+                }
+                else
+                    s->test[i] = TRUE;
+                continue;
+            }
+
+            if (edubfm_ClaimBuffer(type, i)) return(i);
+        }
+
+        if (fixCount == n) ERR(eNOUNFIXEDBUF_BFM);
+
+        edubfm_ClockProRunHotHand(type, s, TRUE);
+    }
+
+} /* edubfm_ClockProVictim() */
+
+
+
+/*@================================
+ * edubfm_ClockProEvict()
+ *================================*/
+static void edubfm_ClockProEvict(
+    Four		type,		/* IN buffer type */
+    Four		index,		/* IN buffer element */
+    BfMHashKey		*key)		/* IN train forced out */
+{
+    ClockProState	*s = CP_STATE(type);
+
+
+    if (s->status[index] == CP_COLD && s->test[index] && key->pageNo != NIL)
+    {
+        /* the oldest test period expires without a re-read */
+        if (s->nonResident.freeEntry == NIL)
+            s->mc = MAX(1, s->mc - 1);
+        edubfm_GhostInsert(&s->nonResident, key, CP_NONRESIDENT);
+    }
+
+    if (s->status[index] == CP_HOT) s->nHot--;
+
+    s->status[index] = CP_NONE;
+    s->ref[index] = FALSE;
+    s->test[index] = FALSE;
+
+} /* edubfm_ClockProEvict() */
+
+
+
+/*@================================
+ * edubfm_ClockProRelease()
+ *================================*/
+static void edubfm_ClockProRelease(
+    Four		type,		/* IN buffer type */
+    Four		index)		/* IN buffer element */
+{
+    ClockProState	*s = CP_STATE(type);
+
+
+    if (s->status[index] == CP_HOT) s->nHot--;
+
+    s->status[index] = CP_FREE;
+    s->ref[index] = FALSE;
+    s->test[index] = FALSE;
+
+} /* edubfm_ClockProRelease() */
+
+
+BfMReplacementPolicy edubfm_clockProPolicy = {
+    "CLOCK-Pro", TRUE,
+    edubfm_ClockProInit, edubfm_ClockProFinal, edubfm_ClockProHit, edubfm_ClockProLoad,
+    edubfm_ClockProVictim, edubfm_ClockProEvict, edubfm_ClockProRelease
+};
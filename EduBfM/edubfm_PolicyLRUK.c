@@ -0,0 +1,232 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_PolicyLRUK.c
+ *
+ * Description:
+ *  The LRU-K buffer replacement policy (O'Neil et al., SIGMOD 1993) with
+ *  K = LRUK_K. The victim is the unfixed buffer element whose K-th most
+ *  recent reference is the oldest; elements referenced less than K times
+ *  are evicted first, in LRU order. The reference history of a train is
+ *  dropped when it is evicted, and the victim is found by scanning the
+ *  buffer table.
+ *
+ * Exports:
+ *  BfMReplacementPolicy edubfm_lrukPolicy
+ */
+
+
+#include <stdlib.h> /* for malloc & free */
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+/*@
+ * constant and type definitions
+ */
+#define LRUK_K 2
+
+typedef struct {
+    UEight	now;		/* logical time of the last reference */
+    UEight*	hist;		/* hist[idx*LRUK_K + j]: time of the (j+1)-th most recent reference */
+} LRUKState;
+
+#define LRUK_STATE(type)	((LRUKState *)BI_POLICYSTATE(type))
+#define LRUK_HIST(type, idx)	(&LRUK_STATE(type)->hist[(idx) * LRUK_K])
+
+
+
+/*@================================
+ * edubfm_LRUKInit()
+ *================================*/
+static Four edubfm_LRUKInit(
+    Four	type)			/* IN buffer type */
+{
+    LRUKState	*s;
+
+
+    s = (LRUKState *)malloc(sizeof(LRUKState));
+    if (s == NULL) ERR(eMEMORYALLOCERR_EDUBFM);
+
+    s->now = 0;
+    s->hist = (UEight *)calloc(BI_NBUFS(type) * LRUK_K, sizeof(UEight));
+    if (s->hist == NULL)
+    {
+        free(s);
+        ERR(eMEMORYALLOCERR_EDUBFM);
+    }
+
+    BI_POLICYSTATE(type) = s;
+
+    return(eNOERROR);
+
+} /* edubfm_LRUKInit() */
+
+
+
+/*@================================
+ * edubfm_LRUKFinal()
+ *================================*/
+static void edubfm_LRUKFinal(
+    Four	type)			/* IN buffer type */
+{
+    if (LRUK_STATE(type) == NULL) return;
+
+    free(LRUK_STATE(type)->hist);
+    free(LRUK_STATE(type));
+    BI_POLICYSTATE(type) = NULL;
+
+} /* edubfm_LRUKFinal() */
+
+
+
+/*@================================
+ * edubfm_LRUKHit()
+ *================================*/
+static void edubfm_LRUKHit(
+    Four	type,			/* IN buffer type */
+    Four	index)			/* IN buffer element */
+{
+    UEight	*hist = LRUK_HIST(type, index);
+    Four	j;
+
+
+    for (j = LRUK_K - 1; j > 0; j--)
+        hist[j] = hist[j-1];
+    hist[0] = ++LRUK_STATE(type)->now;
+
+} /* edubfm_LRUKHit() */
+
+
+
+/*@================================
+ * edubfm_LRUKLoad()
+ *================================*/
+static void edubfm_LRUKLoad(
+    Four	type,			/* IN buffer type */
+    Four	index,			/* IN buffer element */
+    BfMHashKey	*key)			/* IN train read */
+{
+    UEight	*hist = LRUK_HIST(type, index);
+    Four	j;
+
+
+    for (j = 1; j < LRUK_K; j++)
+        hist[j] = 0;
+    hist[0] = ++LRUK_STATE(type)->now;
+
+} /* edubfm_LRUKLoad() */
+
+
+
+/*@================================
+ * edubfm_LRUKVictim()
+ *================================*/
+/*
+ * Description:
+ *  Claim the unfixed buffer element with the largest backward K-distance.
+ *  Empty elements are taken first.
+ */
+static Four edubfm_LRUKVictim(
+    Four	type,			/* IN buffer type */
+    BfMHashKey	*key)			/* IN train to be read */
+{
+    Four	i;
+    Four	best;			/* best candidate so far */
+    UEight	*hist;
+    UEight	*bestHist;
+
+
+    while (1)
+    {
+        best = NIL;
+        bestHist = NULL;
+
+        for (i = 0; i < BI_NBUFS(type); i++)
+        {
+            if (BI_FIXED_LOAD(type, i) != 0) continue;
+
+            if (BI_KEY(type, i).pageNo == NIL)
+            {
+                best = i;
+                break;
+            }
+
+            hist = LRUK_HIST(type, i);
+            if (best == NIL ||
+                hist[LRUK_K-1] < bestHist[LRUK_K-1] ||
+                (hist[LRUK_K-1] == bestHist[LRUK_K-1] && hist[0] < bestHist[0]))
+            {
+                best = i;
+                bestHist = hist;
+            }
+        }
+
+        if (best == NIL) ERR(eNOUNFIXEDBUF_BFM);
+
+        /* retry if another thread has fixed the candidate in the meantime */
+        if (edubfm_ClaimBuffer(type, best)) return(best);
+    }
+
+} /* edubfm_LRUKVictim() */
+
+
+
+/*@================================
+ * edubfm_LRUKEvict()
+ *================================*/
+static void edubfm_LRUKEvict(
+    Four	type,			/* IN buffer type */
+    Four	index,			/* IN buffer element */
+    BfMHashKey	*key)			/* IN train forced out */
+{
+    UEight	*hist = LRUK_HIST(type, index);
+    Four	j;
+
+
+    for (j = 0; j < LRUK_K; j++)
+        hist[j] = 0;
+
+} /* edubfm_LRUKEvict() */
+
+
+
+/*@================================
+ * edubfm_LRUKRelease()
+ *================================*/
+static void edubfm_LRUKRelease(
+    Four	type,			/* IN buffer type */
+    Four	index)			/* IN buffer element */
+{
+    edubfm_LRUKEvict(type, index, NULL);
+
+} /* edubfm_LRUKRelease() */
+
+
+BfMReplacementPolicy edubfm_lrukPolicy = {
+    "LRU-K", TRUE,
+    edubfm_LRUKInit, edubfm_LRUKFinal, edubfm_LRUKHit, edubfm_LRUKLoad,
+    edubfm_LRUKVictim, edubfm_LRUKEvict, edubfm_LRUKRelease
+};
@@ -0,0 +1,363 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_PolicyList.c
+ *
+ * Description:
+ *  Lists shared by the buffer replacement policies.
+ *  A frame list links buffer elements through 'next'/'prev' arrays indexed
+ *  by the array index of the buffer element. A ghost directory remembers
+ *  the keys of evicted trains in bounded lists and finds them by hashing.
+ *
+ * Exports:
+ *  void edubfm_ListInit(BfMFrameList *)
+ *  void edubfm_ListPushHead(BfMFrameList *, Four *, Four *, Four)
+ *  void edubfm_ListRemove(BfMFrameList *, Four *, Four *, Four)
+ *  Four edubfm_GhostInit(BfMGhostDir *, Four)
+ *  void edubfm_GhostFinal(BfMGhostDir *)
+ *  Four edubfm_GhostFind(BfMGhostDir *, BfMHashKey *)
+ *  void edubfm_GhostInsert(BfMGhostDir *, BfMHashKey *, Four)
+ *  void edubfm_GhostRemove(BfMGhostDir *, Four)
+ *  void edubfm_GhostRemoveOldest(BfMGhostDir *, Four)
+ */
+
+
+#include <stdlib.h> /* for malloc & free */
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+/*@
+ * macro definitions
+ */
+/* Macro: GHOST_HASH(dir, k)
+ * Description: return the hash chain of the key in the ghost directory
+ */
+#define GHOST_HASH(dir, k)	((UFour)((k)->volNo * 40503 + (k)->pageNo) % (UFour)(dir)->capacity)
+
+
+
+/*@================================
+ * edubfm_ListInit()
+ *================================*/
+/*
+ * Function: void edubfm_ListInit(BfMFrameList *)
+ *
+ * Description:
+ *  Make the list empty.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_ListInit(
+    BfMFrameList	*list)		/* INOUT list of buffer elements */
+{
+    list->head = NIL;
+    list->tail = NIL;
+    list->size = 0;
+
+} /* edubfm_ListInit() */
+
+
+
+/*@================================
+ * edubfm_ListPushHead()
+ *================================*/
+/*
+ * Function: void edubfm_ListPushHead(BfMFrameList *, Four *, Four *, Four)
+ *
+ * Description:
+ *  Insert the buffer element at the head of the list.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_ListPushHead(
+    BfMFrameList	*list,		/* INOUT list of buffer elements */
+    Four		*next,		/* INOUT links toward the tail */
+    Four		*prev,		/* INOUT links toward the head */
+    Four		index)		/* IN buffer element to insert */
+{
+    prev[index] = NIL;
+    next[index] = list->head;
+
+    if (list->head != NIL) prev[list->head] = index;
+    else list->tail = index;
+
+    list->head = index;
+    list->size++;
+
+} /* edubfm_ListPushHead() */
+
+
+
+/*@================================
+ * edubfm_ListRemove()
+ *================================*/
+/*
+ * Function: void edubfm_ListRemove(BfMFrameList *, Four *, Four *, Four)
+ *
+ * Description:
+ *  Remove the buffer element from the list it belongs to.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_ListRemove(
+    BfMFrameList	*list,		/* INOUT list of buffer elements */
+    Four		*next,		/* INOUT links toward the tail */
+    Four		*prev,		/* INOUT links toward the head */
+    Four		index)		/* IN buffer element to remove */
+{
+    if (prev[index] != NIL) next[prev[index]] = next[index];
+    else list->head = next[index];
+
+    if (next[index] != NIL) prev[next[index]] = prev[index];
+    else list->tail = prev[index];
+
+    next[index] = prev[index] = NIL;
+    list->size--;
+
+} /* edubfm_ListRemove() */
+
+
+
+/*@================================
+ * edubfm_GhostInit()
+ *================================*/
+/*
+ * Function: Four edubfm_GhostInit(BfMGhostDir *, Four)
+ *
+ * Description:
+ *  Allocate a ghost directory holding at most 'capacity' keys.
+ *
+ * Returns:
+ *  error code
+ *    eMEMORYALLOCERR_EDUBFM - memory allocation failed
+ */
+Four edubfm_GhostInit(
+    BfMGhostDir		*dir,		/* OUT ghost directory */
+    Four		capacity)	/* IN max # of keys */
+{
+    Four		i;
+
+
+    if (capacity < 1) capacity = 1;
+
+    dir->capacity = capacity;
+    dir->entry = (BfMGhostEntry *)malloc(sizeof(BfMGhostEntry) * capacity);
+    dir->hashTable = (Four *)malloc(sizeof(Four) * capacity);
+    if (dir->entry == NULL || dir->hashTable == NULL)
+    {
+        edubfm_GhostFinal(dir);
+        ERR(eMEMORYALLOCERR_EDUBFM);
+    }
+
+    for (i = 0; i < capacity; i++)
+    {
+        dir->hashTable[i] = NIL;
+        dir->entry[i].list = NIL;
+        dir->entry[i].next = i + 1 < capacity ? i + 1 : NIL;
+    }
+    dir->freeEntry = 0;
+
+    for (i = 0; i < BFM_MAXGHOSTLISTS; i++)
+        edubfm_ListInit(&dir->list[i]);
+
+    return(eNOERROR);
+
+} /* edubfm_GhostInit() */
+
+
+
+/*@================================
+ * edubfm_GhostFinal()
+ *================================*/
+/*
+ * Function: void edubfm_GhostFinal(BfMGhostDir *)
+ *
+ * Description:
+ *  Free the ghost directory.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_GhostFinal(
+    BfMGhostDir		*dir)		/* INOUT ghost directory */
+{
+    free(dir->entry);
+    free(dir->hashTable);
+    dir->entry = NULL;
+    dir->hashTable = NULL;
+
+} /* edubfm_GhostFinal() */
+
+
+
+/*@================================
+ * edubfm_GhostFind()
+ *================================*/
+/*
+ * Function: Four edubfm_GhostFind(BfMGhostDir *, BfMHashKey *)
+ *
+ * Description:
+ *  Find the ghost entry of the key.
+ *
+ * Returns:
+ *  index of the ghost entry, NIL if the key is not in the directory
+ */
+Four edubfm_GhostFind(
+    BfMGhostDir		*dir,		/* IN ghost directory */
+    BfMHashKey		*key)		/* IN key of an evicted train */
+{
+    Four		i;
+
+
+    for (i = dir->hashTable[GHOST_HASH(dir, key)]; i != NIL; i = dir->entry[i].hashNext)
+        if (EQUALKEY(key, &dir->entry[i].key)) return(i);
+
+    return(NIL);
+
+} /* edubfm_GhostFind() */
+
+
+
+/*@================================
+ * edubfm_GhostInsert()
+ *================================*/
+/*
+ * Function: void edubfm_GhostInsert(BfMGhostDir *, BfMHashKey *, Four)
+ *
+ * Description:
+ *  Insert the key at the head of a ghost list. If the directory is full,
+ *  the oldest entry of that list (or of another list) is dropped.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_GhostInsert(
+    BfMGhostDir		*dir,		/* INOUT ghost directory */
+    BfMHashKey		*key,		/* IN key of an evicted train */
+    Four		list)		/* IN ghost list */
+{
+    Four		i;
+    Four		l;
+    Four		hashValue;
+
+
+    i = edubfm_GhostFind(dir, key);
+    if (i != NIL) edubfm_GhostRemove(dir, i);
+
+    if (dir->freeEntry == NIL)
+    {
+        if (dir->list[list].size > 0)
+            edubfm_GhostRemoveOldest(dir, list);
+        else
+            for (l = 0; l < BFM_MAXGHOSTLISTS; l++)
+                if (dir->list[l].size > 0) { edubfm_GhostRemoveOldest(dir, l); break; }
+    }
+
+    i = dir->freeEntry;
+    dir->freeEntry = dir->entry[i].next;
+
+    dir->entry[i].key = *key;
+    dir->entry[i].list = list;
+
+    hashValue = GHOST_HASH(dir, key);
+    dir->entry[i].hashNext = dir->hashTable[hashValue];
+    dir->hashTable[hashValue] = i;
+
+    /* link the entry at the head of the list */
+    dir->entry[i].prev = NIL;
+    dir->entry[i].next = dir->list[list].head;
+    if (dir->list[list].head != NIL) dir->entry[dir->list[list].head].prev = i;
+    else dir->list[list].tail = i;
+    dir->list[list].head = i;
+    dir->list[list].size++;
+
+} /* edubfm_GhostInsert() */
+
+
+
+/*@================================
+ * edubfm_GhostRemove()
+ *================================*/
+/*
+ * Function: void edubfm_GhostRemove(BfMGhostDir *, Four)
+ *
+ * Description:
+ *  Remove the ghost entry from its list and from the directory.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_GhostRemove(
+    BfMGhostDir		*dir,		/* INOUT ghost directory */
+    Four		i)		/* IN index of the ghost entry */
+{
+    BfMGhostEntry	*g = &dir->entry[i];
+    BfMFrameList	*list = &dir->list[g->list];
+    Four		*p;
+
+
+    /* unlink from the hash chain */
+    for (p = &dir->hashTable[GHOST_HASH(dir, &g->key)]; *p != i; p = &dir->entry[*p].hashNext);
+    *p = g->hashNext;
+
+    /* unlink from the list */
+    if (g->prev != NIL) dir->entry[g->prev].next = g->next;
+    else list->head = g->next;
+    if (g->next != NIL) dir->entry[g->next].prev = g->prev;
+    else list->tail = g->prev;
+    list->size--;
+
+    g->list = NIL;
+    g->next = dir->freeEntry;
+    dir->freeEntry = i;
+
+} /* edubfm_GhostRemove() */
+
+
+
+/*@================================
+ * edubfm_GhostRemoveOldest()
+ *================================*/
+/*
+ * Function: void edubfm_GhostRemoveOldest(BfMGhostDir *, Four)
+ *
+ * Description:
+ *  Remove the oldest entry of a ghost list, if any.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_GhostRemoveOldest(
+    BfMGhostDir		*dir,		/* INOUT ghost directory */
+    Four		list)		/* IN ghost list */
+{
+    if (dir->list[list].tail != NIL)
+        edubfm_GhostRemove(dir, dir->list[list].tail);
+
+} /* edubfm_GhostRemoveOldest() */
@@ -0,0 +1,376 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_Pool.c
+ *
+ * Description:
+ *  The table of the buffer pools and the assignments of files and indexes
+ *  to them. PAGE_BUF and LOT_LEAF_BUF are created by the storage system in
+ *  bufInfo[]; the buffer pools created by EduBfM_CreatePool() follow them
+ *  and live here. A buffer pool is never destroyed, so a buffer type once
+ *  valid stays valid.
+ *
+ * Exports:
+ *  BufferInfo *bufPoolInfo[]
+ *  Four edubfm_nPools
+ *  char bufPoolName[][BFM_MAXPOOLNAME]
+ *  pthread_mutex_t edubfm_poolLatch
+ *  Four edubfm_AllocPool(Four, Four, Four)
+ *  void edubfm_FreePool(Four)
+ *  Four edubfm_PoolMapSet(PageID *, Four)
+ *  Four edubfm_PoolMapGet(PageID *)
+ *  Four edubfm_EvictFromOtherPools(BfMHashKey *, Four, Boolean)
+ */
+
+
+#include <stdlib.h> /* for malloc & free */
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+/*@
+ * global variables
+ */
+/* information of the buffer pools */
+BufferInfo *bufPoolInfo[BFM_MAXPOOLS] = { &bufInfo[PAGE_BUF], &bufInfo[LOT_LEAF_BUF] };
+
+/* # of buffer pools */
+Four edubfm_nPools = NUM_BUF_TYPES;
+
+/* names of the buffer pools */
+char bufPoolName[BFM_MAXPOOLS][BFM_MAXPOOLNAME] = { "PAGE_BUF", "LOT_LEAF_BUF" };
+
+/* serializes the creation of buffer pools */
+pthread_mutex_t edubfm_poolLatch = PTHREAD_MUTEX_INITIALIZER;
+
+/* buffer pools created by EduBfM_CreatePool() */
+static BufferInfo edubfm_createdPools[BFM_MAXPOOLS];
+
+/* assignments of files and indexes to buffer pools */
+static BfMPoolMapEntry *edubfm_poolMap[BFM_POOLMAPSIZE];
+static pthread_mutex_t edubfm_poolMapLatch = PTHREAD_MUTEX_INITIALIZER;
+
+/* has a file or an index ever been assigned to a buffer pool? */
+static Boolean edubfm_poolAssigned = FALSE;
+
+/* Macro: POOLMAP_HASH(id)
+ * Description: return the hash chain of the file or index
+ */
+#define POOLMAP_HASH(id)	((UFour)((id)->volNo * 31 + (id)->pageNo) % BFM_POOLMAPSIZE)
+
+
+
+/*@================================
+ * edubfm_AllocPool()
+ *================================*/
+/*
+ * Function: Four edubfm_AllocPool(Four, Four, Four)
+ *
+ * Description:
+ *  Allocate an empty buffer pool of 'nBufs' buffers of 'bufSize' pages
+ *  for the buffer type 'type', with its buffer table and hash table, as
+ *  the storage system does for the built-in buffer pools. The caller holds
+ *  edubfm_poolLatch and the buffer type is not yet visible.
+ *
+ * Returns:
+ *  error code
+ *    eMEMORYALLOCERR_EDUBFM - memory allocation failed
+ */
+Four edubfm_AllocPool(
+    Four		type,			/* IN buffer type */
+    Four		bufSize,		/* IN size of a buffer in pages */
+    Four		nBufs)			/* IN # of buffers */
+{
+    Four		i;
+    BufferInfo		*info = &edubfm_createdPools[type];
+
+
+    info->bufSize = bufSize;
+    info->nBufs = nBufs;
+    info->nextVictim = 0;
+    info->bufTable = (BufferTable *)malloc(sizeof(BufferTable) * nBufs);
+    info->hashTable = (Two *)malloc(sizeof(Two) * HASHTABLESIZE_TO_NBUFS(nBufs));
+    if (posix_memalign((void **)&info->bufferPool, PAGESIZE, PAGESIZE * bufSize * nBufs) != 0)
+        info->bufferPool = NULL;
+
+    if (info->bufTable == NULL || info->hashTable == NULL || info->bufferPool == NULL)
+    {
+        free(info->bufTable);
+        free(info->hashTable);
+        free(info->bufferPool);
+        ERR(eMEMORYALLOCERR_EDUBFM);
+    }
+
+    for (i = 0; i < nBufs; i++)
+    {
+        info->bufTable[i].key.volNo = NIL;
+        info->bufTable[i].key.pageNo = NIL;
+        info->bufTable[i].fixed = 0;
+        info->bufTable[i].bits = ALL_0;
+        info->bufTable[i].nextHashEntry = NIL;
+    }
+
+    for (i = 0; i < HASHTABLESIZE_TO_NBUFS(nBufs); i++)
+        info->hashTable[i] = NIL;
+
+    bufPoolInfo[type] = info;
+
+    return(eNOERROR);
+
+} /* edubfm_AllocPool() */
+
+
+
+/*@================================
+ * edubfm_FreePool()
+ *================================*/
+/*
+ * Function: void edubfm_FreePool(Four)
+ *
+ * Description:
+ *  Free the buffer pool allocated by edubfm_AllocPool() for a buffer type
+ *  which could not be set up, so that the buffer type can be used again.
+ *  The side structures set up so far are not freed.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_FreePool(
+    Four		type)			/* IN buffer type */
+{
+    free(BI_INFO(type)->bufTable);
+    free(BI_INFO(type)->hashTable);
+    free(BI_BUFFERPOOL(type));
+    bufPoolInfo[type] = NULL;
+
+} /* edubfm_FreePool() */
+
+
+
+/*@================================
+ * edubfm_PoolMapSet()
+ *================================*/
+/*
+ * Function: Four edubfm_PoolMapSet(PageID *, Four)
+ *
+ * Description:
+ *  Assign the file or index 'physicalId' to the buffer pool 'pool', or
+ *  drop its assignment if 'pool' is NIL.
+ *
+ * Returns:
+ *  error code
+ *    eMEMORYALLOCERR_EDUBFM - memory allocation failed
+ */
+Four edubfm_PoolMapSet(
+    PageID		*physicalId,		/* IN PhysicalFileID or PhysicalIndexID */
+    Four		pool)			/* IN buffer type, or NIL */
+{
+    BfMPoolMapEntry	**p;
+    BfMPoolMapEntry	*entry;
+
+
+    pthread_mutex_lock(&edubfm_poolMapLatch);
+
+    for (p = &edubfm_poolMap[POOLMAP_HASH(physicalId)]; *p != NULL; p = &(*p)->next)
+        if (EQUALKEY(&(*p)->physicalId, physicalId)) break;
+
+    if (*p != NULL)
+    {
+        if (pool != NIL)
+            (*p)->pool = pool;
+        else
+        {
+            entry = *p;
+            *p = entry->next;
+            free(entry);
+        }
+    }
+    else if (pool != NIL)
+    {
+        entry = (BfMPoolMapEntry *)malloc(sizeof(BfMPoolMapEntry));
+        if (entry == NULL)
+        {
+            pthread_mutex_unlock(&edubfm_poolMapLatch);
+            ERR(eMEMORYALLOCERR_EDUBFM);
+        }
+
+        entry->physicalId = *physicalId;
+        entry->pool = pool;
+        __atomic_store_n(&edubfm_poolAssigned, TRUE, __ATOMIC_RELEASE);
+        entry->next = edubfm_poolMap[POOLMAP_HASH(physicalId)];
+        edubfm_poolMap[POOLMAP_HASH(physicalId)] = entry;
+    }
+
+    pthread_mutex_unlock(&edubfm_poolMapLatch);
+
+    return(eNOERROR);
+
+} /* edubfm_PoolMapSet() */
+
+
+
+/*@================================
+ * edubfm_PoolMapGet()
+ *================================*/
+/*
+ * Function: Four edubfm_PoolMapGet(PageID *)
+ *
+ * Description:
+ *  Return the buffer pool the file or index 'physicalId' is assigned to.
+ *
+ * Returns:
+ *  buffer type, or NIL if the file or index is not assigned
+ */
+Four edubfm_PoolMapGet(
+    PageID		*physicalId)		/* IN PhysicalFileID or PhysicalIndexID */
+{
+    BfMPoolMapEntry	*entry;
+    Four		pool = NIL;
+
+
+    pthread_mutex_lock(&edubfm_poolMapLatch);
+
+    for (entry = edubfm_poolMap[POOLMAP_HASH(physicalId)]; entry != NULL; entry = entry->next)
+    {
+        if (EQUALKEY(&entry->physicalId, physicalId))
+        {
+            pool = entry->pool;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&edubfm_poolMapLatch);
+
+    return(pool);
+
+} /* edubfm_PoolMapGet() */
+
+
+
+/*@================================
+ * edubfm_EvictFromOtherPools()
+ *================================*/
+/*
+ * Function: Four edubfm_EvictFromOtherPools(BfMHashKey *, Four, Boolean)
+ *
+ * Description:
+ *  Called before the train 'key' missing in the buffer pool 'type' is read
+ *  from the disk. Once a file or an index has been assigned to a buffer
+ *  pool, its trains may still be in the buffer pool they were fixed in
+ *  before. Such a train is written if dirty and taken out of the other
+ *  buffer pool, so that the disk holds its latest contents and the train
+ *  lives in one buffer pool only. A buffer held for a moment by the buffer
+ *  manager is waited for if 'wait' is TRUE; a read-ahead, which holds
+ *  buffers of its own, gives the train up instead.
+ *
+ * Returns:
+ *  error code
+ *    eFIXEDBUFFER_EDUBFM - the train is fixed in another buffer pool
+ *    some errors caused by function calls
+ */
+Four edubfm_EvictFromOtherPools(
+    BfMHashKey		*key,			/* IN train to be read */
+    Four		type,			/* IN buffer type the train is read into */
+    Boolean		wait)			/* IN wait for a buffer held meanwhile? */
+{
+    Four		e;			/* error code */
+    Four		other;			/* another buffer type */
+    Four		index;			/* buffer of the train in the other buffer pool */
+
+
+    if (!__atomic_load_n(&edubfm_poolAssigned, __ATOMIC_ACQUIRE)) return(eNOERROR);
+
+    for (other = 0; other < BFM_NPOOLS(); other++)
+    {
+        /* a buffer pool of another buffer size holds other trains */
+        if (other == type || BI_BUFSIZE(other) != BI_BUFSIZE(type)) continue;
+
+        while (1)
+        {
+            edubfm_LatchKey(key, other);
+            index = edubfm_LookUp(key, other);
+            if (index == NOTFOUND_IN_HTABLE)
+            {
+                edubfm_TierRemove(other, key);
+                edubfm_UnlatchKey(key, other);
+                break;
+            }
+
+            if (!edubfm_ClaimBuffer(other, index))
+            {
+                if (!wait)
+                {
+                    edubfm_UnlatchKey(key, other);
+                    return(eFIXEDBUFFER_EDUBFM);
+                }
+                if (!edubfm_WaitHeldBuffer(other, index, key)) ERR(eFIXEDBUFFER_EDUBFM);
+                continue;
+            }
+            edubfm_UnlatchKey(key, other);
+
+            /* The train stays in the hash table while it is written, as a victim does. */
+            if (BI_BITS_LOAD(other, index) & DIRTY)
+            {
+                e = edubfm_FlushBuffer(other, index);
+                if (e < 0)
+                {
+                    edubfm_UnclaimBuffer(other, index);
+                    ERR(e);
+                }
+            }
+
+            /* Somebody may have fixed or dirtied the train meanwhile; try again. */
+            edubfm_LatchKey(key, other);
+            if (edubfm_FenceBuffer(other, index))
+            {
+                if (!(BI_BITS_LOAD(other, index) & DIRTY) && EQUALKEY(key, &BI_KEY(other, index)))
+                {
+                    e = edubfm_Delete(key, other);
+                    if (e < 0)
+                    {
+                        edubfm_UnfenceBuffer(other, index);
+                        edubfm_UnlatchKey(key, other);
+                        edubfm_UnclaimBuffer(other, index);
+                        ERR(e);
+                    }
+                    BI_KEY(other, index).pageNo = NIL;
+                    edubfm_TierRemove(other, key);
+                    edubfm_UnlatchKey(key, other);
+
+                    /* the version becomes even again */
+                    edubfm_ReleaseBuffer(other, index);
+                    edubfm_UnholdBuffer(other, index);
+                    break;
+                }
+                edubfm_UnfenceBuffer(other, index);
+            }
+            edubfm_UnlatchKey(key, other);
+            edubfm_UnclaimBuffer(other, index);
+        }
+    }
+
+    return(eNOERROR);
+
+} /* edubfm_EvictFromOtherPools() */
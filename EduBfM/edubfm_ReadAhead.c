@@ -0,0 +1,341 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_ReadAhead.c
+ *
+ * Description :
+ *  Detect sequential reads of trains and read the following trains into
+ *  the buffer pool in advance, by multi-train reads.
+ *
+ * Exports:
+ *  BufferReadAheadInfo bufReadAhead[]
+ *  void edubfm_PrefetchTrains(Four, BfMHashKey *, Four)
+ *  void edubfm_ReadAhead(BfMHashKey *, Four)
+ */
+
+
+#include <stdlib.h> /* for malloc & free */
+#include <string.h> /* for memcpy */
+#include "EduBfM_common.h"
+#include "RDsM.h"
+#include "RM.h"
+#include "EduBfM_Internal.h"
+
+
+/*@
+ * constant definitions
+ */
+#define BFM_READAHEAD_TRIGGER	2	/* # of sequential misses starting a read-ahead */
+#define BFM_READAHEAD_INITIAL	4	/* first read-ahead window in trains */
+
+
+/*@
+ * global variables
+ */
+/* read-ahead states of the buffer pools; read-ahead is disabled by default */
+BufferReadAheadInfo bufReadAhead[BFM_MAXPOOLS] = {
+    [0 ... BFM_MAXPOOLS-1] = { .mutex = PTHREAD_MUTEX_INITIALIZER }
+};
+
+
+
+/*@================================
+ * edubfm_DropRun()
+ *================================*/
+/*
+ * Function: static void edubfm_DropRun(Four, Four *, Four)
+ *
+ * Description :
+ *  Give back the claimed buffer elements 'index[]' of a run which cannot
+ *  be read: they are deleted from the hash table and given back empty,
+ *  and their fixers wake up and read the trains themselves.
+ *
+ * Returns:
+ *  None
+ */
+static void edubfm_DropRun(
+    Four		type,			/* IN buffer type */
+    Four		*index,			/* IN claimed buffer elements */
+    Four		nTrains)		/* IN # of trains */
+{
+    Four		k;
+
+
+    for (k = 0; k < nTrains; k++)
+    {
+        edubfm_LatchKey(&BI_KEY(type, index[k]), type);
+        edubfm_Delete(&BI_KEY(type, index[k]), type);
+        edubfm_UnlatchKey(&BI_KEY(type, index[k]), type);
+        BI_KEY(type, index[k]).pageNo = NIL;
+        edubfm_EndFrameIO(type, index[k]);
+        edubfm_ReleaseBuffer(type, index[k]);
+        edubfm_UnholdBuffer(type, index[k]);
+    }
+
+} /* edubfm_DropRun() */
+
+
+
+/*@================================
+ * edubfm_ReadRun()
+ *================================*/
+/*
+ * Function: static void edubfm_ReadRun(Four, BfMHashKey *, Four *, Four)
+ *
+ * Description :
+ *  Read 'nTrains' trains adjacent on the disk, starting at 'firstKey',
+ *  into the claimed buffer elements 'index[]' by a single multi-train
+ *  read. The buffer elements are already in the hash table and marked
+ *  busy; the fixers of the trains wait until the read completes. The
+ *  trains are then copied into their buffer elements, which are given
+ *  back unfixed and no longer busy; if the read fails, they are given
+ *  back empty. The read is done by the calling thread, so that no read
+ *  is in flight once the caller returns and the buffer pool may be torn
+ *  down by the storage system at any time between two calls.
+ *
+ * Returns:
+ *  None
+ */
+static void edubfm_ReadRun(
+    Four		type,			/* IN buffer type */
+    BfMHashKey		*firstKey,		/* IN first train of the run */
+    Four		*index,			/* IN claimed buffer elements */
+    Four		nTrains)		/* IN # of trains */
+{
+    Four		e;			/* error */
+    Four		k;
+    Four		trainBytes = PAGESIZE * BI_BUFSIZE(type);
+    char		*data;			/* staging area of the run */
+    UEight		start;			/* start time of the read */
+
+
+    if (nTrains == 0) return;
+
+	/* Error check whether using not supported functionality by EduBfM */
+    if (RM_IS_ROLLBACK_REQUIRED())
+    {
+        edubfm_DropRun(type, index, nTrains);
+        return;
+    }
+
+    /* the buffer elements of a run are not adjacent in the buffer pool */
+    data = (char *)malloc(trainBytes * nTrains);
+    if (data == NULL)
+    {
+        edubfm_DropRun(type, index, nTrains);
+        return;
+    }
+
+    edubfm_LatchIO();
+    start = edubfm_Now();
+    e = RDsM_ReadTrains((PageID *)firstKey, data, nTrains, BI_BUFSIZE(type));
+    edubfm_HistAdd(&bufStats[type].readLatency, edubfm_Now() - start);
+    edubfm_UnlatchIO();
+
+    if (e < 0)
+    {
+        edubfm_DropRun(type, index, nTrains);
+        free(data);
+        return;
+    }
+
+    for (k = 0; k < nTrains; k++)
+    {
+        memcpy(BI_BUFFER(type, index[k]), data + k * trainBytes, trainBytes);
+        edubfm_PolicyLoad(type, index[k], &BI_KEY(type, index[k]));
+        edubfm_EndFrameIO(type, index[k]);
+        edubfm_UnclaimBuffer(type, index[k]);
+    }
+
+    __atomic_add_fetch(&bufStats[type].prefetches, nTrains, __ATOMIC_RELAXED);
+
+    free(data);
+
+} /* edubfm_ReadRun() */
+
+
+
+/*@================================
+ * edubfm_PrefetchTrains()
+ *================================*/
+/*
+ * Function: void edubfm_PrefetchTrains(Four, BfMHashKey *, Four)
+ *
+ * Description :
+ *  Read the trains 'keys[]' into the buffer pool, except those already in
+ *  it. Each run of up to BFM_MAXREADAHEAD trains which follow one another
+ *  in 'keys[]' and on the disk is read by one multi-train read. The
+ *  prefetch stops when no buffer can be allocated, and nothing is read
+ *  while the buffer pool is resized or moved; errors are not reported
+ *  since nobody asked for the trains.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_PrefetchTrains(
+    Four		type,			/* IN buffer type */
+    BfMHashKey		*keys,			/* IN trains to be read */
+    Four		nKeys)			/* IN # of trains */
+{
+    Four		e;			/* error */
+    Four		k;
+    Four		victim;			/* buffer allocated for a train */
+    Four		index[BFM_MAXREADAHEAD];	/* buffers of the current run */
+    Four		nRun = 0;		/* # of trains in the current run */
+    BfMHashKey		next;			/* train to be read ahead */
+    BfMHashKey		runStart;		/* first train of the current run */
+
+
+    /* nothing is read ahead while the buffer pool is resized or moved */
+    if (pthread_mutex_trylock(&bufResize[type].mutex) != 0) return;
+
+    for (k = 0; k < nKeys; k++)
+    {
+        next = keys[k];
+
+        /* the run ends where the trains are not adjacent on the disk */
+        if (nRun > 0 &&
+            (nRun == BFM_MAXREADAHEAD || next.volNo != runStart.volNo ||
+             next.pageNo != runStart.pageNo + nRun * BI_BUFSIZE(type)))
+        {
+            edubfm_ReadRun(type, &runStart, index, nRun);
+            nRun = 0;
+        }
+
+        edubfm_LatchKey(&next, type);
+        if (edubfm_LookUp(&next, type) != NOTFOUND_IN_HTABLE)
+        {
+            /* already in the buffer pool: the run ends here */
+            edubfm_UnlatchKey(&next, type);
+            edubfm_ReadRun(type, &runStart, index, nRun);
+            nRun = 0;
+            continue;
+        }
+        edubfm_UnlatchKey(&next, type);
+
+        if (edubfm_EvictFromOtherPools(&next, type, FALSE) < 0) break;
+
+        victim = edubfm_AllocTrain(&next, type, BFM_INTENT_NORMAL);
+        if (victim < 0) break;
+
+        edubfm_LatchKey(&next, type);
+        if (edubfm_LookUp(&next, type) != NOTFOUND_IN_HTABLE)
+        {
+            /* read by another thread in the meantime */
+            edubfm_UnlatchKey(&next, type);
+            edubfm_ReleaseBuffer(type, victim);
+            edubfm_ReadRun(type, &runStart, index, nRun);
+            nRun = 0;
+            continue;
+        }
+
+        BI_KEY(type, victim) = next;
+        e = edubfm_Insert(&BI_KEY(type, victim), victim, type);
+        if (e < 0)
+        {
+            edubfm_UnlatchKey(&next, type);
+            edubfm_ReleaseBuffer(type, victim);
+            break;
+        }
+        edubfm_BeginFrameIO(type, victim);
+        edubfm_HoldBuffer(type, victim);	/* the claim stays the buffer manager's */
+        edubfm_TierRemove(type, &next);
+        edubfm_UnlatchKey(&next, type);
+
+        if (nRun == 0) runStart = next;
+        index[nRun++] = victim;
+    }
+
+    edubfm_ReadRun(type, &runStart, index, nRun);
+
+    pthread_mutex_unlock(&bufResize[type].mutex);
+
+} /* edubfm_PrefetchTrains() */
+
+
+
+/*@================================
+ * edubfm_ReadAhead()
+ *================================*/
+/*
+ * Function: void edubfm_ReadAhead(BfMHashKey *, Four)
+ *
+ * Description :
+ *  Called after the train 'key' has been read on demand. A read is
+ *  sequential if it is of the train following the previous one read on
+ *  demand, or of the first train past the last read-ahead window. After
+ *  BFM_READAHEAD_TRIGGER sequential reads in a row, the next 'window'
+ *  trains are read ahead, and the window is doubled up to the maximum set
+ *  by EduBfM_SetReadAhead(). A non-sequential read resets the window.
+ *  A single sequential stream is tracked per buffer pool.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_ReadAhead(
+    BfMHashKey		*key,			/* IN train read on demand */
+    Four		type)			/* IN buffer type */
+{
+    BufferReadAheadInfo	*ra = &bufReadAhead[type];
+    Four		nTrains = 0;		/* # of trains to read ahead */
+    Four		k;
+    BfMHashKey		ahead[BFM_MAXREADAHEAD];	/* trains to read ahead */
+
+
+    if (__atomic_load_n(&ra->maxWindow, __ATOMIC_RELAXED) == 0) return;
+
+    pthread_mutex_lock(&ra->mutex);
+
+    if (key->volNo == ra->lastMiss.volNo &&
+        (key->pageNo == ra->lastMiss.pageNo + BI_BUFSIZE(type) ||
+         (ra->nextAhead.pageNo != NIL && key->pageNo == ra->nextAhead.pageNo)))
+        ra->run++;
+    else
+    {
+        ra->run = 1;
+        ra->window = MIN(BFM_READAHEAD_INITIAL, ra->maxWindow);
+        ra->nextAhead.pageNo = NIL;
+    }
+    ra->lastMiss = *key;
+
+    if (ra->run >= BFM_READAHEAD_TRIGGER && ra->maxWindow > 0)
+    {
+        nTrains = ra->window;
+        ra->nextAhead = *key;
+        ra->nextAhead.pageNo += BI_BUFSIZE(type) * (nTrains + 1);
+        ra->window = MIN(ra->window * 2, ra->maxWindow);
+    }
+
+    pthread_mutex_unlock(&ra->mutex);
+
+    for (k = 0; k < nTrains; k++)
+    {
+        ahead[k] = *key;
+        ahead[k].pageNo += BI_BUFSIZE(type) * (k + 1);
+    }
+
+    if (nTrains > 0) edubfm_PrefetchTrains(type, ahead, nTrains);
+
+} /* edubfm_ReadAhead() */
@@ -70,11 +70,16 @@ Four edubfm_ReadTrain(
     Four    type )		/* IN buffer type */
 {
     Four e;			/* for error */
+    UEight start;		/* start time of the read */
 
 	/* Error check whether using not supported functionality by EduBfM */
 	if (RM_IS_ROLLBACK_REQUIRED()) ERR(eNOTSUPPORTED_EDUBFM);
 
+    edubfm_LatchIO();
+    start = edubfm_Now();
     e = RDsM_ReadTrain(trainId, aTrain, BI_BUFSIZE(type));
+    edubfm_HistAdd(&bufStats[type].readLatency, edubfm_Now() - start);
+    edubfm_UnlatchIO();
     if (e < 0) ERR (e);
 
     return( eNOERROR );
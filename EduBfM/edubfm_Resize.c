@@ -0,0 +1,416 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_Resize.c
+ *
+ * Description:
+ *  Change the number of buffers of a buffer pool while it is in use.
+ *  The buffer table and the buffer pool have room for BFM_MAXNBUFS buffers
+ *  (see edubfm_BufferPool.c), so the buffers in use never move:
+ *  - A buffer pool shrinks by draining the buffers above the new size:
+ *    they are all fixed once by the resizing thread, so that the
+ *    replacement policies pass over them, and each becomes claimed by it
+ *    as soon as the other fixes are gone. Its train is then forced out,
+ *    and it stays claimed, so that nobody uses it any more.
+ *  - A buffer pool grows by setting up the new buffer table entries and
+ *    frame latches; the new buffers are claimed until they are in use.
+ *  The hash value of a train depends on the size of the hash table, which
+ *  is 3 * nBufs - 1 entries, so the size is switched while holding all
+ *  stripe latches and the latch of the replacement policy. The switch does
+ *  no I/O: it relinks the hash chains into the new hash table and sets up
+ *  the replacement policy again. The size is stored atomically for the
+ *  readers holding no stripe latch (see BI_NBUFS_LOAD()). The background
+ *  writer and the read-ahead keep away from a buffer pool while its
+ *  resize mutex is held.
+ *
+ * Exports:
+ *  BufferResizeInfo bufResize[]
+ *  Four edubfm_ResizeBufferPool(Four, Four)
+ */
+
+
+#include <stdlib.h> /* for malloc & free */
+#include <time.h>   /* for nanosleep */
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+/*@
+ * constant definitions
+ */
+#define BFM_DRAINWAIT		1	/* ms between the attempts to take a fixed buffer */
+#define BFM_DRAINTIMEOUT	1000	/* ms a buffer above the new size may stay fixed */
+
+
+/*@
+ * global variables
+ */
+/* resize states of the buffer pools; the capacities are set by edubfm_InitBufferPools() */
+BufferResizeInfo bufResize[BFM_MAXPOOLS] = {
+    [0 ... BFM_MAXPOOLS-1] = { PTHREAD_MUTEX_INITIALIZER, 0, 0, 0, BFM_POOL_HUGEPAGE, FALSE, NULL }
+};
+
+
+
+/*@================================
+ * edubfm_DrainBuffer()
+ *================================*/
+/*
+ * Function: static Four edubfm_DrainBuffer(Four, Four)
+ *
+ * Description:
+ *  Wait until the caller's fix is the only one of a buffer above the new
+ *  size of a shrinking buffer pool, i.e. the buffer is claimed by the
+ *  caller, and force its train out of the buffer pool, as
+ *  edubfm_AllocTrain() does for a victim. The buffer is left claimed and
+ *  empty; if an error occurs, it is left fixed once.
+ *
+ * Returns:
+ *  error code
+ *    eFIXEDBUFFER_EDUBFM - the train stays fixed by others for BFM_DRAINTIMEOUT ms
+ *    some errors caused by function calls
+ */
+static Four edubfm_DrainBuffer(
+    Four		type,			/* IN buffer type */
+    Four		index)			/* IN buffer to be drained */
+{
+    Four		e;			/* error */
+    Four		waited = 0;		/* time waited in ms */
+    Boolean		dirty;			/* was the train written? */
+    BfMHashKey		key;			/* train held by the buffer */
+    struct timespec	pause = { 0, BFM_DRAINWAIT * 1000000L };
+
+
+    while (1)
+    {
+        if (BI_FIXED_LOAD(type, index) == 1)
+        {
+            key = BI_KEY(type, index);
+            dirty = FALSE;
+
+            if (BI_BITS_LOAD(type, index) & DIRTY)
+            {
+                e = edubfm_FlushBuffer(type, index);
+                if (e < 0) ERR(e);
+                dirty = TRUE;
+            }
+
+            if (key.pageNo == NIL) break;
+
+            /* Somebody may have fixed the train during the flush; try again later. */
+            edubfm_LatchKey(&key, type);
+            if (edubfm_FenceBuffer(type, index))
+            {
+                if (!(BI_BITS_LOAD(type, index) & DIRTY) && EQUALKEY(&key, &BI_KEY(type, index)))
+                {
+                    e = edubfm_Delete(&key, type);
+                    if (e < 0)
+                    {
+                        edubfm_UnfenceBuffer(type, index);
+                        edubfm_UnlatchKey(&key, type);
+                        ERR(e);
+                    }
+                    BI_KEY(type, index).pageNo = NIL;
+                    edubfm_UnfenceBuffer(type, index);
+                    edubfm_UnlatchKey(&key, type);
+
+                    BFM_STAT_INC(type, evictions);
+                    if (dirty) BFM_STAT_INC(type, dirtyEvictions);
+                    else BFM_STAT_INC(type, cleanEvictions);
+                    break;
+                }
+                edubfm_UnfenceBuffer(type, index);
+            }
+            edubfm_UnlatchKey(&key, type);
+        }
+
+        if (waited >= BFM_DRAINTIMEOUT) ERR(eFIXEDBUFFER_EDUBFM);
+
+        nanosleep(&pause, NULL);
+        waited += BFM_DRAINWAIT;
+    }
+
+    edubfm_PolicyEvict(type, index, &key);
+    __atomic_store_n(&BI_BITS(type, index), ALL_0, __ATOMIC_RELEASE);
+
+    /* the buffer is out of the hash table and stays claimed */
+    edubfm_UnholdBuffer(type, index);
+
+    return(eNOERROR);
+
+} /* edubfm_DrainBuffer() */
+
+
+
+/*@================================
+ * edubfm_AddBuffers()
+ *================================*/
+/*
+ * Function: static Four edubfm_AddBuffers(Four, Four)
+ *
+ * Description:
+ *  Make room for 'nBufs' buffers in a growing buffer pool. The buffer pool
+ *  is moved only if the room reserved for it is too small, which needs all
+ *  trains to be unfixed. The new buffers are left claimed and empty.
+ *
+ * Returns:
+ *  error code
+ *    eFIXEDBUFFER_EDUBFM - the buffer pool has to be moved but a train is fixed
+ *    some errors caused by function calls
+ */
+static Four edubfm_AddBuffers(
+    Four		type,			/* IN buffer type */
+    Four		nBufs)			/* IN new # of buffers */
+{
+    Four		e;			/* error */
+    Four		i;
+
+
+    if (nBufs > bufResize[type].poolCapacity)
+    {
+        e = edubfm_RemapBufferPool(type, bufResize[type].placement, nBufs);
+        if (e < 0) ERR(e);
+    }
+
+    /* the buffers between nBufs and the high water mark are left claimed by a shrink */
+    for (i = bufResize[type].highWater; i < nBufs; i++)
+    {
+        e = edubfm_InitFrameLatch(type, i);
+        if (e < 0) ERR(e);
+
+        BI_KEY(type, i).pageNo = NIL;
+        BI_FIXED(type, i) = 1;
+        BI_BITS(type, i) = ALL_0;
+        BI_NEXTHASHENTRY(type, i) = NIL;
+
+        bufResize[type].highWater = i + 1;
+    }
+
+    return(eNOERROR);
+
+} /* edubfm_AddBuffers() */
+
+
+
+/*@================================
+ * edubfm_SwitchSize()
+ *================================*/
+/*
+ * Function: static Four edubfm_SwitchSize(Four, Four, Two *)
+ *
+ * Description:
+ *  Set the # of buffers of a buffer pool to 'nBufs' and replace its hash
+ *  table by 'hashTable'. The buffers which are not in both sizes are
+ *  claimed by the caller.
+ *  The state of the replacement policy is sized for the buffer pool, so
+ *  it is set up again for 'nBufs' buffers before anything is switched;
+ *  the history of LRU-K and the ghost lists of 2Q, ARC and CLOCK-Pro
+ *  start over empty. If that fails, the buffer pool keeps its size, its
+ *  hash table and the old state of the policy, and 'hashTable' is left
+ *  to the caller.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+static Four edubfm_SwitchSize(
+    Four		type,			/* IN buffer type */
+    Four		nBufs,			/* IN new # of buffers */
+    Two			*hashTable)		/* IN hash table for nBufs buffers */
+{
+    Four		e;			/* error */
+    Two			*oldHashTable;
+    Four		oldNBufs;		/* old # of buffers */
+    Four		oldSize;		/* size of the old hash table */
+    void		*oldState;		/* old state of the replacement policy */
+    void		*newState;		/* state for nBufs buffers */
+    Four		h;			/* hash value */
+    Four		i, next;
+
+
+    pthread_mutex_lock(&bufPolicy[type].latch);
+    edubfm_LatchAllStripes(type);
+
+    oldNBufs = BI_NBUFS(type);
+    oldHashTable = BI_HASHTABLE(type);
+    oldSize = HASHTABLESIZE(type);
+
+    /* set up the policy for the new size beside its old state */
+    oldState = BI_POLICYSTATE(type);
+    BI_POLICYSTATE(type) = NULL;
+    __atomic_store_n(&BI_NBUFS(type), nBufs, __ATOMIC_RELEASE);
+
+    e = BI_POLICY(type)->init(type);
+    if (e < 0)
+    {
+        __atomic_store_n(&BI_NBUFS(type), oldNBufs, __ATOMIC_RELEASE);
+        BI_POLICYSTATE(type) = oldState;
+
+        edubfm_UnlatchAllStripes(type);
+        pthread_mutex_unlock(&bufPolicy[type].latch);
+        ERR(e);
+    }
+
+    BI_HASHTABLE(type) = hashTable;
+    if (BI_NEXTVICTIM(type) >= nBufs) BI_NEXTVICTIM(type) = 0;
+
+    /* relink the trains in the hash table; the chains are authoritative,
+     * while a buffer being replaced may still carry the key of its old train */
+    for (h = 0; h < HASHTABLESIZE(type); h++)
+        hashTable[h] = NIL;
+
+    for (h = 0; h < oldSize; h++)
+    {
+        for (i = oldHashTable[h]; i != NIL; i = next)
+        {
+            next = BI_NEXTHASHENTRY(type, i);
+            BI_NEXTHASHENTRY(type, i) = hashTable[BFM_HASH(&BI_KEY(type, i), type)];
+            hashTable[BFM_HASH(&BI_KEY(type, i), type)] = i;
+        }
+    }
+
+    /* the final routines only free the state, whatever the size */
+    newState = BI_POLICYSTATE(type);
+    BI_POLICYSTATE(type) = oldState;
+    BI_POLICY(type)->final(type);
+    BI_POLICYSTATE(type) = newState;
+
+    edubfm_UnlatchAllStripes(type);
+    pthread_mutex_unlock(&bufPolicy[type].latch);
+
+    free(oldHashTable);
+
+    return(eNOERROR);
+
+} /* edubfm_SwitchSize() */
+
+
+
+/*@================================
+ * edubfm_ResizeBufferPool()
+ *================================*/
+/*
+ * Function: Four edubfm_ResizeBufferPool(Four, Four)
+ *
+ * Description:
+ *  Change the # of buffers of a buffer pool to 'nBufs'. The fixes of the
+ *  other threads go on during the resize, except for the switch of the
+ *  size, which only relinks the trains in memory.
+ *  If a buffer above the new size stays fixed, the shrink is given up and
+ *  the drained buffers are given back empty. So is the resize if the
+ *  replacement policy cannot be set up for the new size.
+ *  The replacement policy starts over: it forgets the history of LRU-K
+ *  and the ghost lists of 2Q, ARC and CLOCK-Pro.
+ *
+ * Returns:
+ *  error code
+ *    eMEMORYALLOCERR_EDUBFM - memory allocation failed
+ *    eFIXEDBUFFER_EDUBFM - a train to be forced out stays fixed
+ *    some errors caused by function calls
+ */
+Four edubfm_ResizeBufferPool(
+    Four		type,			/* IN buffer type */
+    Four		nBufs)			/* IN new # of buffers */
+{
+    Four		e;			/* error */
+    Four		n;			/* old # of buffers */
+    Four		i, j;
+    Two			*hashTable;		/* hash table for nBufs buffers */
+    BufferReadAheadInfo	*ra = &bufReadAhead[type];
+
+
+    pthread_mutex_lock(&bufResize[type].mutex);
+
+    n = BI_NBUFS(type);
+    if (nBufs == n)
+    {
+        pthread_mutex_unlock(&bufResize[type].mutex);
+        return(eNOERROR);
+    }
+
+    hashTable = (Two *)malloc(sizeof(Two) * HASHTABLESIZE_TO_NBUFS(nBufs));
+    if (nBufs > bufResize[type].tableCapacity || hashTable == NULL)
+    {
+        free(hashTable);
+        pthread_mutex_unlock(&bufResize[type].mutex);
+        ERR(eMEMORYALLOCERR_EDUBFM);
+    }
+
+    if (nBufs < n)
+    {
+        /* keep the replacement policies away from the buffers to be drained */
+        for (i = nBufs; i < n; i++)
+        {
+            edubfm_HoldBuffer(type, i);
+            BI_FIXED_INC(type, i);
+        }
+
+        for (i = nBufs; i < n; i++)
+        {
+            e = edubfm_DrainBuffer(type, i);
+            if (e < 0)
+            {
+                for (j = nBufs; j < i; j++) edubfm_ReleaseBuffer(type, j);
+                for (j = i; j < n; j++) edubfm_UnclaimBuffer(type, j);
+                free(hashTable);
+                pthread_mutex_unlock(&bufResize[type].mutex);
+                ERR(e);
+            }
+        }
+    }
+    else
+    {
+        e = edubfm_AddBuffers(type, nBufs);
+        if (e < 0)
+        {
+            free(hashTable);
+            pthread_mutex_unlock(&bufResize[type].mutex);
+            ERR(e);
+        }
+    }
+
+    e = edubfm_SwitchSize(type, nBufs, hashTable);
+    if (e < 0)
+    {
+        /* the drained buffers are given back empty; the new ones stay claimed */
+        for (i = nBufs; i < n; i++) edubfm_ReleaseBuffer(type, i);
+        free(hashTable);
+        pthread_mutex_unlock(&bufResize[type].mutex);
+        ERR(e);
+    }
+
+    /* the new buffers are ready for use; the drained ones stay claimed */
+    for (i = n; i < nBufs; i++) BI_FIXED_DEC(type, i);
+
+    pthread_mutex_lock(&ra->mutex);
+    ra->maxWindow = MIN(ra->maxWindow, nBufs / 4);
+    ra->window = MIN(ra->window, ra->maxWindow);
+    pthread_mutex_unlock(&ra->mutex);
+
+    pthread_mutex_unlock(&bufResize[type].mutex);
+
+    return(eNOERROR);
+
+} /* edubfm_ResizeBufferPool() */
@@ -0,0 +1,140 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_Ring.c
+ *
+ * Description:
+ *  Buffer rings for the trains read once by scans (BFM_INTENT_ONCE).
+ *  Each thread has a small ring of buffers per buffer pool. While the ring
+ *  is not full, a scan takes its buffers from the replacement policy and
+ *  adds them to the ring; afterwards it reads each train into the oldest
+ *  buffer of the ring, so that a scan of any length replaces only a few
+ *  buffers of the buffer pool. A buffer referenced by another fix since it
+ *  was read into, or fixed at the moment, is left in the buffer pool and
+ *  replaced in the ring by a victim of the policy.
+ *
+ * Exports:
+ *  Four edubfm_RingVictim(Four)
+ *  void edubfm_RingAdd(Four, Four)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+/*@
+ * global variables
+ */
+/* rings of the calling thread, one per buffer pool */
+static __thread BfMRing edubfm_ring[BFM_MAXPOOLS];
+
+/* Macro: RING_SIZE(type)
+ * Description: # of buffers of a ring, at most an eighth of the buffer pool
+ */
+#define RING_SIZE(type)		(MIN(BFM_MAXRINGSIZE, MAX(1, BI_NBUFS_LOAD(type) / 8)))
+
+
+
+/*@================================
+ * edubfm_RingVictim()
+ *================================*/
+/*
+ * Function: Four edubfm_RingVictim(Four)
+ *
+ * Description:
+ *  Claim the next buffer of the calling thread's ring for a train read
+ *  once. The caller puts the buffer it uses back into the ring with
+ *  edubfm_RingAdd().
+ *
+ * Returns:
+ *  index of the claimed buffer, or NIL if the ring is not full or its next
+ *  buffer cannot be recycled
+ */
+Four edubfm_RingVictim(
+    Four		type)			/* IN buffer type */
+{
+    BfMRing		*r = &edubfm_ring[type];
+    Four		i;
+
+
+    /* the buffer pool may have shrunk since the ring was filled */
+    if (r->nFrames > RING_SIZE(type))
+    {
+        r->nFrames = RING_SIZE(type);
+        r->next %= r->nFrames;
+    }
+
+    if (r->nFrames < RING_SIZE(type)) return(NIL);
+
+    i = r->frame[r->next];
+    if (i >= BI_NBUFS_LOAD(type) || (BI_BITS_LOAD(type, i) & (REFER | HOT))) return(NIL);
+
+    if (!edubfm_ClaimBuffer(type, i)) return(NIL);
+
+    /* somebody may have referenced it just before the claim */
+    if (BI_BITS_LOAD(type, i) & (REFER | HOT))
+    {
+        edubfm_UnclaimBuffer(type, i);
+        return(NIL);
+    }
+
+    return(i);
+
+} /* edubfm_RingVictim() */
+
+
+
+/*@================================
+ * edubfm_RingAdd()
+ *================================*/
+/*
+ * Function: void edubfm_RingAdd(Four, Four)
+ *
+ * Description:
+ *  Put the buffer which a train read once is read into at the place of
+ *  the next buffer of the calling thread's ring, or append it while the
+ *  ring is not full.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_RingAdd(
+    Four		type,			/* IN buffer type */
+    Four		index)			/* IN buffer used */
+{
+    BfMRing		*r = &edubfm_ring[type];
+
+
+    if (r->nFrames < RING_SIZE(type))
+    {
+        r->frame[r->nFrames++] = index;
+        return;
+    }
+
+    r->frame[r->next] = index;
+    r->next = (r->next + 1) % r->nFrames;
+
+} /* edubfm_RingAdd() */
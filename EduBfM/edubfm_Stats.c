@@ -0,0 +1,110 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_Stats.c
+ *
+ * Description:
+ *  Helpers for the statistics of the buffer pools. The counters are
+ *  updated with relaxed atomic operations and the clock is read through
+ *  the vDSO, so the statistics are always collected.
+ *
+ * Exports:
+ *  __thread Four edubfm_caller
+ *  UEight edubfm_Now(void)
+ *  void edubfm_HistAdd(BfMHistogram *, UEight)
+ */
+
+
+#include <time.h>
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+/*@
+ * global variables
+ */
+/* caller of the buffer manager in this thread, set by EduBfM_SetCaller() */
+__thread Four edubfm_caller = BFM_CALLER_OTHER;
+
+
+
+/*@================================
+ * edubfm_Now()
+ *================================*/
+/*
+ * Function: UEight edubfm_Now(void)
+ *
+ * Description:
+ *  Return the time in microseconds from an arbitrary point, for measuring
+ *  latencies.
+ *
+ * Returns:
+ *  current time in microseconds
+ */
+UEight edubfm_Now(void)
+{
+    struct timespec	now;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return((UEight)now.tv_sec * 1000000 + now.tv_nsec / 1000);
+
+} /* edubfm_Now() */
+
+
+
+/*@================================
+ * edubfm_HistAdd()
+ *================================*/
+/*
+ * Function: void edubfm_HistAdd(BfMHistogram *, UEight)
+ *
+ * Description:
+ *  Add a sample to a histogram.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_HistAdd(
+    BfMHistogram	*h,			/* INOUT histogram */
+    UEight		value)			/* IN sample */
+{
+    Four		b;			/* bucket */
+    UEight		max;
+
+
+    b = (value == 0) ? 0 : 64 - __builtin_clzll(value);
+    if (b >= BFM_HIST_BUCKETS) b = BFM_HIST_BUCKETS - 1;
+
+    __atomic_add_fetch(&h->bucket[b], 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&h->count, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&h->sum, value, __ATOMIC_RELAXED);
+
+    max = __atomic_load_n(&h->max, __ATOMIC_RELAXED);
+    while (value > max &&
+           !__atomic_compare_exchange_n(&h->max, &max, value, TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+} /* edubfm_HistAdd() */
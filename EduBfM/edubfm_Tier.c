@@ -0,0 +1,384 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_Tier.c
+ *
+ * Description:
+ *  The compressed tier of a buffer pool. A clean train replaced by
+ *  edubfm_AllocTrain() is compressed (see edubfm_Compress.c) and kept in
+ *  memory, so that a later miss on it decompresses the train instead of
+ *  reading the disk. The tier is exclusive: a train leaves it when it is
+ *  read back into the buffer pool, and enters it only while it is still
+ *  in the hash table of the buffer pool, under the latch of its hash
+ *  chain, so the tier never holds a copy older than the buffer pool's.
+ *
+ * Exports:
+ *  BufferTierInfo bufTier[]
+ *  BfMTierEntry *edubfm_TierPack(Four, Four)
+ *  void edubfm_TierPut(Four, BfMTierEntry *)
+ *  Boolean edubfm_TierGet(Four, BfMHashKey *, char *)
+ *  void edubfm_TierRemove(Four, BfMHashKey *)
+ *  void edubfm_TierResize(Four, Four)
+ *  void edubfm_TierClear(Four)
+ */
+
+
+#include <stdlib.h> /* for malloc & free */
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+/*@
+ * global variables
+ */
+/* compressed tiers of the buffer pools; disabled by default */
+BufferTierInfo bufTier[BFM_MAXPOOLS] = {
+    [0 ... BFM_MAXPOOLS-1] = { .mutex = PTHREAD_MUTEX_INITIALIZER }
+};
+
+/* Macro: TIER_HASH(k)
+ * Description: return the hash chain of the key
+ */
+#define TIER_HASH(k)		((UFour)((k)->volNo * 31 + (k)->pageNo) % BFM_TIERHASHSIZE)
+
+
+
+/*@================================
+ * edubfm_TierUnlink()
+ *================================*/
+/*
+ * Function: static void edubfm_TierUnlink(BufferTierInfo *, BfMTierEntry *)
+ *
+ * Description:
+ *  Take the entry out of the tier; the caller holds the mutex of the tier.
+ *
+ * Returns:
+ *  None
+ */
+static void edubfm_TierUnlink(
+    BufferTierInfo	*tier,			/* IN compressed tier */
+    BfMTierEntry	*entry)			/* IN entry to be taken out */
+{
+    BfMTierEntry	**p;
+
+
+    for (p = &tier->chain[TIER_HASH(&entry->key)]; *p != entry; p = &(*p)->nextHash);
+    *p = entry->nextHash;
+
+    if (entry->newer != NULL) entry->newer->older = entry->older;
+    else tier->newest = entry->older;
+    if (entry->older != NULL) entry->older->newer = entry->newer;
+    else tier->oldest = entry->newer;
+
+    tier->usedBytes -= sizeof(BfMTierEntry) + entry->size;
+
+} /* edubfm_TierUnlink() */
+
+
+
+/*@================================
+ * edubfm_TierFind()
+ *================================*/
+/*
+ * Function: static BfMTierEntry *edubfm_TierFind(BufferTierInfo *, BfMHashKey *)
+ *
+ * Description:
+ *  Find the entry of the train; the caller holds the mutex of the tier.
+ *
+ * Returns:
+ *  the entry, or NULL if the train is not in the tier
+ */
+static BfMTierEntry *edubfm_TierFind(
+    BufferTierInfo	*tier,			/* IN compressed tier */
+    BfMHashKey		*key)			/* IN train */
+{
+    BfMTierEntry	*entry;
+
+
+    for (entry = tier->chain[TIER_HASH(key)]; entry != NULL; entry = entry->nextHash)
+        if (EQUALKEY(&entry->key, key)) return(entry);
+
+    return(NULL);
+
+} /* edubfm_TierFind() */
+
+
+
+/*@================================
+ * edubfm_TierDropOldest()
+ *================================*/
+/*
+ * Function: static void edubfm_TierDropOldest(BufferTierInfo *, Four)
+ *
+ * Description:
+ *  Drop the oldest entries until the tier holds at most 'limit' bytes;
+ *  the caller holds the mutex of the tier.
+ *
+ * Returns:
+ *  None
+ */
+static void edubfm_TierDropOldest(
+    BufferTierInfo	*tier,			/* IN compressed tier */
+    Four		limit)			/* IN max # of bytes left */
+{
+    BfMTierEntry	*old;
+
+
+    while (tier->usedBytes > limit && tier->oldest != NULL)
+    {
+        old = tier->oldest;
+        edubfm_TierUnlink(tier, old);
+        free(old);
+    }
+
+} /* edubfm_TierDropOldest() */
+
+
+
+/*@================================
+ * edubfm_TierPack()
+ *================================*/
+/*
+ * Function: BfMTierEntry *edubfm_TierPack(Four, Four)
+ *
+ * Description:
+ *  Compress the train in the buffer element 'index', claimed by the
+ *  caller, into a new entry to be given to edubfm_TierPut() or freed.
+ *  A train which does not shrink by a quarter is not worth keeping.
+ *
+ * Returns:
+ *  the entry, or NULL if the train is not kept
+ */
+BfMTierEntry *edubfm_TierPack(
+    Four		type,			/* IN buffer type */
+    Four		index)			/* IN buffer element */
+{
+    Four		trainBytes = PAGESIZE * BI_BUFSIZE(type);
+    Four		cap = trainBytes - trainBytes / 4;
+    Four		size;
+    BfMTierEntry	*entry;
+
+
+    entry = (BfMTierEntry *)malloc(sizeof(BfMTierEntry) + cap);
+    if (entry == NULL) return(NULL);
+
+    size = edubfm_Compress(BI_BUFFER(type, index), trainBytes, TIER_DATA(entry), cap);
+    if (size == 0)
+    {
+        free(entry);
+        return(NULL);
+    }
+
+    entry = (BfMTierEntry *)realloc(entry, sizeof(BfMTierEntry) + size);	/* shrinks */
+    entry->key = BI_KEY(type, index);
+    entry->size = size;
+
+    return(entry);
+
+} /* edubfm_TierPack() */
+
+
+
+/*@================================
+ * edubfm_TierPut()
+ *================================*/
+/*
+ * Function: void edubfm_TierPut(Four, BfMTierEntry *)
+ *
+ * Description:
+ *  Keep the entry made by edubfm_TierPack() in the tier, as the newest
+ *  one, and drop the oldest entries beyond the capacity. The caller holds
+ *  the latch of the hash chain of the train, which is still in the hash
+ *  table of the buffer pool.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_TierPut(
+    Four		type,			/* IN buffer type */
+    BfMTierEntry	*entry)			/* IN entry to be kept */
+{
+    BufferTierInfo	*tier = &bufTier[type];
+    BfMTierEntry	*old;
+
+
+    pthread_mutex_lock(&tier->mutex);
+
+    old = edubfm_TierFind(tier, &entry->key);
+    if (old != NULL)
+    {
+        edubfm_TierUnlink(tier, old);
+        free(old);
+    }
+
+    entry->nextHash = tier->chain[TIER_HASH(&entry->key)];
+    tier->chain[TIER_HASH(&entry->key)] = entry;
+    entry->newer = NULL;
+    entry->older = tier->newest;
+    if (tier->newest != NULL) tier->newest->newer = entry;
+    else tier->oldest = entry;
+    tier->newest = entry;
+    tier->usedBytes += sizeof(BfMTierEntry) + entry->size;
+
+    edubfm_TierDropOldest(tier, tier->maxBytes);
+
+    pthread_mutex_unlock(&tier->mutex);
+
+    BFM_STAT_INC(type, tierStores);
+
+} /* edubfm_TierPut() */
+
+
+
+/*@================================
+ * edubfm_TierGet()
+ *================================*/
+/*
+ * Function: Boolean edubfm_TierGet(Four, BfMHashKey *, char *)
+ *
+ * Description:
+ *  Take the train out of the tier and decompress it into 'train'. The
+ *  caller has inserted the train into the hash table of the buffer pool.
+ *
+ * Returns:
+ *  TRUE if the train has been decompressed, otherwise FALSE
+ */
+Boolean edubfm_TierGet(
+    Four		type,			/* IN buffer type */
+    BfMHashKey		*key,			/* IN train */
+    char		*train)			/* OUT buffer for the train */
+{
+    BufferTierInfo	*tier = &bufTier[type];
+    BfMTierEntry	*entry;
+    Four		e;
+
+
+    if (!BI_TIER_ACTIVE(type)) return(FALSE);
+
+    pthread_mutex_lock(&tier->mutex);
+    entry = edubfm_TierFind(tier, key);
+    if (entry != NULL) edubfm_TierUnlink(tier, entry);
+    pthread_mutex_unlock(&tier->mutex);
+
+    if (entry == NULL) return(FALSE);
+
+    e = edubfm_Decompress(TIER_DATA(entry), entry->size, train, PAGESIZE * BI_BUFSIZE(type));
+    free(entry);
+    if (e < 0) return(FALSE);
+
+    BFM_STAT_INC(type, tierHits);
+
+    return(TRUE);
+
+} /* edubfm_TierGet() */
+
+
+
+/*@================================
+ * edubfm_TierRemove()
+ *================================*/
+/*
+ * Function: void edubfm_TierRemove(Four, BfMHashKey *)
+ *
+ * Description:
+ *  Drop the train from the tier, since it is read into the buffer pool
+ *  from the disk.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_TierRemove(
+    Four		type,			/* IN buffer type */
+    BfMHashKey		*key)			/* IN train */
+{
+    BufferTierInfo	*tier = &bufTier[type];
+    BfMTierEntry	*entry;
+
+
+    if (!BI_TIER_ACTIVE(type)) return;
+
+    pthread_mutex_lock(&tier->mutex);
+    entry = edubfm_TierFind(tier, key);
+    if (entry != NULL) edubfm_TierUnlink(tier, entry);
+    pthread_mutex_unlock(&tier->mutex);
+
+    free(entry);
+
+} /* edubfm_TierRemove() */
+
+
+
+/*@================================
+ * edubfm_TierResize()
+ *================================*/
+/*
+ * Function: void edubfm_TierResize(Four, Four)
+ *
+ * Description:
+ *  Set the capacity of the tier to 'maxBytes', dropping the oldest entries
+ *  beyond it; 0 disables the tier and drops all entries.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_TierResize(
+    Four		type,			/* IN buffer type */
+    Four		maxBytes)		/* IN new capacity in bytes */
+{
+    BufferTierInfo	*tier = &bufTier[type];
+
+
+    pthread_mutex_lock(&tier->mutex);
+    __atomic_store_n(&tier->maxBytes, maxBytes, __ATOMIC_RELAXED);
+    edubfm_TierDropOldest(tier, maxBytes);
+    pthread_mutex_unlock(&tier->mutex);
+
+} /* edubfm_TierResize() */
+
+
+
+/*@================================
+ * edubfm_TierClear()
+ *================================*/
+/*
+ * Function: void edubfm_TierClear(Four)
+ *
+ * Description:
+ *  Drop all entries of the tier, keeping its capacity.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_TierClear(
+    Four		type)			/* IN buffer type */
+{
+    BufferTierInfo	*tier = &bufTier[type];
+
+
+    pthread_mutex_lock(&tier->mutex);
+    edubfm_TierDropOldest(tier, 0);
+    pthread_mutex_unlock(&tier->mutex);
+
+} /* edubfm_TierClear() */
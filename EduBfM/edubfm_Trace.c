@@ -0,0 +1,123 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_Trace.c
+ *
+ * Description:
+ *  The trace recorder. While a trace is being recorded (see
+ *  EduBfM_StartTrace()), the fixes, unfixes and modifications of trains
+ *  are collected in memory and written to the trace file BFM_TRACEBUFSIZE
+ *  records at a time, so that a fix rarely waits for the disk. The trace
+ *  is replayed offline by EduBfM_TraceSim.
+ *
+ * Exports:
+ *  BufferTraceInfo bufTrace
+ *  void edubfm_TraceRecord(Four, BfMHashKey *, Four)
+ *  Four edubfm_TraceFlush(void)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+/*@
+ * global variables
+ */
+/* the trace recorder; no trace is recorded by default */
+BufferTraceInfo bufTrace = { .mutex = PTHREAD_MUTEX_INITIALIZER };
+
+
+
+/*@================================
+ * edubfm_TraceFlush()
+ *================================*/
+/*
+ * Function: Four edubfm_TraceFlush(void)
+ *
+ * Description:
+ *  Write the records collected in memory to the trace file. Once a write
+ *  has failed, the following records are dropped. The caller holds the
+ *  latch of the trace recorder.
+ *
+ * Returns:
+ *  error code
+ *    eFILEIOERR_EDUBFM - the trace file cannot be written
+ */
+Four edubfm_TraceFlush(void)
+{
+    if (!bufTrace.failed && bufTrace.nRecords > 0 &&
+        fwrite(bufTrace.record, sizeof(BfMTraceRecord), bufTrace.nRecords, bufTrace.fp) != (size_t)bufTrace.nRecords)
+        bufTrace.failed = TRUE;
+
+    bufTrace.nRecords = 0;
+
+    if (bufTrace.failed) ERR(eFILEIOERR_EDUBFM);
+
+    return(eNOERROR);
+
+} /* edubfm_TraceFlush() */
+
+
+
+/*@================================
+ * edubfm_TraceRecord()
+ *================================*/
+/*
+ * Function: void edubfm_TraceRecord(Four, BfMHashKey *, Four)
+ *
+ * Description:
+ *  Record the operation 'op' on the train 'key' of the buffer pool 'type'.
+ *  Called through the macro BFM_TRACE().
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_TraceRecord(
+    Four		op,			/* IN BFM_TRACE_XXX */
+    BfMHashKey		*key,			/* IN the train */
+    Four		type)			/* IN buffer type */
+{
+    BfMTraceRecord	*r;
+
+
+    pthread_mutex_lock(&bufTrace.mutex);
+
+    /* the trace may have been stopped since the caller looked */
+    if (bufTrace.active)
+    {
+        r = &bufTrace.record[bufTrace.nRecords++];
+        r->time = edubfm_Now() - bufTrace.start;
+        r->pageNo = key->pageNo;
+        r->volNo = key->volNo;
+        r->op = op;
+        r->type = type;
+
+        if (bufTrace.nRecords == BFM_TRACEBUFSIZE) (void) edubfm_TraceFlush();
+    }
+
+    pthread_mutex_unlock(&bufTrace.mutex);
+
+} /* edubfm_TraceRecord() */
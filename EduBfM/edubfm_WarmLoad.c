@@ -0,0 +1,216 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_WarmLoad.c
+ *
+ * Description:
+ *  Loader threads reading a saved resident set back into a buffer pool.
+ *  The trains are read the hottest first; the trains equally hot are read
+ *  in the order of their disk addresses, each run of trains adjacent on
+ *  the disk by one multi-train read.
+ *
+ * Exports:
+ *  void *edubfm_WarmLoadMain(void *)
+ *  void edubfm_StartWarmLoad(BfMWarmLoadJob *)
+ *  void edubfm_StopWarmLoad(Four, Boolean)
+ */
+
+
+#include <stdlib.h> /* for malloc, free & qsort */
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+/*@
+ * global variables
+ */
+/* loader threads of the buffer pools, started and joined under edubfm_warmLoadMutex */
+static pthread_mutex_t edubfm_warmLoadMutex = PTHREAD_MUTEX_INITIALIZER;
+static BufferWarmLoadInfo edubfm_warmLoad[BFM_MAXPOOLS];
+
+
+
+/*@================================
+ * edubfm_CompareResidentEntry()
+ *================================*/
+/*
+ * Function: static int edubfm_CompareResidentEntry(const void *, const void *)
+ *
+ * Description:
+ *  Order the entries of a resident set by heat, the hottest first, and then
+ *  by (volNo, pageNo).
+ *
+ * Returns:
+ *  negative, 0, or positive as qsort() expects
+ */
+static int edubfm_CompareResidentEntry(
+    const void		*a,			/* IN entry */
+    const void		*b)			/* IN entry */
+{
+    const BfMResidentEntry *x = (const BfMResidentEntry *)a;
+    const BfMResidentEntry *y = (const BfMResidentEntry *)b;
+
+
+    if (x->heat != y->heat) return((x->heat > y->heat) ? -1 : 1);
+    if (x->key.volNo != y->key.volNo) return((x->key.volNo < y->key.volNo) ? -1 : 1);
+    if (x->key.pageNo != y->key.pageNo) return((x->key.pageNo < y->key.pageNo) ? -1 : 1);
+
+    return(0);
+
+} /* edubfm_CompareResidentEntry() */
+
+
+
+/*@================================
+ * edubfm_WarmLoadMain()
+ *================================*/
+/*
+ * Function: void *edubfm_WarmLoadMain(void *)
+ *
+ * Description:
+ *  The body of a loader thread. Read the trains of the resident set 'arg',
+ *  a BfMWarmLoadJob, into the buffer pool, at most as many as there are
+ *  buffers, the hottest first, by multi-train reads; a train already in
+ *  the buffer pool is skipped. The load gives up between two reads once
+ *  it is cancelled by edubfm_StopWarmLoad(). The job is freed.
+ *
+ * Returns:
+ *  NULL
+ */
+void *edubfm_WarmLoadMain(
+    void		*arg)			/* IN job to be done */
+{
+    BfMWarmLoadJob	*job = (BfMWarmLoadJob *)arg;
+    Four		type = job->type;
+    BufferWarmLoadInfo	*w = &edubfm_warmLoad[type];
+    Four		nEntries;
+    Four		i;
+    Four		start;			/* first entry of the current read */
+    BfMHashKey		*keys;
+
+
+    qsort(job->entry, job->nEntries, sizeof(BfMResidentEntry), edubfm_CompareResidentEntry);
+    nEntries = MIN(job->nEntries, BI_NBUFS_LOAD(type));
+
+    keys = (BfMHashKey *)malloc(sizeof(BfMHashKey) * MAX(nEntries, 1));
+    if (keys != NULL)
+    {
+        for (i = 0; i < nEntries; i++) keys[i] = job->entry[i].key;
+
+        /* one heat at a time, so that a hot train never waits for a cold one,
+         * and at most one read at a time, so that a cancel is seen soon */
+        for (start = 0; start < nEntries && !__atomic_load_n(&w->cancel, __ATOMIC_ACQUIRE); start = i)
+        {
+            for (i = start + 1; i < nEntries && i - start < BFM_MAXREADAHEAD &&
+                 job->entry[i].heat == job->entry[start].heat; i++);
+            edubfm_PrefetchTrains(type, &keys[start], i - start);
+        }
+
+        free(keys);
+    }
+
+    free(job);
+
+    return(NULL);
+
+} /* edubfm_WarmLoadMain() */
+
+
+
+/*@================================
+ * edubfm_StartWarmLoad()
+ *================================*/
+/*
+ * Function: void edubfm_StartWarmLoad(BfMWarmLoadJob *)
+ *
+ * Description:
+ *  Start the loader thread of the buffer pool of 'job', which takes the
+ *  job over. A buffer pool has one loader at a time, so the previous
+ *  loader, if any, is finished first. If no thread can be created, the
+ *  job is done by the calling thread.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_StartWarmLoad(
+    BfMWarmLoadJob	*job)			/* IN job to be done */
+{
+    BufferWarmLoadInfo	*w = &edubfm_warmLoad[job->type];
+    Boolean		started;
+
+
+    pthread_mutex_lock(&edubfm_warmLoadMutex);
+
+    if (w->running)
+    {
+        pthread_join(w->thread, NULL);
+        w->running = FALSE;
+    }
+
+    w->cancel = FALSE;
+    started = (pthread_create(&w->thread, NULL, edubfm_WarmLoadMain, (void *)job) == 0);
+    w->running = started;
+
+    pthread_mutex_unlock(&edubfm_warmLoadMutex);
+
+    if (!started) edubfm_WarmLoadMain((void *)job);
+
+} /* edubfm_StartWarmLoad() */
+
+
+
+/*@================================
+ * edubfm_StopWarmLoad()
+ *================================*/
+/*
+ * Function: void edubfm_StopWarmLoad(Four, Boolean)
+ *
+ * Description:
+ *  Wait until the loader thread of the buffer pool, if any, exits and join
+ *  it. If 'cancel' is TRUE, the loader gives up the trains not read yet.
+ *
+ * Returns:
+ *  None
+ */
+void edubfm_StopWarmLoad(
+    Four		type,			/* IN buffer type */
+    Boolean		cancel)			/* IN give up the trains not read yet? */
+{
+    BufferWarmLoadInfo	*w = &edubfm_warmLoad[type];
+
+
+    pthread_mutex_lock(&edubfm_warmLoadMutex);
+
+    if (w->running)
+    {
+        if (cancel) __atomic_store_n(&w->cancel, TRUE, __ATOMIC_RELEASE);
+        pthread_join(w->thread, NULL);
+        w->running = FALSE;
+        w->cancel = FALSE;
+    }
+
+    pthread_mutex_unlock(&edubfm_warmLoadMutex);
+
+} /* edubfm_StopWarmLoad() */
@@ -0,0 +1,142 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBtM_BulkLoad.c
+ *
+ * Description :
+ *  Build a B+ tree bottom-up from a stream of keys and ObjectIDs sorted
+ *  in key order.
+ *
+ * Exports:
+ *  Four EduBtM_BulkLoad(ObjectID*, PageID*, KeyDesc*, Two, BtM_BulkLoadNextFunc, void*, Pool*, DeallocListElem*)
+ */
+
+
+#include <stdlib.h> /* for malloc & free */
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduBtM.h"
+
+
+
+/*@================================
+ * EduBtM_BulkLoad()
+ *================================*/
+/*
+ * Function: Four EduBtM_BulkLoad(ObjectID*, PageID*, KeyDesc*, Two, BtM_BulkLoadNextFunc, void*, Pool*, DeallocListElem*)
+ *
+ * Description :
+ *  Load the keys and ObjectIDs handed out by 'next' into the empty B+ tree
+ *  'root', which has been made by EduBtM_CreateIndex(). The keys should
+ *  come in ascending order, and the ObjectIDs of a key in ascending order.
+ *  Instead of inserting one key at a time from the root down, the leaves
+ *  are packed from left to right until 'pff' percent of each page is used,
+ *  and the internal levels are built bottom-up on top of them. 'pff' is
+ *  between 50 and 100; the room left free in the pages takes the later
+ *  insertions without splits. The root keeps its PageID.
+ *
+ *  If an error occurs the root is left empty, and the pages allocated so
+ *  far are put into the dealloc list.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eNOTSORTED_EDUBTM
+ *    eDUPLICATEDKEY_BTM
+ *    eDUPLICATEDOBJECTID_BTM
+ *    eNOTSUPPORTED_EDUBTM
+ *    eMEMORYALLOCERR_EDUBTM
+ *    some errors caused by function calls
+ */
+Four EduBtM_BulkLoad(
+    ObjectID *catObjForFile,	/* IN catalog object of B+ tree file */
+    PageID   *root,		/* IN the root of an empty Btree */
+    KeyDesc  *kdesc,		/* IN key descriptor */
+    Two      pff,		/* IN page fill factor in percent */
+    BtM_BulkLoadNextFunc next,	/* IN function handing out the sorted keys and ObjectIDs */
+    void     *arg,		/* IN argument passed to 'next' */
+    Pool     *dlPool,		/* INOUT pool of dealloc list */
+    DeallocListElem *dlHead)	/* INOUT head of the dealloc list */
+{
+    int i;
+    Four e;			/* error number */
+    BtreePage *apage;		/* pointer to the buffer holding the root */
+    Boolean isEmpty;		/* is the Btree empty? */
+    btm_BulkLoadState *state;	/* state of the bulk load */
+
+
+    /*@ check parameters */
+
+    if (catObjForFile == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (root == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (kdesc == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (next == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (dlPool == NULL || dlHead == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (pff < 50 || pff > 100) ERR(eBADPARAMETER_BTM);
+
+    /* Error check whether using not supported functionality by EduBtM */
+    for(i=0; i<kdesc->nparts; i++)
+    {
+        if(kdesc->kpart[i].type!=SM_INT && kdesc->kpart[i].type!=SM_VARSTRING)
+            ERR(eNOTSUPPORTED_EDUBTM);
+    }
+
+    /*@ the Btree should be empty */
+    e = BfM_GetTrain(root, (char **)&apage, PAGE_BUF);
+    if (e < 0) ERR(e);
+
+    isEmpty = (apage->any.hdr.type & LEAF) && apage->bl.hdr.nSlots == 0;
+
+    e = BfM_FreeTrain(root, PAGE_BUF);
+    if (e < 0) ERR(e);
+
+    if (!isEmpty) ERR(eBADPARAMETER_BTM);
+
+    /* the state holds a page per level; it is too large for the stack */
+    state = (btm_BulkLoadState *)malloc(sizeof(btm_BulkLoadState));
+    if (state == NULL) ERR(eMEMORYALLOCERR_EDUBTM);
+
+    edubtm_BulkLoadInit(state, catObjForFile, root, kdesc, pff);
+
+    e = edubtm_BulkLoadStream(state, next, arg);
+    if (e < 0) {
+        /* the error of the load is returned even if the pages are not freed */
+        (void) edubtm_BulkLoadAbort(state, dlPool, dlHead);
+        edubtm_BulkLoadFinal(state);
+        free(state);
+        ERR(e);
+    }
+
+    edubtm_BulkLoadFinal(state);
+    free(state);
+
+    return(eNOERROR);
+
+} /* EduBtM_BulkLoad() */
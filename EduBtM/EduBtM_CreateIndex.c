@@ -66,21 +66,15 @@ Four EduBtM_CreateIndex(
 {
     Four e;			/* error number */
     Boolean isTmp;
-    SlottedPage *catPage;	/* buffer page containing the catalog object */
-    sm_CatOverlayForBtree *catEntry; /* pointer to Btree file catalog information */
+    sm_CatOverlayForBtree catEntry; /* Btree file catalog information */
     PhysicalFileID pFid;	/* physical file ID */
 
     /* Get the B+ tree file's FileID from the catalog object */
-    e = BfM_GetTrain((TrainID*)catObjForFile, (char**)&catPage, PAGE_BUF);
-    if (e < 0) ERR(e);
-    
-    GET_PTR_TO_CATENTRY_FOR_BTREE(catObjForFile, catPage, catEntry);
-    
-    MAKE_PHYSICALFILEID(pFid, catEntry->fid.volNo, catEntry->firstPage); 
-    
-    e = BfM_FreeTrain((TrainID*)catObjForFile, PAGE_BUF);
+    e = edubtm_GetCatalogEntry(catObjForFile, &catEntry);
     if (e < 0) ERR(e);
 
+    MAKE_PHYSICALFILEID(pFid, catEntry.fid.volNo, catEntry.firstPage);
+
     /* Allocate a new btree page for the root of a btree. */
     e = btm_AllocPage(catObjForFile, (PageID *)&pFid, rootPid); 
     if (e < 0)  ERR(e);
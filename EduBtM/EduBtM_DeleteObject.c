@@ -78,8 +78,7 @@ Four EduBtM_DeleteObject(
     Boolean lf;			/* flag for merging */
     Boolean lh;			/* flag for splitting */
     InternalItem item;		/* Internal item */
-    SlottedPage *catPage;	/* buffer page containing the catalog object */
-    sm_CatOverlayForBtree *catEntry; /* pointer to Btree file catalog information */
+    sm_CatOverlayForBtree catEntry; /* Btree file catalog information */
     PhysicalFileID pFid;        /* B+-tree file's FileID */
 
 
@@ -107,18 +106,11 @@ Four EduBtM_DeleteObject(
     e = edubtm_Delete(catObjForFile, root, kdesc, kval, oid, &lf, &lh, &item, dlPool, dlHead);
     if (e < 0) ERR(e);
 
-    /*@ get the page */
     /* Get the B+ tree file's FileID from the catalog object */
-    e = BfM_GetTrain((TrainID*)catObjForFile, (char**)&catPage, PAGE_BUF);
+    e = edubtm_GetCatalogEntry(catObjForFile, &catEntry);
     if (e < 0) ERR(e);
-    
-    GET_PTR_TO_CATENTRY_FOR_BTREE(catObjForFile, catPage, catEntry);
-    
-    MAKE_PHYSICALFILEID(pFid, catEntry->fid.volNo, catEntry->firstPage); 
 
-    /*@ free the page */
-    e = BfM_FreeTrain((TrainID*)catObjForFile, PAGE_BUF);
-    if (e < 0) ERR(e);
+    MAKE_PHYSICALFILEID(pFid, catEntry.fid.volNo, catEntry.firstPage);
     
     
     /*
@@ -65,6 +65,9 @@ Four EduBtM_DropIndex(
     /*@ Free all pages concerned with the root. */
     e = btm_FreePages(pFid, rootPid, dlPool, dlHead);
     if (e < 0) ERR(e);
+
+    /*@ Forget the cached catalog information of the B+ tree file. */
+    edubtm_InvalidateCatalogEntry(pFid);
 	
     return(eNOERROR);
     
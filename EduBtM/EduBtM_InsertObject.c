@@ -73,8 +73,7 @@ Four EduBtM_InsertObject(
     Boolean lh;			/* for spliting */
     Boolean lf;			/* for merging */
     InternalItem item;		/* Internal Item */
-    SlottedPage *catPage;	/* buffer page containing the catalog object */
-    sm_CatOverlayForBtree *catEntry; /* pointer to Btree file catalog information */
+    sm_CatOverlayForBtree catEntry; /* Btree file catalog information */
     PhysicalFileID pFid;	 /* B+-tree file's FileID */
 
     
@@ -98,16 +97,11 @@ Four EduBtM_InsertObject(
     }
 
      /* Get the B+ tree file's FileID from the catalog object */
-    e = BfM_GetTrain((TrainID*)catObjForFile, (char**)&catPage, PAGE_BUF);
-    if (e < 0) ERR(e);
-    
-    GET_PTR_TO_CATENTRY_FOR_BTREE(catObjForFile, catPage, catEntry);
-    
-    MAKE_PHYSICALFILEID(pFid, catEntry->fid.volNo, catEntry->firstPage); 
-    
-    e = BfM_FreeTrain((TrainID*)catObjForFile, PAGE_BUF);
+    e = edubtm_GetCatalogEntry(catObjForFile, &catEntry);
     if (e < 0) ERR(e);
 
+    MAKE_PHYSICALFILEID(pFid, catEntry.fid.volNo, catEntry.firstPage);
+
     /*@ insert the object */
     e = edubtm_Insert(catObjForFile, root, kdesc, kval, oid, &lf, &lh, &item, dlPool, dlHead);
     if (e < 0) ERR(e);
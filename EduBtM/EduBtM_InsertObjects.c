@@ -0,0 +1,152 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBtM_InsertObjects.c
+ *
+ * Description :
+ *  Insert a batch of ObjectIDs with their key values into a Btree.
+ *
+ * Exports:
+ *  Four EduBtM_InsertObjects(ObjectID*, PageID*, KeyDesc*, Four, KeyValue*, ObjectID*, Pool*, DeallocListElem*)
+ */
+
+
+#include <stdlib.h> /* for malloc & free */
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduBtM.h"
+#include "OM_Internal.h"
+
+
+
+/*@================================
+ * EduBtM_InsertObjects()
+ *================================*/
+/*
+ * Function: Four EduBtM_InsertObjects(ObjectID*, PageID*, KeyDesc*, Four, KeyValue*, ObjectID*, Pool*, DeallocListElem*)
+ *
+ * Description :
+ *  Insert the 'nKeys' ObjectIDs 'oids' into a Btree whose key values are
+ *  'kvals'. The batch is sorted by the key, and the Btree is descended
+ *  once for all the keys going into the same leaf, rather than once for
+ *  each key; a leaf is fixed and set dirty once for those keys, and is
+ *  splitted at most once before the descent goes on from its parent.
+ *
+ *  The keys are inserted in key order. If a key can not be inserted, e.g.
+ *  a duplicated key of a unique index, the error is returned and the keys
+ *  before it in key order remain inserted.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eMEMORYALLOCERR_EDUBTM
+ *    some errors caused by function calls
+ */
+Four EduBtM_InsertObjects(
+    ObjectID *catObjForFile,	/* IN catalog object of B+ tree file */
+    PageID   *root,		/* IN the root of Btree */
+    KeyDesc  *kdesc,		/* IN key descriptor */
+    Four     nKeys,		/* IN # of keys in the batch */
+    KeyValue *kvals,		/* IN key values */
+    ObjectID *oids,		/* IN ObjectIDs which will be inserted */
+    Pool     *dlPool,		/* INOUT pool of dealloc list */
+    DeallocListElem *dlHead) /* INOUT head of the dealloc list */
+{
+    int i;
+    Four e;			/* error number */
+    Boolean lh;			/* for spliting */
+    Boolean lf;			/* for merging */
+    InternalItem item;		/* Internal Item */
+    btm_InsertBatch batch;	/* the batch being inserted */
+    sm_CatOverlayForBtree catEntry; /* Btree file catalog information */
+    PhysicalFileID pFid;	 /* B+-tree file's FileID */
+
+
+    /*@ check parameters */
+
+    if (catObjForFile == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (root == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (kdesc == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (nKeys < 0) ERR(eBADPARAMETER_BTM);
+
+    if (nKeys > 0 && (kvals == NULL || oids == NULL)) ERR(eBADPARAMETER_BTM);
+
+    /* Error check whether using not supported functionality by EduBtM */
+    for(i=0; i<kdesc->nparts; i++)
+    {
+        if(kdesc->kpart[i].type!=SM_INT && kdesc->kpart[i].type!=SM_VARSTRING)
+            ERR(eNOTSUPPORTED_EDUBTM);
+    }
+
+    if (nKeys == 0) return(eNOERROR);
+
+    /* Get the B+ tree file's FileID from the catalog object */
+    e = edubtm_GetCatalogEntry(catObjForFile, &catEntry);
+    if (e < 0) ERR(e);
+
+    MAKE_PHYSICALFILEID(pFid, catEntry.fid.volNo, catEntry.firstPage);
+
+    /*@ sort the batch; the second half of 'order' is the work area */
+    batch.kdesc = kdesc;
+    batch.kval = kvals;
+    batch.oid = oids;
+    batch.next = 0;
+    batch.order = (Four *)malloc(sizeof(Four) * 2 * nKeys);
+    if (batch.order == NULL) ERR(eMEMORYALLOCERR_EDUBTM);
+
+    edubtm_SortBatch(&batch, nKeys, &(batch.order[nKeys]));
+
+    /*@ insert the objects; each pass goes on until the root is splitted */
+    while (batch.next < nKeys) {
+        e = edubtm_InsertBatch(catObjForFile, root, &batch, nKeys, &lf, &lh, &item, dlPool, dlHead);
+        if (e < 0) {
+            free(batch.order);
+            ERR(e);
+        }
+
+        if (lh) {	/* the root was splitted */
+            e = edubtm_root_insert(catObjForFile, root, &item);
+            if (e < 0) {
+                free(batch.order);
+                ERR(e);
+            }
+
+        } else if (lf) {  /* the root was merged */
+            e = btm_root_delete(&pFid, root, dlPool, dlHead);
+            if (e < 0) {
+                free(batch.order);
+                ERR(e);
+            }
+        }
+    }
+
+    free(batch.order);
+
+    return(eNOERROR);
+
+}   /* EduBtM_InsertObjects() */
@@ -0,0 +1,846 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBtM_UnitTest.c
+ *
+ * Description :
+ *  Main routine of the EduBtM unit tests. Unlike EduBtM_Test, whose output
+ *  is compared with a solution, each test checks the B+ trees it builds
+ *  itself and prints "ok" or the first mismatch found. The tests run on a
+ *  volume of their own.
+ *
+ *  Usage: EduBtM_UnitTest
+ *  The exit status is the # of failed tests.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "EduBtM_common.h"
+#include "EduBtM.h"
+#include "EduBtM_TestModule.h"
+#include "Util_hash.h"
+#include "BfM.h"
+
+
+/*@
+ * constant definitions
+ */
+#define UT_VOLNO	1001		/* volume of the tests */
+#define UT_NOSORTERROR	-1		/* the stream of a test is sorted */
+#define UT_MAXBATCH	3000		/* max # of keys of a batch */
+
+
+/* stream of integer keys handed out to EduBtM_BulkLoad() */
+typedef struct {
+    Four	nObjects;		/* # of ObjectIDs in the stream */
+    Four	nOids;			/* # of ObjectIDs of a key */
+    Four	unsortedAt;		/* ObjectID whose key goes back, or UT_NOSORTERROR */
+    Four	next;			/* ObjectID to be handed out next */
+} UTStream;
+
+
+/*@
+ * storage system function prototypes
+ */
+Four SM_CreateFile(Four, FileID*, Boolean, void*);
+Four sm_GetCatalogEntryFromDataFileId(Four, FileID*, ObjectID*);
+
+
+/* object map of the test drivers, which util_hash.o refers to; not used here */
+const struct objectMapStruct *objectMap = NULL;
+
+/* catalog object of the B+ tree file of the tests */
+static ObjectID edubtm_ut_catObj;
+
+/* key descriptor of the B+ trees of the tests */
+static KeyDesc edubtm_ut_kdesc;
+
+/* keys and ObjectIDs of a batch given to EduBtM_InsertObjects() */
+static KeyValue edubtm_ut_kvals[UT_MAXBATCH];
+static ObjectID edubtm_ut_oids[UT_MAXBATCH];
+
+
+
+/*@================================
+ * edubtm_ut_key()
+ *================================*/
+/*
+ * Function: static void edubtm_ut_key(KeyValue *, Four)
+ *
+ * Description:
+ *  Make the integer key 'k'.
+ *
+ * Returns:
+ *  None
+ */
+static void edubtm_ut_key(
+    KeyValue		*kval,			/* OUT key value */
+    Four		k)			/* IN integer key */
+{
+    kval->len = sizeof(Four);
+    memcpy(&(kval->val[0]), &k, sizeof(Four));
+
+} /* edubtm_ut_key() */
+
+
+
+/*@================================
+ * edubtm_ut_oid()
+ *================================*/
+/*
+ * Function: static void edubtm_ut_oid(ObjectID *, Four)
+ *
+ * Description:
+ *  Make the 'i'-th ObjectID of the tests; the ObjectIDs ascend with 'i'.
+ *
+ * Returns:
+ *  None
+ */
+static void edubtm_ut_oid(
+    ObjectID		*oid,			/* OUT ObjectID */
+    Four		i)			/* IN # of the ObjectID */
+{
+    oid->volNo = UT_VOLNO;
+    oid->pageNo = 1 + i / 30000;
+    oid->slotNo = i % 30000;
+    oid->unique = i;
+
+} /* edubtm_ut_oid() */
+
+
+
+/*@================================
+ * edubtm_ut_next()
+ *================================*/
+/*
+ * Function: static Four edubtm_ut_next(void *, KeyValue *, ObjectID *)
+ *
+ * Description:
+ *  Hand out the next key and ObjectID of the stream 'arg'. The 'i'-th
+ *  ObjectID has the key 2 * (i / nOids), so that the odd keys are not in
+ *  the B+ tree; at 'unsortedAt' the key goes back to 0.
+ *
+ * Returns:
+ *  TRUE, or FALSE at the end of the stream
+ */
+static Four edubtm_ut_next(
+    void		*arg,			/* INOUT the stream */
+    KeyValue		*kval,			/* OUT key value */
+    ObjectID		*oid)			/* OUT ObjectID */
+{
+    UTStream		*stream = (UTStream *)arg;
+    Four		i;
+
+
+    if (stream->next >= stream->nObjects) return(FALSE);
+
+    i = stream->next++;
+
+    edubtm_ut_key(kval, (i == stream->unsortedAt) ? 0 : 2 * (i / stream->nOids));
+    edubtm_ut_oid(oid, i);
+
+    return(TRUE);
+
+} /* edubtm_ut_next() */
+
+
+
+/*@================================
+ * edubtm_ut_dropIndex()
+ *================================*/
+/*
+ * Function: static Four edubtm_ut_dropIndex(PageID *)
+ *
+ * Description:
+ *  Drop the B+ tree 'root' of the B+ tree file of the tests.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+static Four edubtm_ut_dropIndex(
+    PageID		*root)			/* IN root of the B+ tree */
+{
+    Four		e;			/* error */
+    sm_CatOverlayForBtree catEntry;		/* B+ tree file information */
+    PhysicalFileID	pFid;			/* FileID of the B+ tree file */
+
+
+    e = edubtm_GetCatalogEntry(&edubtm_ut_catObj, &catEntry);
+    if (e < 0) ERR(e);
+
+    MAKE_PHYSICALFILEID(pFid, catEntry.fid.volNo, catEntry.firstPage);
+
+    e = EduBtM_DropIndex(&pFid, root, &dlPool, &dlHead);
+    if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* edubtm_ut_dropIndex() */
+
+
+
+/*@================================
+ * edubtm_ut_scan()
+ *================================*/
+/*
+ * Function: static Four edubtm_ut_scan(PageID *, Four *, Boolean *)
+ *
+ * Description:
+ *  Scan the whole B+ tree 'root' with EduBtM_Fetch() and EduBtM_FetchNext(),
+ *  and check that the key and the ObjectID ascend together.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) parameter nObjects
+ *     # of ObjectIDs scanned
+ *  2) parameter ordered
+ *     TRUE if each (key, ObjectID) is greater than the one before
+ */
+static Four edubtm_ut_scan(
+    PageID		*root,			/* IN root of the B+ tree */
+    Four		*nObjects,		/* OUT # of ObjectIDs scanned */
+    Boolean		*ordered)		/* OUT are they in order? */
+{
+    Four		e;			/* error */
+    Four		k;			/* key of the cursor */
+    Four		prevKey = -1;		/* key of the cursor before */
+    Four		prevUnique = -1;	/* ObjectID of the cursor before */
+    KeyValue		kval;
+    BtreeCursor		cursor;
+    BtreeCursor		next;
+
+
+    *nObjects = 0;
+    *ordered = TRUE;
+
+    e = EduBtM_Fetch(root, &edubtm_ut_kdesc, &kval, SM_BOF, &kval, SM_EOF, &cursor);
+    if (e < 0) ERR(e);
+
+    while (cursor.flag != CURSOR_EOS)
+    {
+        memcpy(&k, &(cursor.key.val[0]), sizeof(Four));
+
+        if (k < prevKey || (k == prevKey && cursor.oid.unique <= prevUnique))
+            *ordered = FALSE;
+
+        prevKey = k;
+        prevUnique = cursor.oid.unique;
+        (*nObjects)++;
+
+        e = EduBtM_FetchNext(root, &edubtm_ut_kdesc, &kval, SM_EOF, &cursor, &next);
+        if (e < 0) ERR(e);
+
+        cursor = next;
+    }
+
+    return(eNOERROR);
+
+} /* edubtm_ut_scan() */
+
+
+
+/*@================================
+ * edubtm_ut_nDealloc()
+ *================================*/
+/*
+ * Function: static Four edubtm_ut_nDealloc(void)
+ *
+ * Description:
+ *  Count the elements of the dealloc list of the tests.
+ *
+ * Returns:
+ *  # of elements
+ */
+static Four edubtm_ut_nDealloc(void)
+{
+    Four		n = 0;
+    DeallocListElem	*dlElem;
+
+
+    for (dlElem = dlHead.next; dlElem != NULL; dlElem = dlElem->next) n++;
+
+    return(n);
+
+} /* edubtm_ut_nDealloc() */
+
+
+
+/*@================================
+ * edubtm_ut_bulkLoad()
+ *================================*/
+/*
+ * Function: static Four edubtm_ut_bulkLoad(void)
+ *
+ * Description:
+ *  Load B+ trees with EduBtM_BulkLoad() at several fill factors, with a
+ *  key per ObjectID and with three ObjectIDs per key. Every key loaded is
+ *  fetched, none of the keys between them is found, and a full scan
+ *  returns every ObjectID in order.
+ *
+ * Returns:
+ *  # of failed loads
+ */
+static Four edubtm_ut_bulkLoad(void)
+{
+    Four		e;			/* error */
+    Four		c, i;
+    Four		nKeys;			/* # of keys loaded */
+    Four		nObjects;		/* # of ObjectIDs scanned */
+    Boolean		ordered;		/* are they in order? */
+    Four		nFailed = 0;
+    PageID		root;
+    KeyValue		kval;
+    BtreeCursor		cursor;
+    UTStream		stream;
+    static struct {
+        Two		pff;			/* page fill factor */
+        Four		nObjects;		/* # of ObjectIDs loaded */
+        Four		nOids;			/* # of ObjectIDs of a key */
+    } cases[] = {
+        { 100, 5000, 1 }, { 75, 5000, 1 }, { 50, 5000, 1 },
+        { 100, 1, 1 }, { 90, 6000, 3 }
+    };
+
+
+    for (c = 0; c < sizeof(cases) / sizeof(cases[0]); c++)
+    {
+        edubtm_ut_kdesc.flag = (cases[c].nOids == 1) ? KEYFLAG_UNIQUE : 0;
+
+        stream.nObjects = cases[c].nObjects;
+        stream.nOids = cases[c].nOids;
+        stream.unsortedAt = UT_NOSORTERROR;
+        stream.next = 0;
+
+        e = EduBtM_CreateIndex(&edubtm_ut_catObj, &root);
+        if (e >= 0) e = EduBtM_BulkLoad(&edubtm_ut_catObj, &root, &edubtm_ut_kdesc, cases[c].pff,
+                                        edubtm_ut_next, &stream, &dlPool, &dlHead);
+        if (e < 0)
+        {
+            printf("bulk load pff %ld: load failed (%ld)\n", (long)cases[c].pff, (long)e);
+            nFailed++;
+            continue;
+        }
+
+        nKeys = (cases[c].nObjects + cases[c].nOids - 1) / cases[c].nOids;
+
+        for (i = 0; i < nKeys; i++)
+        {
+            edubtm_ut_key(&kval, 2 * i);
+            e = EduBtM_Fetch(&root, &edubtm_ut_kdesc, &kval, SM_EQ, &kval, SM_EQ, &cursor);
+            if (e < 0 || cursor.flag == CURSOR_EOS || cursor.oid.unique != i * cases[c].nOids)
+            {
+                printf("bulk load pff %ld: key %ld not fetched\n", (long)cases[c].pff, (long)(2 * i));
+                break;
+            }
+
+            edubtm_ut_key(&kval, 2 * i + 1);
+            e = EduBtM_Fetch(&root, &edubtm_ut_kdesc, &kval, SM_EQ, &kval, SM_EQ, &cursor);
+            if (e < 0 || cursor.flag != CURSOR_EOS)
+            {
+                printf("bulk load pff %ld: key %ld fetched, which was not loaded\n", (long)cases[c].pff, (long)(2 * i + 1));
+                break;
+            }
+        }
+
+        if (i == nKeys)
+        {
+            e = edubtm_ut_scan(&root, &nObjects, &ordered);
+            if (e < 0 || nObjects != cases[c].nObjects || !ordered)
+                printf("bulk load pff %ld: scan returned %ld of %ld objects%s\n", (long)cases[c].pff,
+                       (long)nObjects, (long)cases[c].nObjects, ordered ? "" : " out of order");
+            else
+                printf("bulk load pff %ld, %ld objects, %ld per key: ok\n", (long)cases[c].pff,
+                       (long)cases[c].nObjects, (long)cases[c].nOids);
+        }
+
+        if (i < nKeys || e < 0 || nObjects != cases[c].nObjects || !ordered) nFailed++;
+
+        e = edubtm_ut_dropIndex(&root);
+        if (e < 0) printf("bulk load pff %ld: drop failed (%ld)\n", (long)cases[c].pff, (long)e);
+    }
+
+    return(nFailed);
+
+} /* edubtm_ut_bulkLoad() */
+
+
+
+/*@================================
+ * edubtm_ut_bulkLoadRejected()
+ *================================*/
+/*
+ * Function: static Four edubtm_ut_bulkLoadRejected(void)
+ *
+ * Description:
+ *  Check that EduBtM_BulkLoad() rejects fill factors out of 50 ~ 100 and
+ *  an unsorted stream. The rejected loads leave the B+ tree empty, the
+ *  pages of the unsorted load go into the dealloc list, and a good load
+ *  into the same B+ tree succeeds afterwards.
+ *
+ * Returns:
+ *  # of failed checks
+ */
+static Four edubtm_ut_bulkLoadRejected(void)
+{
+    Four		e;			/* error */
+    Four		c;
+    Four		nObjects;		/* # of ObjectIDs scanned */
+    Four		nDealloc;		/* # of pages in the dealloc list before the load */
+    Boolean		ordered;
+    Four		nFailed = 0;
+    PageID		root;
+    UTStream		stream;
+    static Two		badPff[] = { 0, 49, 101, -1 };
+
+
+    edubtm_ut_kdesc.flag = KEYFLAG_UNIQUE;
+
+    e = EduBtM_CreateIndex(&edubtm_ut_catObj, &root);
+    if (e < 0)
+    {
+        printf("bulk load rejected: EduBtM_CreateIndex() failed (%ld)\n", (long)e);
+        return(1);
+    }
+
+    for (c = 0; c < sizeof(badPff) / sizeof(badPff[0]); c++)
+    {
+        stream.nObjects = 100;
+        stream.nOids = 1;
+        stream.unsortedAt = UT_NOSORTERROR;
+        stream.next = 0;
+
+        e = EduBtM_BulkLoad(&edubtm_ut_catObj, &root, &edubtm_ut_kdesc, badPff[c],
+                            edubtm_ut_next, &stream, &dlPool, &dlHead);
+        if (e != eBADPARAMETER_BTM || stream.next != 0)
+        {
+            printf("bulk load rejected: pff %ld returned %ld\n", (long)badPff[c], (long)e);
+            nFailed++;
+        }
+    }
+
+    /* the unsorted key comes after several leaves have been written */
+    stream.nObjects = 3000;
+    stream.nOids = 1;
+    stream.unsortedAt = 2500;
+    stream.next = 0;
+    nDealloc = edubtm_ut_nDealloc();
+
+    e = EduBtM_BulkLoad(&edubtm_ut_catObj, &root, &edubtm_ut_kdesc, 100,
+                        edubtm_ut_next, &stream, &dlPool, &dlHead);
+    if (e != eNOTSORTED_EDUBTM)
+    {
+        printf("bulk load rejected: unsorted stream returned %ld\n", (long)e);
+        nFailed++;
+    }
+    else if (edubtm_ut_nDealloc() == nDealloc)
+    {
+        printf("bulk load rejected: pages of the unsorted stream not freed\n");
+        nFailed++;
+    }
+
+    e = edubtm_ut_scan(&root, &nObjects, &ordered);
+    if (e < 0 || nObjects != 0)
+    {
+        printf("bulk load rejected: B+ tree not empty after the rejected loads\n");
+        nFailed++;
+    }
+
+    stream.nObjects = 3000;
+    stream.unsortedAt = UT_NOSORTERROR;
+    stream.next = 0;
+
+    e = EduBtM_BulkLoad(&edubtm_ut_catObj, &root, &edubtm_ut_kdesc, 100,
+                        edubtm_ut_next, &stream, &dlPool, &dlHead);
+    if (e >= 0) e = edubtm_ut_scan(&root, &nObjects, &ordered);
+    if (e < 0 || nObjects != 3000 || !ordered)
+    {
+        printf("bulk load rejected: load after the rejected loads failed (%ld)\n", (long)e);
+        nFailed++;
+    }
+
+    e = edubtm_ut_dropIndex(&root);
+    if (e < 0) printf("bulk load rejected: drop failed (%ld)\n", (long)e);
+
+    if (nFailed == 0) printf("bulk load rejected: ok\n");
+
+    return(nFailed);
+
+} /* edubtm_ut_bulkLoadRejected() */
+
+
+
+/*@================================
+ * edubtm_ut_rootIsInternal()
+ *================================*/
+/*
+ * Function: static Boolean edubtm_ut_rootIsInternal(PageID *)
+ *
+ * Description:
+ *  Has the root 'root' been splitted, i.e. is it an internal page?
+ *
+ * Returns:
+ *  TRUE or FALSE
+ */
+static Boolean edubtm_ut_rootIsInternal(
+    PageID		*root)			/* IN root of the B+ tree */
+{
+    Four		e;			/* error */
+    Boolean		isInternal;
+    BtreePage		*apage;
+
+
+    e = BfM_GetTrain(root, (char **)&apage, PAGE_BUF);
+    if (e < 0) return(FALSE);
+
+    isInternal = (apage->any.hdr.type & INTERNAL) ? TRUE : FALSE;
+
+    (Four) BfM_FreeTrain(root, PAGE_BUF);
+
+    return(isInternal);
+
+} /* edubtm_ut_rootIsInternal() */
+
+
+
+/*@================================
+ * edubtm_ut_batch()
+ *================================*/
+/*
+ * Function: static Four edubtm_ut_batch(PageID *, Four *, Four, Four)
+ *
+ * Description:
+ *  Insert a batch of the 'n' ObjectIDs 'objNos' of the stream of
+ *  edubtm_ut_next() with 'nOids' ObjectIDs per key, using
+ *  EduBtM_InsertObjects(). They are given in the shuffled order
+ *  i * 7919 mod n, so that the keys of the batch are not sorted.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+static Four edubtm_ut_batch(
+    PageID		*root,			/* IN root of the B+ tree */
+    Four		*objNos,		/* IN # of the ObjectIDs of the batch */
+    Four		n,			/* IN # of ObjectIDs of the batch */
+    Four		nOids)			/* IN # of ObjectIDs of a key */
+{
+    Four		i;
+    Four		objNo;
+
+
+    for (i = 0; i < n; i++)
+    {
+        objNo = objNos[(Four)(((long)i * 7919) % n)];
+
+        edubtm_ut_key(&edubtm_ut_kvals[i], 2 * (objNo / nOids));
+        edubtm_ut_oid(&edubtm_ut_oids[i], objNo);
+    }
+
+    return(EduBtM_InsertObjects(&edubtm_ut_catObj, root, &edubtm_ut_kdesc, n,
+                                edubtm_ut_kvals, edubtm_ut_oids, &dlPool, &dlHead));
+
+} /* edubtm_ut_batch() */
+
+
+
+/*@================================
+ * edubtm_ut_check()
+ *================================*/
+/*
+ * Function: static Boolean edubtm_ut_check(char *, PageID *, Four, Four)
+ *
+ * Description:
+ *  Check that the B+ tree 'root' holds the ObjectIDs 0 ~ n-1 of the stream
+ *  of edubtm_ut_next() with 'nOids' ObjectIDs per key: each key is fetched
+ *  with its first ObjectID, and a full scan returns all of them in order.
+ *  The first mismatch is printed after 'name'.
+ *
+ * Returns:
+ *  TRUE if the B+ tree is right
+ */
+static Boolean edubtm_ut_check(
+    char		*name,			/* IN name of the test */
+    PageID		*root,			/* IN root of the B+ tree */
+    Four		n,			/* IN # of ObjectIDs */
+    Four		nOids)			/* IN # of ObjectIDs of a key */
+{
+    Four		e;			/* error */
+    Four		i;
+    Four		nObjects;		/* # of ObjectIDs scanned */
+    Boolean		ordered;
+    KeyValue		kval;
+    BtreeCursor		cursor;
+
+
+    for (i = 0; i < (n + nOids - 1) / nOids; i++)
+    {
+        edubtm_ut_key(&kval, 2 * i);
+        e = EduBtM_Fetch(root, &edubtm_ut_kdesc, &kval, SM_EQ, &kval, SM_EQ, &cursor);
+        if (e < 0 || cursor.flag == CURSOR_EOS || cursor.oid.unique != i * nOids)
+        {
+            printf("%s: key %ld not fetched\n", name, (long)(2 * i));
+            return(FALSE);
+        }
+    }
+
+    e = edubtm_ut_scan(root, &nObjects, &ordered);
+    if (e < 0 || nObjects != n || !ordered)
+    {
+        printf("%s: scan returned %ld of %ld objects%s\n", name, (long)nObjects, (long)n,
+               ordered ? "" : " out of order");
+        return(FALSE);
+    }
+
+    return(TRUE);
+
+} /* edubtm_ut_check() */
+
+
+
+/*@================================
+ * edubtm_ut_insertBatch()
+ *================================*/
+/*
+ * Function: static Four edubtm_ut_insertBatch(void)
+ *
+ * Description:
+ *  Insert batches with EduBtM_InsertObjects(): a batch of one key, an
+ *  unsorted batch which splits the root, batches of three ObjectIDs per
+ *  key which go into the entries of keys inserted before, and a batch
+ *  holding a key already in a unique B+ tree, which inserts the keys
+ *  before it in key order only.
+ *
+ * Returns:
+ *  # of failed checks
+ */
+static Four edubtm_ut_insertBatch(void)
+{
+    Four		e;			/* error */
+    Four		i, n;
+    Four		nFailed = 0;
+    PageID		root;
+    KeyValue		kval;
+    BtreeCursor		cursor;
+    static Four		objNos[UT_MAXBATCH];	/* ObjectIDs of a batch */
+    static Four		dupKeys[] = { 1, 3, 5, 50, 101 }; /* 50 is in the B+ tree */
+
+
+    /*@ a batch of one key */
+    edubtm_ut_kdesc.flag = KEYFLAG_UNIQUE;
+    objNos[0] = 0;
+
+    e = EduBtM_CreateIndex(&edubtm_ut_catObj, &root);
+    if (e >= 0) e = edubtm_ut_batch(&root, objNos, 1, 1);
+    if (e < 0)
+    {
+        printf("batch of one key: insertion failed (%ld)\n", (long)e);
+        nFailed++;
+    }
+    else if (edubtm_ut_check("batch of one key", &root, 1, 1))
+        printf("batch of one key: ok\n");
+    else
+        nFailed++;
+
+    /*@ an unsorted batch which splits the root */
+    for (i = 0; i < UT_MAXBATCH - 1; i++) objNos[i] = i + 1;
+
+    if (e >= 0) e = edubtm_ut_batch(&root, objNos, UT_MAXBATCH - 1, 1);
+    if (e < 0)
+    {
+        printf("batch splitting the root: insertion failed (%ld)\n", (long)e);
+        nFailed++;
+    }
+    else if (!edubtm_ut_rootIsInternal(&root))
+    {
+        printf("batch splitting the root: root not splitted\n");
+        nFailed++;
+    }
+    else if (edubtm_ut_check("batch splitting the root", &root, UT_MAXBATCH, 1))
+        printf("batch splitting the root: ok\n");
+    else
+        nFailed++;
+
+    /*@ a key already in the unique B+ tree stops the batch */
+    n = sizeof(dupKeys) / sizeof(dupKeys[0]);
+    for (i = 0; i < n; i++)
+    {
+        edubtm_ut_key(&edubtm_ut_kvals[i], dupKeys[i]);
+        edubtm_ut_oid(&edubtm_ut_oids[i], UT_MAXBATCH + i);
+    }
+
+    e = EduBtM_InsertObjects(&edubtm_ut_catObj, &root, &edubtm_ut_kdesc, n,
+                             edubtm_ut_kvals, edubtm_ut_oids, &dlPool, &dlHead);
+    if (e != eDUPLICATEDKEY_BTM)
+    {
+        printf("batch with a duplicated key: returned %ld\n", (long)e);
+        nFailed++;
+    }
+    else
+    {
+        edubtm_ut_key(&kval, 5);
+        e = EduBtM_Fetch(&root, &edubtm_ut_kdesc, &kval, SM_EQ, &kval, SM_EQ, &cursor);
+        if (e < 0 || cursor.flag == CURSOR_EOS)
+        {
+            printf("batch with a duplicated key: key 5 before it not inserted\n");
+            nFailed++;
+        }
+        else
+        {
+            edubtm_ut_key(&kval, 101);
+            e = EduBtM_Fetch(&root, &edubtm_ut_kdesc, &kval, SM_EQ, &kval, SM_EQ, &cursor);
+            if (e < 0 || cursor.flag != CURSOR_EOS)
+            {
+                printf("batch with a duplicated key: key 101 after it inserted\n");
+                nFailed++;
+            }
+            else
+                printf("batch with a duplicated key: ok\n");
+        }
+    }
+
+    e = edubtm_ut_dropIndex(&root);
+    if (e < 0) printf("batch: drop failed (%ld)\n", (long)e);
+
+    /*@ duplicated keys in a batch and in the B+ tree */
+    edubtm_ut_kdesc.flag = 0;
+
+    /* the first ObjectID of each key, then the other two of each key */
+    for (i = 0; i < UT_MAXBATCH / 3; i++) objNos[i] = 3 * i;
+
+    e = EduBtM_CreateIndex(&edubtm_ut_catObj, &root);
+    if (e >= 0) e = edubtm_ut_batch(&root, objNos, UT_MAXBATCH / 3, 3);
+
+    for (i = 0, n = 0; i < UT_MAXBATCH; i++)
+        if (i % 3 != 0) objNos[n++] = i;
+
+    if (e >= 0) e = edubtm_ut_batch(&root, objNos, n, 3);
+    if (e < 0)
+    {
+        printf("batch with duplicated keys: insertion failed (%ld)\n", (long)e);
+        nFailed++;
+    }
+    else if (edubtm_ut_check("batch with duplicated keys", &root, UT_MAXBATCH, 3))
+        printf("batch with duplicated keys: ok\n");
+    else
+        nFailed++;
+
+    /*@ the same key and ObjectID twice in a batch */
+    if (e >= 0)
+    {
+        objNos[0] = objNos[1] = UT_MAXBATCH + 3;
+
+        e = edubtm_ut_batch(&root, objNos, 2, 3);
+        if (e != eDUPLICATEDOBJECTID_BTM)
+        {
+            printf("batch with a duplicated ObjectID: returned %ld\n", (long)e);
+            nFailed++;
+        }
+        else
+            printf("batch with a duplicated ObjectID: ok\n");
+    }
+
+    e = edubtm_ut_dropIndex(&root);
+    if (e < 0) printf("batch: drop failed (%ld)\n", (long)e);
+
+    return(nFailed);
+
+} /* edubtm_ut_insertBatch() */
+
+
+
+/*@================================
+ * main()
+ *================================*/
+/*
+ * Function: Four main(Four, char **)
+ *
+ * Description:
+ *  Format and mount the volume of the tests, create the B+ tree file of
+ *  the tests, and run each test in a transaction.
+ *
+ * Returns:
+ *  # of failed tests
+ */
+Four main(Four argc, char *argv[])
+{
+    Four		e;			/* for errors */
+    Four		handle;			/* system handle */
+    char		*devNames[1];		/* device name */
+    Four		volId;			/* volume identifier */
+    Four		numPages[1];		/* # of pages in the device */
+    FileID		fid;			/* B+ tree file of the tests */
+    XactID		xactId;			/* transaction identifier */
+    Four		nFailed = 0;		/* # of failed tests */
+
+
+    devNames[0] = "unittest.vol";
+    volId = UT_VOLNO;
+    numPages[0] = 4000;
+
+    e = LRDS_Init();
+    if (e < eNOERROR)
+    {
+        printf("LRDS_Init failed!!!\n");
+        exit(1);
+    }
+
+    e = LRDS_AllocHandle(&handle);
+    if (e >= eNOERROR) e = LRDS_FormatDataVolume(1, devNames, "unittest", volId, 16, numPages, 16);
+    if (e >= eNOERROR) e = LRDS_Mount(1, devNames, &volId);
+    if (e >= eNOERROR) e = LRDS_BeginTransaction(&xactId, X_RR_RR);
+    if (e >= eNOERROR) e = SM_CreateFile(volId, &fid, FALSE, NULL);
+    if (e >= eNOERROR) e = sm_GetCatalogEntryFromDataFileId(ARRAYINDEX, &fid, &edubtm_ut_catObj);
+    if (e < eNOERROR)
+    {
+        printf("Cannot set up the volume of the tests!!!\n");
+        LRDS_Final();
+        exit(1);
+    }
+
+    edubtm_ut_kdesc.nparts = 1;
+    edubtm_ut_kdesc.kpart[0].type = SM_INT;
+    edubtm_ut_kdesc.kpart[0].offset = 0;
+    edubtm_ut_kdesc.kpart[0].length = sizeof(Four);
+
+    nFailed += edubtm_ut_bulkLoad();
+    nFailed += edubtm_ut_bulkLoadRejected();
+    nFailed += edubtm_ut_insertBatch();
+
+    e = LRDS_CommitTransaction(&xactId);
+    if (e >= eNOERROR) e = LRDS_Dismount(volId);
+    if (e >= eNOERROR) e = LRDS_FreeHandle(handle);
+    if (e >= eNOERROR) e = LRDS_Final();
+    if (e < eNOERROR) printf("Cannot shut down the storage system!!!\n");
+
+    printf("%ld test(s) failed\n", (long)nFailed);
+
+    return(nFailed);
+
+} /* main() */
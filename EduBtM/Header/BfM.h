@@ -33,6 +33,33 @@
 #define PAGE_BUF    0
 #define LOT_LEAF_BUF 1
 
+/* Operations recorded in a buffer manager trace (as in EduBfM.h) */
+#define BFM_TRACE_GET		0	/* fix of a train read from the disk if not resident */
+#define BFM_TRACE_FREE		1	/* unfix */
+#define BFM_TRACE_SETDIRTY	2	/* modification of a fixed train */
+#define BFM_TRACE_NEW		3	/* fix of a new train, never read from the disk */
+
+#define BFM_TRACE_MAGIC		0x52546d42	/* "BmTR" */
+
+
+/*@
+ * Type Definitions
+ */
+/* header of a trace file, followed by the records */
+typedef struct {
+    UFour	magic;		/* BFM_TRACE_MAGIC */
+    UFour	recordSize;	/* sizeof(BfMTraceRecord) */
+} BfMTraceHeader;
+
+/* a record of a trace file */
+typedef struct {
+    UEight	time;		/* microseconds since the trace was started */
+    Four	pageNo;		/* the train (its first page) */
+    Two		volNo;
+    One		op;		/* BFM_TRACE_XXX */
+    One		type;		/* buffer type */
+} BfMTraceRecord;
+
 
 /*@
  * Function Prototypes
@@ -35,12 +35,14 @@
  * Function Prototypes
  */
 /* Interface Function Prototypes */
+Four EduBtM_BulkLoad(ObjectID*, PageID*, KeyDesc*, Two, BtM_BulkLoadNextFunc, void*, Pool*, DeallocListElem*);
 Four EduBtM_CreateIndex(ObjectID*, PageID*);
 Four EduBtM_DeleteObject(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Pool*, DeallocListElem*);
 Four EduBtM_DropIndex(PhysicalFileID*, PageID*, Pool*, DeallocListElem*);
 Four EduBtM_Fetch(PageID*, KeyDesc*, KeyValue*, Four, KeyValue*, Four, BtreeCursor*);
 Four EduBtM_FetchNext(PageID*, KeyDesc*, KeyValue*, Four, BtreeCursor*, BtreeCursor*);
 Four EduBtM_InsertObject(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Pool*, DeallocListElem*);
+Four EduBtM_InsertObjects(ObjectID*, PageID*, KeyDesc*, Four, KeyValue*, ObjectID*, Pool*, DeallocListElem*);
 
 
 #endif /* _EDUBTM_H_ */
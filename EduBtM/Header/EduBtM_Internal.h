@@ -39,6 +39,9 @@
 
 #define OBJECTID_SIZE   sizeof(ObjectID)
 
+/* maximum height of a B+ tree built by EduBtM_BulkLoad() */
+#define BTM_MAXTREEHEIGHT   16
+
 
 /*
  * Comparison result
@@ -116,6 +119,8 @@ typedef struct {   /* Internal (Nonleaf) Page */
  */
 #define BI_CFREE(p)   (PAGESIZE - BI_FIXED - (p)->hdr.free - ((p)->hdr.nSlots-1)*((CONSTANT_CASTING_TYPE)sizeof(Two)))
 #define BI_HALF       ((CONSTANT_CASTING_TYPE)((PAGESIZE-BI_FIXED)/2))
+/* a split point may be moved this many bytes from the half to get a shorter key */
+#define BI_SPLITINTERVAL ((CONSTANT_CASTING_TYPE)((PAGESIZE-BI_FIXED)/8))
 
 
 /*
@@ -158,6 +163,7 @@ typedef struct {   /* Leaf Page */
  */
 #define BL_CFREE(p)    (PAGESIZE - BL_FIXED - (p)->hdr.free - ((p)->hdr.nSlots-1)*((CONSTANT_CASTING_TYPE)sizeof(Two)))
 #define BL_HALF        ((CONSTANT_CASTING_TYPE)((PAGESIZE-BL_FIXED)/2))
+#define BL_SPLITINTERVAL ((CONSTANT_CASTING_TYPE)((PAGESIZE-BL_FIXED)/8))
 #define OVERFLOW_SPLIT ((CONSTANT_CASTING_TYPE)(PAGESIZE-BL_FIXED)/3)
 
 
@@ -264,11 +270,58 @@ typedef struct {
 	char kval[MAXKEYLEN];   /* key value */
 } LeafItem;
 
+/* Data type for a batch of keys and ObjectIDs being inserted */
+typedef struct {
+	KeyDesc  *kdesc;                /* Btree key descriptor */
+	KeyValue *kval;                 /* key values of the batch */
+	ObjectID *oid;                  /* ObjectIDs of the batch */
+	Four     *order;                /* indexes of the batch in key order */
+	Four     next;                  /* position in 'order' of the next key to be inserted */
+} btm_InsertBatch;
+
+/*
+ * Function which hands out the next key and ObjectID of a sorted stream to
+ * EduBtM_BulkLoad(); it returns TRUE if 'kval' and 'oid' are filled, FALSE
+ * at the end of the stream, or an error code.
+ */
+typedef Four (*BtM_BulkLoadNextFunc)(void*, KeyValue*, ObjectID*);
+
+/* Data type for the state of a bulk load; level 0 is the leaf level */
+typedef struct {
+	ObjectID *catObjForFile;        /* catalog object of B+ tree file */
+	KeyDesc  *kdesc;                /* key descriptor of the B+ tree */
+	PageID   root;                  /* root of the B+ tree */
+	PageID   lastPid;               /* the page allocated last */
+	Two      leafSlack;             /* # of bytes to be left free in a leaf page */
+	Two      internalSlack;         /* # of bytes to be left free in an internal page */
+	Four     height;                /* # of levels built so far */
+	PageID   pid[BTM_MAXTREEHEIGHT];        /* the rightmost page of each level; pageNo is NIL until allocated */
+	BtreePage page[BTM_MAXTREEHEIGHT];      /* contents of the rightmost page of each level, not yet written */
+	Boolean  hasPending[BTM_MAXTREEHEIGHT]; /* is an internal item held back at the level? */
+	InternalItem pending[BTM_MAXTREEHEIGHT]; /* the internal item held back at each level */
+	Four     nAllocated;            /* # of pages allocated so far */
+	Four     maxAllocated;          /* # of entries of 'allocated' */
+	PageID   *allocated;            /* the pages allocated so far; freed if the load fails */
+} btm_BulkLoadState;
+
+/* Data type for a cached catalog entry of a B+ tree file */
+typedef struct {
+	Boolean  used;                  /* does the entry hold a catalog object? */
+	ObjectID catObj;                /* catalog object */
+	sm_CatOverlayForBtree btree;    /* copy of the B+ tree file information in the catalog object */
+} btm_CatalogCacheEntry;
+
 
 /*@
 ** Macro Definitions
 */
 
+/* # of entries of the catalog cache; must be a power of 2 */
+#define BTM_CATALOGCACHESIZE 16
+
+/* maximum # of volumes mounted at a time, i.e. # of entries of the volume table of RDsM */
+#define BTM_MAXMOUNTEDVOLS 20
+
 /* Macro: GET_PTR_TO_CATENTRY_FOR_BTREE(catObjForFile, catPage, catEntry)
  * Description: get the information about the index file(sm_CatOverlayForBtree) residing in the catalog object for index file
  * Parameters:
@@ -295,17 +348,29 @@ Boolean edubtm_BinarySearchLeaf(BtreeLeaf*, KeyDesc*, KeyValue*, Two*);
 void edubtm_CompactInternalPage(BtreeInternal*, Two);
 void edubtm_CompactLeafPage(BtreeLeaf*, Two);
 Four edubtm_KeyCompare(KeyDesc*, KeyValue*, KeyValue*);
+void edubtm_SeparatorKey(KeyDesc*, KeyValue*, KeyValue*, KeyValue*);
 Four edubtm_Delete(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Boolean*, Boolean*, InternalItem*, Pool*, DeallocListElem*);
 Four edubtm_Insert(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Boolean*, Boolean*, InternalItem*, Pool*, DeallocListElem*);
 Four edubtm_InsertLeaf(ObjectID*, PageID*, BtreeLeaf*, KeyDesc*, KeyValue*, ObjectID*, Boolean*, Boolean*, InternalItem*);
 Four edubtm_InsertInternal(ObjectID*, BtreeInternal*, InternalItem*, Two, Boolean*, InternalItem*);
+Four edubtm_InsertBatch(ObjectID*, PageID*, btm_InsertBatch*, Four, Boolean*, Boolean*, InternalItem*, Pool*, DeallocListElem*);
+void edubtm_SortBatch(btm_InsertBatch*, Four, Four*);
 Four edubtm_FirstObject(PageID*, KeyDesc*, KeyValue*, Four, BtreeCursor*);
 Four edubtm_FreePages(PhysicalFileID*, PageID*, Pool*, DeallocListElem*);
+void edubtm_BulkLoadInit(btm_BulkLoadState*, ObjectID*, PageID*, KeyDesc*, Two);
+Four edubtm_BulkLoadLeafEntry(btm_BulkLoadState*, btm_LeafEntry*, Two);
+Four edubtm_BulkLoadInternalItem(btm_BulkLoadState*, Four, InternalItem*);
+Four edubtm_BulkLoadFinish(btm_BulkLoadState*);
+Four edubtm_BulkLoadStream(btm_BulkLoadState*, BtM_BulkLoadNextFunc, void*);
+Four edubtm_BulkLoadAbort(btm_BulkLoadState*, Pool*, DeallocListElem*);
+void edubtm_BulkLoadFinal(btm_BulkLoadState*);
+Four edubtm_GetCatalogEntry(ObjectID*, sm_CatOverlayForBtree*);
+void edubtm_InvalidateCatalogEntry(PhysicalFileID*);
 Four edubtm_InitInternal(PageID*, Boolean, Boolean);
 Four edubtm_InitLeaf(PageID*, Boolean, Boolean);
 Four edubtm_LastObject(PageID*, KeyDesc*, KeyValue*, Four, BtreeCursor*);
 Four edubtm_SplitInternal(ObjectID*, BtreeInternal*, Two, InternalItem*, InternalItem*);
-Four edubtm_SplitLeaf(ObjectID*, PageID*, BtreeLeaf*, Two, LeafItem*, InternalItem*);
+Four edubtm_SplitLeaf(ObjectID*, PageID*, BtreeLeaf*, KeyDesc*, Two, LeafItem*, InternalItem*);
 Four edubtm_get_objectid_from_leaf(BtreeCursor*);
 Four edubtm_root_insert(ObjectID*, PageID*, InternalItem*);
 
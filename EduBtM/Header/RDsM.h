@@ -28,6 +28,7 @@
 
 Four    RDsM_AllocTrains(Four, Four, PageID *, Two, Four, Two, PageID *);
 Four	RDsM_PageIdToExtNo(PageID *, Four *);
+Four	RDsM_GetAllMountedVolNos(Four *);
 
 
 #endif /* _RDsM_H_ */
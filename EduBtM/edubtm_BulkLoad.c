@@ -0,0 +1,736 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubtm_BulkLoad.c
+ *
+ * Description :
+ *  This file builds a B+ tree bottom-up from leaf entries given in key
+ *  order. Only the rightmost page of each level is kept in memory; it is
+ *  filled up to the page fill factor and then written, and a new page is
+ *  allocated next to the page allocated last, so that the pages of the
+ *  tree are written in key order. When a page of a level is written the
+ *  first key of the page following it is handed to the level above, and a
+ *  new level is started when the topmost page is written. The topmost page
+ *  is written into the root page at the end, so the root keeps its PageID.
+ *
+ *  Each internal level holds the last item given to it back until the
+ *  next one arrives, so that every page which is started gets at least
+ *  one entry besides 'p0'.
+ *
+ * Exports:
+ *  void edubtm_BulkLoadInit(btm_BulkLoadState*, ObjectID*, PageID*, KeyDesc*, Two)
+ *  Four edubtm_BulkLoadLeafEntry(btm_BulkLoadState*, btm_LeafEntry*, Two)
+ *  Four edubtm_BulkLoadInternalItem(btm_BulkLoadState*, Four, InternalItem*)
+ *  Four edubtm_BulkLoadFinish(btm_BulkLoadState*)
+ *  Four edubtm_BulkLoadStream(btm_BulkLoadState*, BtM_BulkLoadNextFunc, void*)
+ *  Four edubtm_BulkLoadAbort(btm_BulkLoadState*, Pool*, DeallocListElem*)
+ *  void edubtm_BulkLoadFinal(btm_BulkLoadState*)
+ */
+
+
+#include <stdlib.h> /* for realloc & free */
+#include <string.h>
+#include "EduBtM_common.h"
+#include "Util.h"
+#include "BfM.h"
+#include "EduBtM_Internal.h"
+
+
+/* internal function prototypes */
+static void edubtm_BulkLoadNewLeaf(BtreeLeaf*, ShortPageID);
+static void edubtm_BulkLoadNewInternal(BtreeInternal*, ShortPageID);
+static Four edubtm_BulkLoadAllocPage(btm_BulkLoadState*, PageID*);
+static Four edubtm_BulkLoadWritePage(PageID*, BtreePage*);
+static Four edubtm_BulkLoadSwitchPage(btm_BulkLoadState*, Four, PageID*);
+static Four edubtm_BulkLoadPlaceItem(btm_BulkLoadState*, Four, InternalItem*, Boolean);
+
+
+
+/*@================================
+ * edubtm_BulkLoadInit()
+ *================================*/
+/*
+ * Function: void edubtm_BulkLoadInit(btm_BulkLoadState*, ObjectID*, PageID*, KeyDesc*, Two)
+ *
+ * Description:
+ *  Initialize the state of a bulk load into the B+ tree 'root'. The tree
+ *  starts with an empty leaf; 'pff' percent of each page is to be filled.
+ *
+ * Returns:
+ *  None
+ */
+void edubtm_BulkLoadInit(
+    btm_BulkLoadState           *state,         /* OUT state of the bulk load */
+    ObjectID                    *catObjForFile, /* IN catalog object of B+ tree file */
+    PageID                      *root,          /* IN root of the B+ tree */
+    KeyDesc                     *kdesc,         /* IN Btree key descriptor */
+    Two                         pff)            /* IN page fill factor in percent */
+{
+    state->catObjForFile = catObjForFile;
+    state->kdesc = kdesc;
+    state->root = *root;
+    state->lastPid = *root;
+    state->leafSlack = (PAGESIZE - BL_FIXED) * (100 - pff) / 100;
+    state->internalSlack = (PAGESIZE - BI_FIXED) * (100 - pff) / 100;
+
+    state->height = 1;
+    state->pid[0].pageNo = NIL;
+    state->hasPending[0] = FALSE;
+    edubtm_BulkLoadNewLeaf(&(state->page[0].bl), NIL);
+
+    state->nAllocated = 0;
+    state->maxAllocated = 0;
+    state->allocated = NULL;
+
+} /* edubtm_BulkLoadInit() */
+
+
+
+/*@================================
+ * edubtm_BulkLoadLeafEntry()
+ *================================*/
+/*
+ * Function: Four edubtm_BulkLoadLeafEntry(btm_BulkLoadState*, btm_LeafEntry*, Two)
+ *
+ * Description:
+ *  Append the leaf entry 'entry' of 'entryLen' bytes to the rightmost leaf.
+ *  If the leaf would be filled over the fill factor, the leaf is written
+ *  and the entry becomes the first one of a new leaf; a key separating the
+ *  two leaves, made by edubtm_SeparatorKey(), is given to the level above.
+ *
+ * Returns:
+ *  Error code
+ *    eNOTSUPPORTED_EDUBTM
+ *    some errors caused by function calls
+ */
+Four edubtm_BulkLoadLeafEntry(
+    btm_BulkLoadState           *state,         /* INOUT state of the bulk load */
+    btm_LeafEntry               *entry,         /* IN the leaf entry */
+    Two                         entryLen)       /* IN length of the entry */
+{
+    Four                        e;              /* error number */
+    BtreeLeaf                   *page = &(state->page[0].bl); /* the rightmost leaf */
+    Two                         slack;          /* # of bytes to be left free */
+    Two                         entryOffset;    /* starting offset of the entry */
+    PageID                      newPid;         /* the new leaf */
+    InternalItem                item;           /* item for the new leaf */
+    btm_LeafEntry               *lastEntry;     /* the last entry of the full leaf */
+
+
+    /* EduBtM keeps no overflow pages; an entry should fit in a leaf */
+    if (entryLen > PAGESIZE - BL_FIXED) ERR(eNOTSUPPORTED_EDUBTM);
+
+    slack = (page->hdr.nSlots > 0) ? state->leafSlack : 0;
+
+    if (entryLen + sizeof(Two) + slack > BL_CFREE(page)) {
+
+        e = edubtm_BulkLoadSwitchPage(state, 0, &newPid);
+        if (e < 0) ERR(e);
+
+        /* the key of the item separates the last key of the full leaf from the entry */
+        lastEntry = (btm_LeafEntry*)&(page->data[page->slot[-(page->hdr.nSlots - 1)]]);
+        item.spid = newPid.pageNo;
+        edubtm_SeparatorKey(state->kdesc, (KeyValue*)&(lastEntry->klen), (KeyValue*)&(entry->klen), (KeyValue*)&(item.klen));
+
+        edubtm_BulkLoadNewLeaf(page, state->pid[0].pageNo);
+        state->pid[0] = newPid;
+
+        e = edubtm_BulkLoadInternalItem(state, 1, &item);
+        if (e < 0) ERR(e);
+    }
+
+    entryOffset = page->slot[-(page->hdr.nSlots)] = page->hdr.free;
+    memcpy(&(page->data[entryOffset]), (char*)entry, entryLen);
+
+    page->hdr.free += entryLen;
+    page->hdr.nSlots++;
+
+    return(eNOERROR);
+
+} /* edubtm_BulkLoadLeafEntry() */
+
+
+
+/*@================================
+ * edubtm_BulkLoadInternalItem()
+ *================================*/
+/*
+ * Function: Four edubtm_BulkLoadInternalItem(btm_BulkLoadState*, Four, InternalItem*)
+ *
+ * Description:
+ *  Give the internal item 'item' to the internal level 'level'. The item
+ *  is held back, and the item held back before is stored instead.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+Four edubtm_BulkLoadInternalItem(
+    btm_BulkLoadState           *state,         /* INOUT state of the bulk load */
+    Four                        level,          /* IN level of the item */
+    InternalItem                *item)          /* IN the internal item */
+{
+    Four                        e;              /* error number */
+
+
+    if (state->hasPending[level]) {
+        e = edubtm_BulkLoadPlaceItem(state, level, &(state->pending[level]), FALSE);
+        if (e < 0) ERR(e);
+    }
+
+    state->pending[level] = *item;
+    state->hasPending[level] = TRUE;
+
+    return(eNOERROR);
+
+} /* edubtm_BulkLoadInternalItem() */
+
+
+
+/*@================================
+ * edubtm_BulkLoadFinish()
+ *================================*/
+/*
+ * Function: Four edubtm_BulkLoadFinish(btm_BulkLoadState*)
+ *
+ * Description:
+ *  Store the items held back, from the lowest internal level up, and
+ *  write the rightmost pages of all the levels. The topmost page is
+ *  written into the root page.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+Four edubtm_BulkLoadFinish(
+    btm_BulkLoadState           *state)         /* INOUT state of the bulk load */
+{
+    Four                        e;              /* error number */
+    Four                        level;          /* a level of the B+ tree */
+    BtreePage                   *top;           /* the topmost page */
+
+
+    /* storing an item may start a new level; the height is read each time */
+    for (level = 1; level < state->height; level++) {
+        if (state->hasPending[level]) {
+            e = edubtm_BulkLoadPlaceItem(state, level, &(state->pending[level]), TRUE);
+            if (e < 0) ERR(e);
+
+            state->hasPending[level] = FALSE;
+        }
+    }
+
+    for (level = 0; level < state->height-1; level++) {
+        e = edubtm_BulkLoadWritePage(&(state->pid[level]), &(state->page[level]));
+        if (e < 0) ERR(e);
+    }
+
+    top = &(state->page[state->height-1]);
+    top->any.hdr.type |= ROOT;
+
+    e = edubtm_BulkLoadWritePage(&(state->root), top);
+    if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* edubtm_BulkLoadFinish() */
+
+
+
+/*@================================
+ * edubtm_BulkLoadStream()
+ *================================*/
+/*
+ * Function: Four edubtm_BulkLoadStream(btm_BulkLoadState*, BtM_BulkLoadNextFunc, void*)
+ *
+ * Description:
+ *  Load the keys and ObjectIDs handed out by 'next' and finish the B+ tree.
+ *  The ObjectIDs of a key are gathered into one leaf entry, which is given
+ *  to the leaf level when a greater key arrives. An empty stream leaves the
+ *  B+ tree empty.
+ *
+ * Returns:
+ *  Error code
+ *    eBADPARAMETER_BTM
+ *    eNOTSORTED_EDUBTM
+ *    eDUPLICATEDKEY_BTM
+ *    eDUPLICATEDOBJECTID_BTM
+ *    eNOTSUPPORTED_EDUBTM
+ *    some errors caused by function calls
+ */
+Four edubtm_BulkLoadStream(
+    btm_BulkLoadState           *state,         /* INOUT state of the bulk load */
+    BtM_BulkLoadNextFunc        next,           /* IN function handing out the sorted keys and ObjectIDs */
+    void                        *arg)           /* IN argument passed to 'next' */
+{
+    Four                        e;              /* error number */
+    Four                        more;           /* result of 'next' */
+    Four                        cmp;            /* result of comparison */
+    KeyDesc                     *kdesc = state->kdesc; /* key descriptor of the B+ tree */
+    KeyValue                    kval;           /* key value from the stream */
+    KeyValue                    prevKey;        /* key value of the entry being built */
+    ObjectID                    oid;            /* ObjectID from the stream */
+    BtreeLeaf                   tpage;          /* a temporary page holding the entry being built */
+    btm_LeafEntry               *entry;         /* the leaf entry being built */
+    ObjectID                    *oidArray;      /* ObjectID array of 'entry' */
+    Two                         alignedKlen;    /* aligned length of the key length */
+    Two                         entryLen;       /* length of 'entry'; 0 if no entry is being built */
+
+
+    entry = (btm_LeafEntry*)&(tpage.data[0]);
+    entryLen = 0;
+
+    for (;;) {
+        more = (*next)(arg, &kval, &oid);
+        if (more < 0) ERR(more);
+        if (!more) break;
+
+        if (kval.len < 0 || kval.len > MAXKEYLEN) ERR(eBADPARAMETER_BTM);
+
+        if (entryLen > 0) {
+            cmp = edubtm_KeyCompare(kdesc, &prevKey, &kval);
+            if (cmp == GREAT) ERR(eNOTSORTED_EDUBTM);
+
+            if (cmp == EQUAL) {
+                /* one more ObjectID of the key */
+                if (kdesc->flag & KEYFLAG_UNIQUE) ERR(eDUPLICATEDKEY_BTM);
+
+                cmp = btm_ObjectIdComp(&oidArray[entry->nObjects-1], &oid);
+                if (cmp == EQUAL) ERR(eDUPLICATEDOBJECTID_BTM);
+                if (cmp == GREAT) ERR(eNOTSORTED_EDUBTM);
+
+                /* EduBtM keeps no overflow pages; the entry should fit in a leaf */
+                if (entryLen + OBJECTID_SIZE > PAGESIZE - BL_FIXED) ERR(eNOTSUPPORTED_EDUBTM);
+
+                oidArray[entry->nObjects++] = oid;
+                entryLen += OBJECTID_SIZE;
+                continue;
+            }
+
+            /*@ the entry of the previous key is complete */
+            e = edubtm_BulkLoadLeafEntry(state, entry, entryLen);
+            if (e < 0) ERR(e);
+        }
+
+        /*@ start the entry of a new key */
+        alignedKlen = ALIGNED_LENGTH(kval.len);
+        entry->nObjects = 1;
+        entry->klen = kval.len;
+        memcpy(&(entry->kval[0]), &(kval.val[0]), entry->klen);
+        oidArray = (ObjectID*)&(entry->kval[alignedKlen]);
+        oidArray[0] = oid;
+        entryLen = BTM_LEAFENTRY_FIXED + alignedKlen + OBJECTID_SIZE;
+
+        prevKey = kval;
+    }
+
+    /* an empty stream leaves the Btree empty */
+    if (entryLen == 0) return(eNOERROR);
+
+    e = edubtm_BulkLoadLeafEntry(state, entry, entryLen);
+    if (e < 0) ERR(e);
+
+    e = edubtm_BulkLoadFinish(state);
+    if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* edubtm_BulkLoadStream() */
+
+
+
+/*@================================
+ * edubtm_BulkLoadAbort()
+ *================================*/
+/*
+ * Function: Four edubtm_BulkLoadAbort(btm_BulkLoadState*, Pool*, DeallocListElem*)
+ *
+ * Description:
+ *  Free the pages allocated by a bulk load which failed. Each page is
+ *  marked as a free page and put into the dealloc list, as in
+ *  edubtm_FreePages(). The root is not among them; it has not been
+ *  written and is still empty.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+Four edubtm_BulkLoadAbort(
+    btm_BulkLoadState           *state,         /* INOUT state of the bulk load */
+    Pool                        *dlPool,        /* INOUT pool of dealloc list elements */
+    DeallocListElem             *dlHead)        /* INOUT head of the dealloc list */
+{
+    Four                        e;              /* error number */
+    Four                        i;              /* index */
+    PageID                      *pid;           /* a page allocated by the bulk load */
+    BtreePage                   *apage;         /* pointer to the buffer of the page */
+    DeallocListElem             *dlElem;        /* an element of dealloc list */
+
+
+    for (i = 0; i < state->nAllocated; i++) {
+        pid = &(state->allocated[i]);
+
+        /* the page may not have been written yet; its old contents are of no use */
+        e = BfM_GetNewTrain(pid, (char **)&apage, PAGE_BUF);
+        if (e < 0) ERR(e);
+
+        apage->any.hdr.type = FREEPAGE;
+
+        e = BfM_SetDirty(pid, PAGE_BUF);
+        if (e < 0) ERRB1(e, pid, PAGE_BUF);
+
+        e = BfM_FreeTrain(pid, PAGE_BUF);
+        if (e < 0) ERR(e);
+
+        e = Util_getElementFromPool(dlPool, &dlElem);
+        if (e < 0) ERR(e);
+
+        dlElem->type = DL_PAGE;
+        dlElem->elem.pid = *pid;
+        dlElem->next = dlHead->next;
+        dlHead->next = dlElem;
+    }
+
+    state->nAllocated = 0;
+
+    return(eNOERROR);
+
+} /* edubtm_BulkLoadAbort() */
+
+
+
+/*@================================
+ * edubtm_BulkLoadFinal()
+ *================================*/
+/*
+ * Function: void edubtm_BulkLoadFinal(btm_BulkLoadState*)
+ *
+ * Description:
+ *  Release the memory held by the state of a bulk load.
+ *
+ * Returns:
+ *  None
+ */
+void edubtm_BulkLoadFinal(
+    btm_BulkLoadState           *state)         /* INOUT state of the bulk load */
+{
+    free(state->allocated);
+
+    state->allocated = NULL;
+    state->nAllocated = 0;
+    state->maxAllocated = 0;
+
+} /* edubtm_BulkLoadFinal() */
+
+
+
+/*@================================
+ * edubtm_BulkLoadPlaceItem()
+ *================================*/
+/*
+ * Function: static Four edubtm_BulkLoadPlaceItem(btm_BulkLoadState*, Four, InternalItem*, Boolean)
+ *
+ * Description:
+ *  Append the internal item 'item' to the rightmost page of 'level'. If the
+ *  page would be filled over the fill factor, the page is written and a new
+ *  page is started whose 'p0' is the child of the item; the key of the item
+ *  is given to the level above. The last item of a level ('last') is
+ *  appended regardless of the fill factor; if it does not fit at all, the
+ *  last entry of the page is moved into the new page together with it.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+static Four edubtm_BulkLoadPlaceItem(
+    btm_BulkLoadState           *state,         /* INOUT state of the bulk load */
+    Four                        level,          /* IN level of the item */
+    InternalItem                *item,          /* IN the internal item */
+    Boolean                     last)           /* IN is it the last item of the level? */
+{
+    Four                        e;              /* error number */
+    BtreeInternal               *page = &(state->page[level].bi); /* the rightmost page */
+    Two                         slack;          /* # of bytes to be left free */
+    Two                         entryLen;       /* length of the entry */
+    Two                         entryOffset;    /* starting offset of an entry */
+    btm_InternalEntry           *entry;         /* an internal entry */
+    PageID                      newPid;         /* the new page */
+    InternalItem                movedItem;      /* the entry moved into the new page */
+    InternalItem                upItem;         /* item given to the level above */
+
+
+    entryLen = sizeof(ShortPageID) + ALIGNED_LENGTH(sizeof(Two)+item->klen);
+    slack = (page->hdr.nSlots > 0 && !last) ? state->internalSlack : 0;
+
+    if (entryLen + sizeof(Two) + slack > BI_CFREE(page)) {
+
+        if (last) {
+            /* take the last entry out of the page; it is at the end of the data area */
+            entryOffset = page->slot[-(page->hdr.nSlots-1)];
+            entry = (btm_InternalEntry*)&(page->data[entryOffset]);
+            movedItem.spid = entry->spid;
+            movedItem.klen = entry->klen;
+            memcpy(&(movedItem.kval[0]), &(entry->kval[0]), movedItem.klen);
+
+            page->hdr.nSlots--;
+            page->hdr.free = entryOffset;
+        }
+
+        e = edubtm_BulkLoadSwitchPage(state, level, &newPid);
+        if (e < 0) ERR(e);
+
+        if (last) {
+            edubtm_BulkLoadNewInternal(page, movedItem.spid);
+            upItem = movedItem;
+        } else {
+            edubtm_BulkLoadNewInternal(page, item->spid);
+            upItem = *item;
+        }
+        state->pid[level] = newPid;
+
+        upItem.spid = newPid.pageNo;
+        e = edubtm_BulkLoadInternalItem(state, level+1, &upItem);
+        if (e < 0) ERR(e);
+
+        if (!last) return(eNOERROR);
+    }
+
+    entryOffset = page->slot[-(page->hdr.nSlots)] = page->hdr.free;
+    entry = (btm_InternalEntry*)&(page->data[entryOffset]);
+    entry->spid = item->spid;
+    entry->klen = item->klen;
+    memcpy(&(entry->kval[0]), &(item->kval[0]), entry->klen);
+
+    page->hdr.free += entryLen;
+    page->hdr.nSlots++;
+
+    return(eNOERROR);
+
+} /* edubtm_BulkLoadPlaceItem() */
+
+
+
+/*@================================
+ * edubtm_BulkLoadSwitchPage()
+ *================================*/
+/*
+ * Function: static Four edubtm_BulkLoadSwitchPage(btm_BulkLoadState*, Four, PageID*)
+ *
+ * Description:
+ *  Write the rightmost page of 'level' and allocate the page to follow it.
+ *  Leaves are linked to the new page. If the page was the topmost one, a
+ *  new level is started whose 'p0' points to it.
+ *
+ * Returns:
+ *  Error code
+ *    eEXCEEDMAXDEPTHOFBTREE_BTM
+ *    some errors caused by function calls
+ */
+static Four edubtm_BulkLoadSwitchPage(
+    btm_BulkLoadState           *state,         /* INOUT state of the bulk load */
+    Four                        level,          /* IN level of the page */
+    PageID                      *newPid)        /* OUT the page to follow */
+{
+    Four                        e;              /* error number */
+    Four                        top;            /* the new level */
+
+
+    if (state->pid[level].pageNo == NIL) {
+        e = edubtm_BulkLoadAllocPage(state, &(state->pid[level]));
+        if (e < 0) ERR(e);
+    }
+
+    e = edubtm_BulkLoadAllocPage(state, newPid);
+    if (e < 0) ERR(e);
+
+    if (level == 0)
+        state->page[0].bl.hdr.nextPage = newPid->pageNo;
+
+    if (level == state->height-1) {
+        if (state->height == BTM_MAXTREEHEIGHT) ERR(eEXCEEDMAXDEPTHOFBTREE_BTM);
+
+        top = state->height++;
+        state->pid[top].pageNo = NIL;
+        state->hasPending[top] = FALSE;
+        edubtm_BulkLoadNewInternal(&(state->page[top].bi), state->pid[level].pageNo);
+    }
+
+    e = edubtm_BulkLoadWritePage(&(state->pid[level]), &(state->page[level]));
+    if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* edubtm_BulkLoadSwitchPage() */
+
+
+
+/*@================================
+ * edubtm_BulkLoadAllocPage()
+ *================================*/
+/*
+ * Function: static Four edubtm_BulkLoadAllocPage(btm_BulkLoadState*, PageID*)
+ *
+ * Description:
+ *  Allocate a page of the B+ tree file next to the page allocated last.
+ *  The page is remembered, so that it can be freed if the load fails.
+ *
+ * Returns:
+ *  Error code
+ *    eMEMORYALLOCERR_EDUBTM
+ *    some errors caused by function calls
+ */
+static Four edubtm_BulkLoadAllocPage(
+    btm_BulkLoadState           *state,         /* INOUT state of the bulk load */
+    PageID                      *pid)           /* OUT the allocated page */
+{
+    Four                        e;              /* error number */
+    Four                        newMax;         /* new # of entries of 'allocated' */
+    PageID                      *newAllocated;  /* 'allocated' enlarged */
+
+
+    /* make room first, so that no allocated page goes unrecorded */
+    if (state->nAllocated == state->maxAllocated) {
+        newMax = (state->maxAllocated == 0) ? 64 : state->maxAllocated * 2;
+
+        newAllocated = (PageID *)realloc(state->allocated, sizeof(PageID) * newMax);
+        if (newAllocated == NULL) ERR(eMEMORYALLOCERR_EDUBTM);
+
+        state->allocated = newAllocated;
+        state->maxAllocated = newMax;
+    }
+
+    e = btm_AllocPage(state->catObjForFile, &(state->lastPid), pid);
+    if (e < 0) ERR(e);
+
+    state->allocated[state->nAllocated++] = *pid;
+    state->lastPid = *pid;
+
+    return(eNOERROR);
+
+} /* edubtm_BulkLoadAllocPage() */
+
+
+
+/*@================================
+ * edubtm_BulkLoadWritePage()
+ *================================*/
+/*
+ * Function: static Four edubtm_BulkLoadWritePage(PageID*, BtreePage*)
+ *
+ * Description:
+ *  Copy the page built in memory into the buffer of the page 'pid'.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+static Four edubtm_BulkLoadWritePage(
+    PageID                      *pid,           /* IN the page to be written */
+    BtreePage                   *page)          /* IN contents of the page */
+{
+    Four                        e;              /* error number */
+    BtreePage                   *apage;         /* pointer to the buffer of the page */
+
+
+    page->any.hdr.pid = *pid;
+
+    e = BfM_GetNewTrain(pid, (char **)&apage, PAGE_BUF);
+    if (e < 0) ERR(e);
+
+    memcpy((char*)apage, (char*)page, sizeof(BtreePage));
+
+    e = BfM_SetDirty(pid, PAGE_BUF);
+    if (e < 0) ERRB1(e, pid, PAGE_BUF);
+
+    e = BfM_FreeTrain(pid, PAGE_BUF);
+    if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* edubtm_BulkLoadWritePage() */
+
+
+
+/*@================================
+ * edubtm_BulkLoadNewLeaf()
+ *================================*/
+/*
+ * Function: static void edubtm_BulkLoadNewLeaf(BtreeLeaf*, ShortPageID)
+ *
+ * Description:
+ *  Initialize an empty leaf in memory which follows the leaf 'prevPage'.
+ *  The whole page is cleared first, since it is copied over the buffer
+ *  page as it is, including the flags and the reserved space.
+ *
+ * Returns:
+ *  None
+ */
+static void edubtm_BulkLoadNewLeaf(
+    BtreeLeaf                   *page,          /* OUT the leaf */
+    ShortPageID                 prevPage)       /* IN the previous leaf */
+{
+    memset((char*)page, 0, sizeof(BtreeLeaf));
+
+    SET_PAGE_TYPE(page, BTREE_PAGE_TYPE);
+
+    page->hdr.type = LEAF;
+    page->hdr.nextPage = NIL;
+    page->hdr.prevPage = prevPage;
+    page->hdr.nSlots = 0;
+    page->hdr.free = 0;
+    page->hdr.unused = 0;
+
+} /* edubtm_BulkLoadNewLeaf() */
+
+
+
+/*@================================
+ * edubtm_BulkLoadNewInternal()
+ *================================*/
+/*
+ * Function: static void edubtm_BulkLoadNewInternal(BtreeInternal*, ShortPageID)
+ *
+ * Description:
+ *  Initialize an internal page in memory whose first pointer is 'p0'.
+ *  The whole page is cleared first as in edubtm_BulkLoadNewLeaf().
+ *
+ * Returns:
+ *  None
+ */
+static void edubtm_BulkLoadNewInternal(
+    BtreeInternal               *page,          /* OUT the internal page */
+    ShortPageID                 p0)             /* IN the first pointer */
+{
+    memset((char*)page, 0, sizeof(BtreeInternal));
+
+    SET_PAGE_TYPE(page, BTREE_PAGE_TYPE);
+
+    page->hdr.type = INTERNAL;
+    page->hdr.p0 = p0;
+    page->hdr.nSlots = 0;
+    page->hdr.free = 0;
+    page->hdr.unused = 0;
+
+} /* edubtm_BulkLoadNewInternal() */
@@ -0,0 +1,215 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubtm_CatalogCache.c
+ *
+ * Description :
+ *  Cache of the B+ tree file information (sm_CatOverlayForBtree) in the
+ *  catalog objects. Every insertion and deletion, at every level of the
+ *  recursion, needs the PhysicalFileID of the B+ tree file; it is read
+ *  from the catalog page once and then taken from the cache, so that the
+ *  catalog page is not fixed again on each call. The cache is keyed by
+ *  the whole ObjectID of the catalog object, including its unique number,
+ *  so an entry never answers for a catalog object created later in the
+ *  same slot. EduBtM never updates the B+ tree file information, hence
+ *  the cached copies need no write back.
+ *
+ *  An entry is removed when its B+ tree file is dropped. Since the volume
+ *  of a catalog object may be dismounted and another volume mounted under
+ *  the same volume number, the set of mounted volumes is compared on each
+ *  lookup with the set at the previous lookup, and the whole cache is
+ *  emptied when they differ.
+ *
+ *  The cache is not latched, as EduBtM is not latched anywhere; it must
+ *  be used by a single thread only.
+ *
+ * Exports:
+ *  Four edubtm_GetCatalogEntry(ObjectID*, sm_CatOverlayForBtree*)
+ *  void edubtm_InvalidateCatalogEntry(PhysicalFileID*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "EduBtM_Internal.h"
+#include "OM_Internal.h"
+#include "BfM.h"
+#include "RDsM.h"
+
+
+/*@
+ * macro definitions
+ */
+/* slot of the catalog cache for the catalog object 'oid' */
+#define CATALOGCACHE_SLOT(oid) \
+    ((Four)(((oid)->pageNo ^ ((oid)->volNo << 7) ^ ((oid)->slotNo << 3)) & (BTM_CATALOGCACHESIZE - 1)))
+
+/* is 'a' the catalog object 'b', not a later object in its slot? */
+#define EQUAL_CATOBJ(a, b) \
+    ((a).pageNo == (b).pageNo && (a).volNo == (b).volNo && \
+     (a).slotNo == (b).slotNo && (a).unique == (b).unique)
+
+
+/*@
+ * global variables
+ */
+/* cached catalog entries; every entry is unused at first */
+static btm_CatalogCacheEntry edubtm_catalogCache[BTM_CATALOGCACHESIZE];
+
+/* volumes which were mounted at the previous lookup */
+static Four edubtm_catalogCacheNVols = 0;
+static Four edubtm_catalogCacheVols[BTM_MAXMOUNTEDVOLS];
+
+
+/* internal function prototypes */
+static void edubtm_CheckMountedVolumes(void);
+
+
+
+/*@================================
+ * edubtm_GetCatalogEntry()
+ *================================*/
+/*
+ * Function: Four edubtm_GetCatalogEntry(ObjectID*, sm_CatOverlayForBtree*)
+ *
+ * Description :
+ *  Copy the B+ tree file information in the catalog object 'catObjForFile'
+ *  into 'catEntry'. The catalog page is fixed only if the catalog object
+ *  is not in the cache; the information read is then put in the cache,
+ *  replacing the entry which was in the same slot.
+ *
+ * Returns :
+ *  error code
+ *    some errors caused by function calls
+ */
+Four edubtm_GetCatalogEntry(
+    ObjectID			*catObjForFile,	/* IN catalog object of B+ tree file */
+    sm_CatOverlayForBtree	*catEntry)	/* OUT B+ tree file information */
+{
+    Four			e;		/* error number */
+    btm_CatalogCacheEntry	*entry;		/* slot of the catalog object in the cache */
+    SlottedPage			*catPage;	/* buffer page containing the catalog object */
+    sm_CatOverlayForBtree	*btree;		/* pointer to Btree file catalog information */
+
+
+    edubtm_CheckMountedVolumes();
+
+    entry = &edubtm_catalogCache[CATALOGCACHE_SLOT(catObjForFile)];
+
+    if (entry->used && EQUAL_CATOBJ(entry->catObj, *catObjForFile))
+    {
+        *catEntry = entry->btree;
+        return(eNOERROR);
+    }
+
+    e = BfM_GetTrain((TrainID*)catObjForFile, (char**)&catPage, PAGE_BUF);
+    if (e < 0) ERR(e);
+
+    GET_PTR_TO_CATENTRY_FOR_BTREE(catObjForFile, catPage, btree);
+
+    *catEntry = *btree;
+
+    e = BfM_FreeTrain((TrainID*)catObjForFile, PAGE_BUF);
+    if (e < 0) ERR(e);
+
+    entry->used = TRUE;
+    entry->catObj = *catObjForFile;
+    entry->btree = *catEntry;
+
+    return(eNOERROR);
+
+} /* edubtm_GetCatalogEntry() */
+
+
+
+/*@================================
+ * edubtm_InvalidateCatalogEntry()
+ *================================*/
+/*
+ * Function: void edubtm_InvalidateCatalogEntry(PhysicalFileID*)
+ *
+ * Description :
+ *  Remove from the cache the entries of the B+ tree file 'pFid', so that
+ *  its catalog object is read again when it is used next.
+ *
+ * Returns :
+ *  None
+ */
+void edubtm_InvalidateCatalogEntry(
+    PhysicalFileID		*pFid)		/* IN FileID of the Btree file */
+{
+    Four			i;
+
+
+    for (i = 0; i < BTM_CATALOGCACHESIZE; i++)
+    {
+        if (edubtm_catalogCache[i].used &&
+            edubtm_catalogCache[i].btree.fid.volNo == pFid->volNo &&
+            edubtm_catalogCache[i].btree.firstPage == pFid->pageNo)
+            edubtm_catalogCache[i].used = FALSE;
+    }
+
+} /* edubtm_InvalidateCatalogEntry() */
+
+
+
+/*@================================
+ * edubtm_CheckMountedVolumes()
+ *================================*/
+/*
+ * Function: static void edubtm_CheckMountedVolumes(void)
+ *
+ * Description :
+ *  Empty the cache if a volume has been mounted or dismounted since the
+ *  previous lookup; a catalog object read before then may belong to a
+ *  volume which is no longer there.
+ *
+ * Returns :
+ *  None
+ */
+static void edubtm_CheckMountedVolumes(void)
+{
+    Four			i;
+    Four			nVols;		/* # of volumes mounted now */
+    Four			vols[BTM_MAXMOUNTEDVOLS]; /* volumes mounted now, in ascending order */
+
+
+    nVols = RDsM_GetAllMountedVolNos(vols);
+
+    if (nVols == edubtm_catalogCacheNVols)
+    {
+        for (i = 0; i < nVols; i++)
+            if (vols[i] != edubtm_catalogCacheVols[i]) break;
+
+        if (i == nVols) return;
+    }
+
+    for (i = 0; i < BTM_CATALOGCACHESIZE; i++)
+        edubtm_catalogCache[i].used = FALSE;
+
+    for (i = 0; i < nVols; i++)
+        edubtm_catalogCacheVols[i] = vols[i];
+    edubtm_catalogCacheNVols = nVols;
+
+} /* edubtm_CheckMountedVolumes() */
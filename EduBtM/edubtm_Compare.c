@@ -32,6 +32,7 @@
  * Exports: 
  *  Four edubtm_KeyCompare(KeyDesc*, KeyValue*, KeyValue*)
  *  Four edubtm_ObjectIdComp(ObjectID*, ObjectID*)
+ *  void edubtm_SeparatorKey(KeyDesc*, KeyValue*, KeyValue*, KeyValue*)
  */
 
 
@@ -141,3 +142,61 @@ Four edubtm_KeyCompare(
     return(EQUAL);
     
 }   /* edubtm_KeyCompare() */
+
+
+
+/*@================================
+ * edubtm_SeparatorKey()
+ *================================*/
+/*
+ * Function: void edubtm_SeparatorKey(KeyDesc*, KeyValue*, KeyValue*, KeyValue*)
+ *
+ * Description:
+ *  Make the key 'sep' which separates two neighboring leaves in their
+ *  parent, where 'left' is the last key of the left leaf and 'right' the
+ *  first key of the right leaf. Any key with left < sep <= right leads the
+ *  searches to the right leaves, so for a key of a single variable length
+ *  string the shortest prefix of 'right' greater than 'left' is used; the
+ *  internal entries get shorter and the fanout of the internal pages goes
+ *  up. Only a key which has one part, of type SM_VARSTRING, is shortened;
+ *  a key of several parts is never truncated, even if its last part is a
+ *  variable length string, and for it and the other keys 'sep' is 'right'.
+ *
+ * Returns:
+ *  None
+ *
+ * Note:
+ *  'left' should be less than 'right'.
+ */
+void edubtm_SeparatorKey(
+    KeyDesc                     *kdesc,         /* IN key descriptor */
+    KeyValue                    *left,          /* IN the last key of the left leaf */
+    KeyValue                    *right,         /* IN the first key of the right leaf */
+    KeyValue                    *sep)           /* OUT the separator key */
+{
+    Two                         len1, len2;     /* string length */
+    Two                         n;              /* length of the separator string */
+
+
+    if (kdesc->nparts == 1 && kdesc->kpart[0].type == SM_VARSTRING) {
+        memcpy((char*)&len1, (char*)&(left->val[0]), sizeof(Two));
+        memcpy((char*)&len2, (char*)&(right->val[0]), sizeof(Two));
+
+        /* the separator is the common prefix and the first different byte */
+        for (n = 0; n < len1 && n < len2; n++)
+            if (left->val[sizeof(Two)+n] != right->val[sizeof(Two)+n]) break;
+        n++;
+
+        /* use only what is stored of 'right' */
+        if (n < len2 && sizeof(Two) + n <= right->len) {
+            sep->len = sizeof(Two) + n;
+            memcpy((char*)&(sep->val[0]), (char*)&n, sizeof(Two));
+            memcpy(&(sep->val[sizeof(Two)]), &(right->val[sizeof(Two)]), n);
+            return;
+        }
+    }
+
+    sep->len = right->len;
+    memcpy(&(sep->val[0]), &(right->val[0]), sep->len);
+
+}   /* edubtm_SeparatorKey() */
@@ -112,8 +112,7 @@ Four edubtm_Delete(
     BtreePage                   *rpage;         /* for a root page */
     InternalItem                litem;          /* local internal item */
     btm_InternalEntry           *iEntry;        /* an internal entry */
-    SlottedPage                 *catPage;       /* buffer page containing the catalog object */
-    sm_CatOverlayForBtree       *catEntry;      /* pointer to Btree file catalog information */
+    sm_CatOverlayForBtree       catEntry;       /* Btree file catalog information */
     PhysicalFileID              pFid;           /* B+-tree file's FileID */
   
 
@@ -129,15 +128,10 @@ Four edubtm_Delete(
     *h = *f = FALSE;
     
     /* Get the B+ tree file's FileID from the catalog object */
-    e = BfM_GetTrain((TrainID*)catObjForFile, (char**)&catPage, PAGE_BUF);
-    if (e < 0) ERR(e);
-    
-    GET_PTR_TO_CATENTRY_FOR_BTREE(catObjForFile, catPage, catEntry);
-    
-    MAKE_PHYSICALFILEID(pFid, catEntry->fid.volNo, catEntry->firstPage); 
-    
-    e = BfM_FreeTrain((TrainID*)catObjForFile, PAGE_BUF);
+    e = edubtm_GetCatalogEntry(catObjForFile, &catEntry);
     if (e < 0) ERR(e);
+
+    MAKE_PHYSICALFILEID(pFid, catEntry.fid.volNo, catEntry.firstPage);
     
     e = BfM_GetTrain(root, (char **)&rpage, PAGE_BUF);	/*@ Disk -> Buffer */
     if (e < 0) ERR(e);
@@ -104,8 +104,7 @@ Four edubtm_Insert(
     BtreePage                   *apage;                 /* a pointer to the root page */
     btm_InternalEntry           *iEntry;                /* an internal entry */
     Two                         iEntryOffset;           /* starting offset of an internal entry */
-    SlottedPage                 *catPage;               /* buffer page containing the catalog object */
-    sm_CatOverlayForBtree       *catEntry;              /* pointer to Btree file catalog information */
+    sm_CatOverlayForBtree       catEntry;               /* Btree file catalog information */
     PhysicalFileID              pFid;                   /* B+-tree file's FileID */
 
 
@@ -119,15 +118,10 @@ Four edubtm_Insert(
 
     
     /* Get the B+ tree file's FileID from the catalog object */
-    e = BfM_GetTrain((TrainID*)catObjForFile, (char**)&catPage, PAGE_BUF);
-    if (e < 0) ERR(e);
-    
-    GET_PTR_TO_CATENTRY_FOR_BTREE(catObjForFile, catPage, catEntry);
-    
-    MAKE_PHYSICALFILEID(pFid, catEntry->fid.volNo, catEntry->firstPage); 
-    
-    e = BfM_FreeTrain((TrainID*)catObjForFile, PAGE_BUF);
+    e = edubtm_GetCatalogEntry(catObjForFile, &catEntry);
     if (e < 0) ERR(e);
+
+    MAKE_PHYSICALFILEID(pFid, catEntry.fid.volNo, catEntry.firstPage);
     
 
     /*@ Initially the flags are FALSE */
@@ -340,7 +334,7 @@ Four edubtm_InsertLeaf(
             leaf.nObjects = entry->nObjects;
             leaf.oid = *oid;
             
-            e = edubtm_SplitLeaf(catObjForFile, pid, page, idx-1, &leaf, item);
+            e = edubtm_SplitLeaf(catObjForFile, pid, page, kdesc, idx-1, &leaf, item);
             if (e < 0) ERR(e);
             
             *h = TRUE;	/* Mark */
@@ -384,7 +378,7 @@ Four edubtm_InsertLeaf(
             memcpy(&(leaf.kval[0]), &(kval->val[0]), leaf.klen);
             leaf.oid = *oid;
             
-            e = edubtm_SplitLeaf(catObjForFile, pid, page, idx, &leaf, item);
+            e = edubtm_SplitLeaf(catObjForFile, pid, page, kdesc, idx, &leaf, item);
             if (e < 0) ERR(e);
             
             *h = TRUE;	/* mark */
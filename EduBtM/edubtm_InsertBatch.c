@@ -0,0 +1,301 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubtm_InsertBatch.c
+ *
+ * Description :
+ *  Insert a batch of keys and ObjectIDs into a B+ tree. The batch is sorted
+ *  in key order, and the keys going to the same subtree are inserted in
+ *  one descent: a page is fixed once, and set dirty once, for all of the
+ *  keys which go into it, instead of once for each key.
+ *
+ * Exports:
+ *  Four edubtm_InsertBatch(ObjectID*, PageID*, btm_InsertBatch*, Four, Boolean*,
+ *                          Boolean*, InternalItem*, Pool*, DeallocListElem*)
+ *  void edubtm_SortBatch(btm_InsertBatch*, Four, Four*)
+ */
+
+
+#include <string.h>
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduBtM_Internal.h"
+
+
+/* internal function prototypes */
+static Four edubtm_BatchCompare(btm_InsertBatch*, Four, Four);
+
+
+
+/*@================================
+ * edubtm_InsertBatch()
+ *================================*/
+/*
+ * Function: Four edubtm_InsertBatch(ObjectID*, PageID*, btm_InsertBatch*, Four, Boolean*,
+ *                                   Boolean*, InternalItem*, Pool*, DeallocListElem*)
+ *
+ * Description:
+ *  Insert into the subtree 'root' the keys of the batch from 'batch->next'
+ *  up to, not including, the position 'end'; all of them belong to the
+ *  subtree. In an internal page, the keys which belong to the same child
+ *  are given to the child at once. In a leaf, the keys are inserted one
+ *  after another while the leaf is fixed.
+ *
+ *  As soon as a page is splitted, the insertion returns to the parent with
+ *  the item of the new page, like edubtm_Insert(); 'batch->next' tells how
+ *  far the batch has been inserted, and the parent goes on with the rest.
+ *  So a page is splitted at most once while it is fixed.
+ *
+ * Returns:
+ *  Error code
+ *    eBADBTREEPAGE_BTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) f : TRUE if the given page is not half full
+ *  2) h : TRUE if the given page is splitted
+ *  3) item : item to be inserted into the parent
+ */
+Four edubtm_InsertBatch(
+    ObjectID                    *catObjForFile,         /* IN catalog object of B+-tree file */
+    PageID                      *root,                  /* IN the root of a subtree */
+    btm_InsertBatch             *batch,                 /* INOUT the batch being inserted */
+    Four                        end,                    /* IN end of the keys belonging to the subtree */
+    Boolean                     *f,                     /* OUT whether it is merged by creating a new overflow page */
+    Boolean                     *h,                     /* OUT whether it is splitted */
+    InternalItem                *item,                  /* OUT Internal Item which will be inserted */
+                                                        /*     into its parent when 'h' is TRUE */
+    Pool                        *dlPool,                /* INOUT pool of dealloc list */
+    DeallocListElem             *dlHead)                /* INOUT head of the dealloc list */
+{
+    Four                        e;                      /* error number */
+    Boolean                     lh;                     /* local 'h' */
+    Boolean                     lf;                     /* local 'f' */
+    Boolean                     dirty;                  /* has the page been updated? */
+    Two                         idx;                    /* index for the given key value */
+    Four                        k;                      /* index of a key in the batch */
+    Four                        childEnd;               /* end of the keys belonging to the child */
+    PageID                      newPid;                 /* PageID of the child */
+    KeyValue                    tKey;                   /* a temporary key */
+    InternalItem                litem;                  /* a local internal item */
+    BtreePage                   *apage;                 /* a pointer to the root page */
+    btm_InternalEntry           *iEntry;                /* an internal entry */
+    sm_CatOverlayForBtree       catEntry;               /* Btree file catalog information */
+    PhysicalFileID              pFid;                   /* B+-tree file's FileID */
+
+
+    /*@ Initially the flags are FALSE */
+    *h = *f = FALSE;
+    dirty = FALSE;
+
+    e = BfM_GetTrain(root, (char **)&apage, PAGE_BUF);
+    if (e < 0) ERR(e);
+
+    if (apage->any.hdr.type & INTERNAL) {	/* Internal */
+
+        while (batch->next < end && !*h && !*f) {
+
+            k = batch->order[batch->next];
+
+            /*@ Get the child page of the next key */
+            (Boolean) edubtm_BinarySearchInternal(&(apage->bi), batch->kdesc, &(batch->kval[k]), &idx);
+
+            if (idx >= 0) {
+                iEntry = (btm_InternalEntry*)&(apage->bi.data[apage->bi.slot[-idx]]);
+                MAKE_PAGEID(newPid, root->volNo, iEntry->spid);
+            } else
+                MAKE_PAGEID(newPid, root->volNo, apage->bi.hdr.p0);
+
+            /*@ The keys less than the key of the next entry belong to the child */
+            childEnd = end;
+            if (idx + 1 < apage->bi.hdr.nSlots) {
+                iEntry = (btm_InternalEntry*)&(apage->bi.data[apage->bi.slot[-(idx+1)]]);
+                tKey.len = iEntry->klen;
+                memcpy(&(tKey.val[0]), &(iEntry->kval[0]), tKey.len);
+
+                for (childEnd = batch->next + 1; childEnd < end; childEnd++)
+                    if (edubtm_KeyCompare(batch->kdesc, &(batch->kval[batch->order[childEnd]]), &tKey) != LESS)
+                        break;
+            }
+
+            /* Recursively call using the child */
+            e = edubtm_InsertBatch(catObjForFile, &newPid, batch, childEnd, &lf, &lh,
+                                   &litem, dlPool, dlHead);
+            if (e < 0) {
+                if (dirty) (Four) BfM_SetDirty(root, PAGE_BUF);
+                ERRB1(e, root, PAGE_BUF);
+            }
+
+            if (lh) {		/* the child was splitted */
+                /*@ find the correct position */
+                tKey.len = litem.klen;
+                memcpy(&(tKey.val[0]), &(litem.kval[0]), tKey.len);
+                (Boolean) edubtm_BinarySearchInternal(&(apage->bi), batch->kdesc, &tKey, &idx);
+
+                /* Insert the returned internal item into the given root page */
+                e = edubtm_InsertInternal(catObjForFile, &(apage->bi), &litem, idx, h, item);
+                if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+                dirty = TRUE;
+
+            } else if (lf) {	/* the child is not half full */
+                e = edubtm_GetCatalogEntry(catObjForFile, &catEntry);
+                if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+                MAKE_PHYSICALFILEID(pFid, catEntry.fid.volNo, catEntry.firstPage);
+
+                e = btm_Underflow(&pFid, apage, &newPid, idx, f, &lh, &litem,
+                                  dlPool, dlHead);
+                if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+                if (lh) {
+                    /*@ find the correct position */
+                    tKey.len = litem.klen;
+                    memcpy(&(tKey.val[0]), &(litem.kval[0]), tKey.len);
+                    (Boolean) edubtm_BinarySearchInternal(&(apage->bi), batch->kdesc, &tKey, &idx);
+
+                    e = edubtm_InsertInternal(catObjForFile, &(apage->bi),
+                                              &litem, idx, h, item);
+                    if (e < 0) ERRB1(e, root, PAGE_BUF);
+                }
+
+                dirty = TRUE;
+            }
+        }
+
+    } else if (apage->any.hdr.type & LEAF) {
+
+        while (batch->next < end && !*h && !*f) {
+
+            k = batch->order[batch->next];
+
+            e = edubtm_InsertLeaf(catObjForFile, root, &(apage->bl), batch->kdesc,
+                                  &(batch->kval[k]), &(batch->oid[k]), f, h, item);
+            if (e < 0) {
+                if (dirty) (Four) BfM_SetDirty(root, PAGE_BUF);
+                ERRB1(e, root, PAGE_BUF);
+            }
+
+            batch->next++;
+            dirty = TRUE;
+        }
+
+    } else
+        ERRB1(eBADBTREEPAGE_BTM, root, PAGE_BUF);
+
+    if (dirty) {
+        e = BfM_SetDirty(root, PAGE_BUF);
+        if (e < 0) ERRB1(e, root, PAGE_BUF);
+    }
+
+    e = BfM_FreeTrain(root, PAGE_BUF);
+    if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+}   /* edubtm_InsertBatch() */
+
+
+
+/*@================================
+ * edubtm_SortBatch()
+ *================================*/
+/*
+ * Function: void edubtm_SortBatch(btm_InsertBatch*, Four, Four*)
+ *
+ * Description:
+ *  Fill 'batch->order' with the indexes of the 'nKeys' keys of the batch
+ *  in key order; the ObjectIDs of equal keys are in ascending order. A
+ *  bottom-up merge sort is used, with 'temp' of 'nKeys' elements as the
+ *  work area.
+ *
+ * Returns:
+ *  None
+ */
+void edubtm_SortBatch(
+    btm_InsertBatch             *batch,                 /* INOUT the batch to be sorted */
+    Four                        nKeys,                  /* IN # of keys in the batch */
+    Four                        *temp)                  /* IN work area of 'nKeys' elements */
+{
+    Four                        width;                  /* length of the sorted runs */
+    Four                        lo, mid, hi;            /* two runs, [lo, mid) and [mid, hi) */
+    Four                        i, j, k;
+    Four                        *from = batch->order;   /* runs to be merged */
+    Four                        *to = temp;             /* merged runs */
+    Four                        *swap;
+
+
+    for (i = 0; i < nKeys; i++) batch->order[i] = i;
+
+    for (width = 1; width < nKeys; width *= 2) {
+        for (lo = 0; lo < nKeys; lo += 2*width) {
+            mid = MIN(lo + width, nKeys);
+            hi = MIN(lo + 2*width, nKeys);
+
+            for (i = lo, j = mid, k = lo; k < hi; k++) {
+                if (i < mid && (j >= hi || edubtm_BatchCompare(batch, from[i], from[j]) != GREAT))
+                    to[k] = from[i++];
+                else
+                    to[k] = from[j++];
+            }
+        }
+
+        swap = from; from = to; to = swap;
+    }
+
+    if (from != batch->order)
+        memcpy((char*)batch->order, (char*)from, sizeof(Four) * nKeys);
+
+}   /* edubtm_SortBatch() */
+
+
+
+/*@================================
+ * edubtm_BatchCompare()
+ *================================*/
+/*
+ * Function: static Four edubtm_BatchCompare(btm_InsertBatch*, Four, Four)
+ *
+ * Description:
+ *  Compare the 'a'-th and the 'b'-th elements of the batch by the key,
+ *  and by the ObjectID if the keys are equal.
+ *
+ * Returns:
+ *  EQUAL, GREAT or LESS
+ */
+static Four edubtm_BatchCompare(
+    btm_InsertBatch             *batch,                 /* IN the batch */
+    Four                        a,                      /* IN index of an element */
+    Four                        b)                      /* IN index of an element */
+{
+    Four                        cmp;                    /* result of comparison */
+
+
+    cmp = edubtm_KeyCompare(batch->kdesc, &(batch->kval[a]), &(batch->kval[b]));
+    if (cmp != EQUAL) return(cmp);
+
+    return(btm_ObjectIdComp(&(batch->oid[a]), &(batch->oid[b])));
+
+}   /* edubtm_BatchCompare() */
@@ -33,7 +33,7 @@
  *
  * Exports:
  *  Four edubtm_SplitInternal(ObjectID*, BtreeInternal*, Two, InternalItem*, InternalItem*)
- *  Four edubtm_SplitLeaf(ObjectID*, PageID*, BtreeLeaf*, Two, LeafItem*, InternalItem*)
+ *  Four edubtm_SplitLeaf(ObjectID*, PageID*, BtreeLeaf*, KeyDesc*, Two, LeafItem*, InternalItem*)
  */
 
 
@@ -43,6 +43,22 @@
 #include "EduBtM_Internal.h"
 
 
+/* internal function prototypes */
+static Two edubtm_SplitInternalPoint(BtreeInternal*, Two, InternalItem*);
+static Two edubtm_SplitLeafPoint(KeyDesc*, BtreeLeaf*, Two, btm_LeafEntry*);
+
+
+/* length of an internal entry and of a leaf entry */
+#define INTERNAL_ENTRY_LEN(e) (sizeof(ShortPageID) + ALIGNED_LENGTH(sizeof(Two)+(e)->klen))
+#define LEAF_ENTRY_LEN(e) (BTM_LEAFENTRY_FIXED + ALIGNED_LENGTH((e)->klen) + \
+                           (((e)->nObjects > 0) ? OBJECTID_SIZE * (e)->nObjects : sizeof(ShortPageID)))
+
+/* the entry at the position 'j' when 'item' is inserted after the slot 'high' */
+#define SPLIT_ENTRY(fpage, high, item, j) \
+    (((j) == (high)+1) ? (char*)(item) : \
+     &((fpage)->data[(fpage)->slot[-((j) > (high)+1 ? (j)-1 : (j))]]))
+
+
 
 /*@================================
  * edubtm_SplitInternal()
@@ -63,6 +79,9 @@
  *  A temporary page is used because it is difficult to use the given page
  *  directly and the temporary page will be copied to the given page later.
  *
+ *  The item given to the parent is chosen by edubtm_SplitInternalPoint()
+ *  near the half, so that it has a short key.
+ *
  * Returns:
  *  error code
  *    some errors caused by function calls
@@ -82,7 +101,7 @@ Four edubtm_SplitInternal(
     Two                         j;                      /* slot No. in the splitted pages */
     Two                         k;                      /* slot No. in the new page */
     Two                         maxLoop;                /* # of max loops; # of slots in fpage + 1 */
-    Four                        sum;                    /* the size of a filled area */
+    Two                         nLeft;                  /* # of entries remained in fpage */
     Boolean                     flag=FALSE;             /* TRUE if 'item' become a member of fpage */
     PageID                      newPid;                 /* for a New Allocated Page */
     BtreeInternal               *npage;                 /* a page pointer for the new allocated page */
@@ -108,25 +127,19 @@ Four edubtm_SplitInternal(
     e = BfM_GetNewTrain( &newPid, (char **)&npage, PAGE_BUF );
     if (e < 0) ERR(e);
 
-    /* loop until 'sum' becomes greater than BI_HALF */
+    /* loop until 'nLeft' entries are passed */
     /* j : loop counter, maximum loop count = # of old Slots and a new slot */
     /* i : slot No. variable of fpage */
     maxLoop = fpage->hdr.nSlots+1;
+    nLeft = edubtm_SplitInternalPoint(fpage, high, item);
     i = 0; 
-    sum = 0;
     flag = FALSE;
 
-    for (j = 0; j < maxLoop && sum < BI_HALF; j++) {
-        if (j == high+1) {	/* use the given 'item' */
-            entryLen = sizeof(ShortPageID) + ALIGNED_LENGTH(sizeof(Two)+item->klen);
+    for (j = 0; j < nLeft; j++) {
+        if (j == high+1)	/* use the given 'item' */
             flag = TRUE;
-        } else {
-            fEntryOffset = fpage->slot[-i];
-            fEntry = (btm_InternalEntry*)&(fpage->data[fEntryOffset]);
-            entryLen = sizeof(ShortPageID) + ALIGNED_LENGTH(sizeof(Two)+fEntry->klen);           
+        else
             i++;		/* increment the slot no. */
-        }
-        sum += entryLen + sizeof(Two);
     }
 
     /* i-th old entries are to be remained in 'fpage' */
@@ -218,7 +231,7 @@ Four edubtm_SplitInternal(
  * edubtm_SplitLeaf()
  *================================*/
 /*
- * Function: Four edubtm_SplitLeaf(ObjectID*, PageID*, BtreeLeaf*, Two, LeafItem*, InternalItem*)
+ * Function: Four edubtm_SplitLeaf(ObjectID*, PageID*, BtreeLeaf*, KeyDesc*, Two, LeafItem*, InternalItem*)
  *
  * Description: 
  * (Following description is for original ODYSSEUS/COSMOS BtM.
@@ -229,6 +242,10 @@ Four edubtm_SplitInternal(
  *  key value of a new page is used to make an internal item of their parent.
  *  Internal pages do not maintain the linked list, but leaves do it, so links
  *  are properly updated.
+ *  The key of the internal item is made by edubtm_SeparatorKey() from the
+ *  last key of 'fpage' and the first key of the new page, so it may be a
+ *  prefix of the latter; the split point is chosen by edubtm_SplitLeafPoint()
+ *  near the half, so that the key is short.
  *
  * Returns:
  *  Error code
@@ -242,6 +259,7 @@ Four edubtm_SplitLeaf(
     ObjectID                    *catObjForFile, /* IN catalog object of B+ tree file */
     PageID                      *root,          /* IN PageID for the given page, 'fpage' */
     BtreeLeaf                   *fpage,         /* INOUT the page which will be splitted */
+    KeyDesc                     *kdesc,         /* IN Btree key descriptor */
     Two                         high,           /* IN slotNo for the given 'item' */
     LeafItem                    *item,          /* IN the item which will be inserted */
     InternalItem                *ritem)         /* OUT the item which will be returned by spliting */
@@ -251,7 +269,7 @@ Four edubtm_SplitLeaf(
     Two                         j;              /* slot No. in the splitted pages */
     Two                         k;              /* slot No. in the new page */
     Two                         maxLoop;        /* # of max loops; # of slots in fpage + 1 */
-    Four                        sum;            /* the size of a filled area */
+    Two                         nLeft;          /* # of entries remained in fpage */
     PageID                      newPid;         /* for a New Allocated Page */
     PageID                      nextPid;        /* for maintaining doubly linked list */
     BtreeLeaf                   tpage;          /* a temporary page for the given page */
@@ -336,23 +354,18 @@ Four edubtm_SplitLeaf(
     e = BfM_GetNewTrain(&newPid, (char **)&npage, PAGE_BUF);
     if (e < 0) ERR(e);
 
-    /* loop until 'sum' becomes greater than BL_HALF */
+    /* loop until 'nLeft' entries are passed */
     /* j : loop counter, maximum loop count = # of old Slots and a new slot */
     /* i : slot No variable of fpage */
     maxLoop = fpage->hdr.nSlots + 1;
+    nLeft = edubtm_SplitLeafPoint(kdesc, fpage, high, itemEntry);
     flag = FALSE;		/* itemEntry is to be placed on new page. */
-    for (sum = 0, i = 0, j = 0; j < maxLoop && sum < BL_HALF; j++) {
+    for (i = 0, j = 0; j < nLeft; j++) {
 
-        if (j == high + 1) {	/* use itemEntry */	    
-            sum += itemEntryLen;
+        if (j == high + 1)	/* use itemEntry */	    
             flag = TRUE;	/* itemEntry is to be placed on fpage. */
-        } else {	    
-            fEntryOffset = fpage->slot[-i];
-            fEntry = (btm_LeafEntry*)&(fpage->data[fEntryOffset]);
-            sum += BTM_LEAFENTRY_FIXED + ALIGNED_LENGTH(fEntry->klen) + ((fEntry->nObjects > 0) ? OBJECTID_SIZE * fEntry->nObjects : sizeof(ShortPageID));
+        else	    
             i++;		/* increment the slot No. */
-        }		
-        sum += sizeof(Two);	/* slot space */
     }
 
     /* i-th old entries will be remained in 'fpage' */
@@ -414,12 +427,14 @@ Four edubtm_SplitLeaf(
     }
 
     /* Construct 'ritem' which will be inserted into its parent */
-    /* The key of ritem is that of the 0-th slot of npage. */
+    /* The key of ritem separates the last slot of fpage from the 0-th slot of npage. */
+    /* 'klen' and 'kval' of the entries and the item are cast to KeyValue. */
+    fEntryOffset = fpage->slot[-(fpage->hdr.nSlots - 1)];
+    fEntry = (btm_LeafEntry*)&(fpage->data[fEntryOffset]);
     nEntryOffset = npage->slot[0];
     nEntry = (btm_LeafEntry*)&(npage->data[nEntryOffset]);	
     ritem->spid = newPid.pageNo;
-    ritem->klen = nEntry->klen;
-    memcpy(&(ritem->kval[0]), &(nEntry->kval[0]), ritem->klen);
+    edubtm_SeparatorKey(kdesc, (KeyValue*)&(fEntry->klen), (KeyValue*)&(nEntry->klen), (KeyValue*)&(ritem->klen));
 
     /* If the given page was a root, it is not a root any more. */
     if (fpage->hdr.type & ROOT) fpage->hdr.type = LEAF;
@@ -454,3 +469,152 @@ Four edubtm_SplitLeaf(
     
     
 } /* edubtm_SplitLeaf() */
+
+
+
+/*@================================
+ * edubtm_SplitInternalPoint()
+ *================================*/
+/*
+ * Function: static Two edubtm_SplitInternalPoint(BtreeInternal*, Two, InternalItem*)
+ *
+ * Description:
+ *  Choose where to split the entries of 'fpage' with 'item' inserted after
+ *  the slot 'high'. By default the entries are divided at the half. Any
+ *  entry within BI_SPLITINTERVAL bytes from the half may be the one given to
+ *  the parent instead, so the entry with the shortest key there is taken;
+ *  a shorter key leaves more room in the parent.
+ *
+ * Returns:
+ *  # of entries remained in 'fpage'; the next entry goes to the parent
+ */
+static Two edubtm_SplitInternalPoint(
+    BtreeInternal               *fpage,         /* IN the page which will be splitted */
+    Two                         high,           /* IN slot No. for the given 'item' */
+    InternalItem                *item)          /* IN the item which will be inserted */
+{
+    Two                         j;              /* position among the entries */
+    Two                         maxLoop;        /* # of entries; # of slots in fpage + 1 */
+    Four                        sum;            /* the size of the entries before 'j' */
+    Four                        total;          /* the size of all the entries */
+    Four                        entryLen;       /* the size of the entry at 'j' */
+    Two                         best;           /* the chosen split point */
+    Two                         bestKlen;       /* key length of the entry at 'best' */
+    btm_InternalEntry           *entry;         /* the entry at 'j' */
+
+
+    maxLoop = fpage->hdr.nSlots + 1;
+
+    for (total = 0, j = 0; j < maxLoop; j++) {
+        entry = (btm_InternalEntry*)SPLIT_ENTRY(fpage, high, item, j);
+        total += INTERNAL_ENTRY_LEN(entry) + sizeof(Two);
+    }
+
+    /* the default split point where 'sum' becomes greater than BI_HALF */
+    for (sum = 0, j = 0; j < maxLoop && sum < BI_HALF; j++) {
+        entry = (btm_InternalEntry*)SPLIT_ENTRY(fpage, high, item, j);
+        sum += INTERNAL_ENTRY_LEN(entry) + sizeof(Two);
+    }
+
+    best = j;
+    if (best >= maxLoop) return(best);
+    bestKlen = ((btm_InternalEntry*)SPLIT_ENTRY(fpage, high, item, best))->klen;
+
+    /* look for a shorter key within the interval; both pages should not be empty */
+    for (sum = 0, j = 0; j < maxLoop - 1; j++) {
+        entry = (btm_InternalEntry*)SPLIT_ENTRY(fpage, high, item, j);
+        entryLen = INTERNAL_ENTRY_LEN(entry) + sizeof(Two);
+
+        if (j > 0 && sum >= BI_HALF - BI_SPLITINTERVAL && entry->klen < bestKlen &&
+            total - sum - entryLen <= PAGESIZE - BI_FIXED) {
+            best = j;
+            bestKlen = entry->klen;
+        }
+
+        sum += entryLen;
+        if (sum > BI_HALF + BI_SPLITINTERVAL) break;
+    }
+
+    return(best);
+
+} /* edubtm_SplitInternalPoint() */
+
+
+
+/*@================================
+ * edubtm_SplitLeafPoint()
+ *================================*/
+/*
+ * Function: static Two edubtm_SplitLeafPoint(KeyDesc*, BtreeLeaf*, Two, btm_LeafEntry*)
+ *
+ * Description:
+ *  Choose where to split the entries of 'fpage' with 'itemEntry' inserted
+ *  after the slot 'high'. By default the entries are divided at the half.
+ *  The split point may move within BL_SPLITINTERVAL bytes from the half if
+ *  the key separating the two pages, made by edubtm_SeparatorKey(), gets
+ *  shorter there.
+ *
+ * Returns:
+ *  # of entries remained in 'fpage'
+ */
+static Two edubtm_SplitLeafPoint(
+    KeyDesc                     *kdesc,         /* IN Btree key descriptor */
+    BtreeLeaf                   *fpage,         /* IN the page which will be splitted */
+    Two                         high,           /* IN slotNo for the given 'itemEntry' */
+    btm_LeafEntry               *itemEntry)     /* IN the entry which will be inserted */
+{
+    Two                         j;              /* position among the entries */
+    Two                         maxLoop;        /* # of entries; # of slots in fpage + 1 */
+    Four                        sum;            /* the size of the entries before 'j' */
+    Four                        total;          /* the size of all the entries */
+    Two                         best;           /* the chosen split point */
+    Two                         bestLen;        /* length of the separator at 'best' */
+    btm_LeafEntry               *lEntry;        /* the last entry before the split point */
+    btm_LeafEntry               *rEntry;        /* the first entry after the split point */
+    KeyValue                    sep;            /* separator key */
+
+
+    maxLoop = fpage->hdr.nSlots + 1;
+
+    for (total = 0, j = 0; j < maxLoop; j++) {
+        rEntry = (btm_LeafEntry*)SPLIT_ENTRY(fpage, high, itemEntry, j);
+        total += LEAF_ENTRY_LEN(rEntry) + sizeof(Two);
+    }
+
+    /* the default split point where 'sum' becomes greater than BL_HALF */
+    for (sum = 0, j = 0; j < maxLoop && sum < BL_HALF; j++) {
+        rEntry = (btm_LeafEntry*)SPLIT_ENTRY(fpage, high, itemEntry, j);
+        sum += LEAF_ENTRY_LEN(rEntry) + sizeof(Two);
+    }
+
+    best = j;
+    if (best <= 0 || best >= maxLoop) return(best);
+
+    lEntry = (btm_LeafEntry*)SPLIT_ENTRY(fpage, high, itemEntry, best - 1);
+    rEntry = (btm_LeafEntry*)SPLIT_ENTRY(fpage, high, itemEntry, best);
+    edubtm_SeparatorKey(kdesc, (KeyValue*)&(lEntry->klen), (KeyValue*)&(rEntry->klen), &sep);
+    bestLen = sep.len;
+
+    /* look for a shorter separator within the interval */
+    lEntry = (btm_LeafEntry*)SPLIT_ENTRY(fpage, high, itemEntry, 0);
+    for (sum = LEAF_ENTRY_LEN(lEntry) + sizeof(Two), j = 1; j < maxLoop; j++) {
+        if (sum > BL_HALF + BL_SPLITINTERVAL) break;
+
+        rEntry = (btm_LeafEntry*)SPLIT_ENTRY(fpage, high, itemEntry, j);
+
+        if (sum >= BL_HALF - BL_SPLITINTERVAL && sum <= PAGESIZE - BL_FIXED &&
+            total - sum <= PAGESIZE - BL_FIXED) {
+            edubtm_SeparatorKey(kdesc, (KeyValue*)&(lEntry->klen), (KeyValue*)&(rEntry->klen), &sep);
+            if (sep.len < bestLen) {
+                best = j;
+                bestLen = sep.len;
+            }
+        }
+
+        sum += LEAF_ENTRY_LEN(rEntry) + sizeof(Two);
+        lEntry = rEntry;
+    }
+
+    return(best);
+
+} /* edubtm_SplitLeafPoint() */
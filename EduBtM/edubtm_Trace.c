@@ -0,0 +1,304 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubtm_Trace.c
+ *
+ * Description :
+ *  Record the buffer manager trace of the B+ tree manager, in the format
+ *  of EduBfM_StartTrace(), to be replayed by EduBfM_TraceSim. EduBtM is
+ *  linked with the buffer manager of the storage system, so the linker
+ *  routes its calls of BfM_GetTrain(), BfM_GetNewTrain(), BfM_FreeTrain()
+ *  and BfM_SetDirty() here (see the --wrap options in the Makefile), and
+ *  they are passed on after being recorded. A trace is recorded only if
+ *  the environment variable BFM_TRACE names the trace file, e.g.
+ *      BFM_TRACE=btm.trace ./EduBtM_Test
+ *
+ * Exports:
+ *  Four __wrap_BfM_GetTrain(TrainID*, char**, Four)
+ *  Four __wrap_BfM_GetNewTrain(TrainID*, char**, Four)
+ *  Four __wrap_BfM_FreeTrain(TrainID*, Four)
+ *  Four __wrap_BfM_SetDirty(TrainID*, Four)
+ */
+
+
+#include <stdlib.h>
+#include <time.h>
+#include "EduBtM_common.h"
+#include "BfM.h"
+
+
+/*@
+ * constant definitions
+ */
+#define TRACEBUFSIZE	4096		/* # of records written to the trace file at once */
+
+/* state of the trace */
+#define TRACE_UNKNOWN	0		/* BFM_TRACE has not been looked at yet */
+#define TRACE_ON	1
+#define TRACE_OFF	2
+
+
+/* the functions of the buffer manager of the storage system */
+Four __real_BfM_GetTrain(TrainID *, char **, Four);
+Four __real_BfM_GetNewTrain(TrainID *, char **, Four);
+Four __real_BfM_FreeTrain(TrainID *, Four);
+Four __real_BfM_SetDirty(TrainID *, Four);
+
+static Four edubtm_traceState = TRACE_UNKNOWN;
+static FILE *edubtm_traceFp;
+static UEight edubtm_traceStart;
+static BfMTraceRecord edubtm_traceRecord[TRACEBUFSIZE];
+static Four edubtm_traceNRecords;
+
+
+
+/*@================================
+ * edubtm_TraceNow()
+ *================================*/
+/*
+ * Function: static UEight edubtm_TraceNow(void)
+ *
+ * Description:
+ *  Return the time in microseconds from an arbitrary point.
+ *
+ * Returns:
+ *  current time in microseconds
+ */
+static UEight edubtm_TraceNow(void)
+{
+    struct timespec	now;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return((UEight)now.tv_sec * 1000000 + now.tv_nsec / 1000);
+
+} /* edubtm_TraceNow() */
+
+
+
+/*@================================
+ * edubtm_TraceFlush()
+ *================================*/
+/*
+ * Function: static void edubtm_TraceFlush(void)
+ *
+ * Description:
+ *  Write the records collected in memory to the trace file; the trace is
+ *  given up if the file cannot be written. Also called at the exit.
+ *
+ * Returns:
+ *  None
+ */
+static void edubtm_TraceFlush(void)
+{
+    if (edubtm_traceState != TRACE_ON) return;
+
+    if (fwrite(edubtm_traceRecord, sizeof(BfMTraceRecord), edubtm_traceNRecords, edubtm_traceFp) != (size_t)edubtm_traceNRecords ||
+        fflush(edubtm_traceFp) != 0)
+    {
+        fprintf(stderr, "Cannot write the buffer manager trace\n");
+        fclose(edubtm_traceFp);
+        edubtm_traceState = TRACE_OFF;
+    }
+
+    edubtm_traceNRecords = 0;
+
+} /* edubtm_TraceFlush() */
+
+
+
+/*@================================
+ * edubtm_TraceRecord()
+ *================================*/
+/*
+ * Function: static void edubtm_TraceRecord(Four, TrainID*, Four)
+ *
+ * Description:
+ *  Record the operation 'op' on the train 'trainId', opening the trace
+ *  file named by BFM_TRACE at the first call.
+ *
+ * Returns:
+ *  None
+ */
+static void edubtm_TraceRecord(
+    Four		op,			/* IN BFM_TRACE_XXX */
+    TrainID		*trainId,		/* IN the train */
+    Four		type)			/* IN buffer type */
+{
+    char		*fileName;
+    BfMTraceHeader	header;
+    BfMTraceRecord	*r;
+
+
+    if (edubtm_traceState == TRACE_UNKNOWN)
+    {
+        edubtm_traceState = TRACE_OFF;
+
+        fileName = getenv("BFM_TRACE");
+        if (fileName == NULL || fileName[0] == '\0') return;
+
+        edubtm_traceFp = fopen(fileName, "wb");
+        if (edubtm_traceFp == NULL) return;
+
+        header.magic = BFM_TRACE_MAGIC;
+        header.recordSize = sizeof(BfMTraceRecord);
+        if (fwrite(&header, sizeof(header), 1, edubtm_traceFp) != 1)
+        {
+            fclose(edubtm_traceFp);
+            return;
+        }
+
+        edubtm_traceState = TRACE_ON;
+        edubtm_traceStart = edubtm_TraceNow();
+        atexit(edubtm_TraceFlush);
+    }
+
+    if (edubtm_traceState != TRACE_ON) return;
+
+    r = &edubtm_traceRecord[edubtm_traceNRecords++];
+    r->time = edubtm_TraceNow() - edubtm_traceStart;
+    r->pageNo = trainId->pageNo;
+    r->volNo = trainId->volNo;
+    r->op = op;
+    r->type = type;
+
+    if (edubtm_traceNRecords == TRACEBUFSIZE) edubtm_TraceFlush();
+
+} /* edubtm_TraceRecord() */
+
+
+
+/*@================================
+ * __wrap_BfM_GetTrain()
+ *================================*/
+/*
+ * Function: Four __wrap_BfM_GetTrain(TrainID*, char**, Four)
+ *
+ * Description:
+ *  BfM_GetTrain() recorded in the trace.
+ *
+ * Returns:
+ *  error code of BfM_GetTrain()
+ */
+Four __wrap_BfM_GetTrain(
+    TrainID		*trainId,		/* IN train to be used */
+    char		**retBuf,		/* OUT pointer to the returned buffer */
+    Four		type)			/* IN buffer type */
+{
+    Four		e;			/* error code */
+
+
+    e = __real_BfM_GetTrain(trainId, retBuf, type);
+    if (e >= 0) edubtm_TraceRecord(BFM_TRACE_GET, trainId, type);
+
+    return(e);
+
+} /* __wrap_BfM_GetTrain() */
+
+
+
+/*@================================
+ * __wrap_BfM_GetNewTrain()
+ *================================*/
+/*
+ * Function: Four __wrap_BfM_GetNewTrain(TrainID*, char**, Four)
+ *
+ * Description:
+ *  BfM_GetNewTrain() recorded in the trace.
+ *
+ * Returns:
+ *  error code of BfM_GetNewTrain()
+ */
+Four __wrap_BfM_GetNewTrain(
+    TrainID		*trainId,		/* IN train to be used */
+    char		**retBuf,		/* OUT pointer to the returned buffer */
+    Four		type)			/* IN buffer type */
+{
+    Four		e;			/* error code */
+
+
+    e = __real_BfM_GetNewTrain(trainId, retBuf, type);
+    if (e >= 0) edubtm_TraceRecord(BFM_TRACE_NEW, trainId, type);
+
+    return(e);
+
+} /* __wrap_BfM_GetNewTrain() */
+
+
+
+/*@================================
+ * __wrap_BfM_FreeTrain()
+ *================================*/
+/*
+ * Function: Four __wrap_BfM_FreeTrain(TrainID*, Four)
+ *
+ * Description:
+ *  BfM_FreeTrain() recorded in the trace.
+ *
+ * Returns:
+ *  error code of BfM_FreeTrain()
+ */
+Four __wrap_BfM_FreeTrain(
+    TrainID		*trainId,		/* IN train to be freed */
+    Four		type)			/* IN buffer type */
+{
+    Four		e;			/* error code */
+
+
+    e = __real_BfM_FreeTrain(trainId, type);
+    if (e >= 0) edubtm_TraceRecord(BFM_TRACE_FREE, trainId, type);
+
+    return(e);
+
+} /* __wrap_BfM_FreeTrain() */
+
+
+
+/*@================================
+ * __wrap_BfM_SetDirty()
+ *================================*/
+/*
+ * Function: Four __wrap_BfM_SetDirty(TrainID*, Four)
+ *
+ * Description:
+ *  BfM_SetDirty() recorded in the trace.
+ *
+ * Returns:
+ *  error code of BfM_SetDirty()
+ */
+Four __wrap_BfM_SetDirty(
+    TrainID		*trainId,		/* IN train to be set dirty */
+    Four		type)			/* IN buffer type */
+{
+    Four		e;			/* error code */
+
+
+    e = __real_BfM_SetDirty(trainId, type);
+    if (e >= 0) edubtm_TraceRecord(BFM_TRACE_SETDIRTY, trainId, type);
+
+    return(e);
+
+} /* __wrap_BfM_SetDirty() */